@@ -0,0 +1,56 @@
+#pragma once
+
+#include "pch.h"
+#include "WorkerPool.h"
+
+#include <coroutine>
+
+namespace SWF {
+
+    // Eagerly-started coroutine with no result. The frame destroys itself
+    // when the body finishes; nothing can co_await it.
+    struct FireAndForget {
+        struct promise_type {
+            FireAndForget get_return_object() noexcept { return {}; }
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_never final_suspend() noexcept { return {}; }
+            void return_void() noexcept {}
+            void unhandled_exception() noexcept {
+                try {
+                    throw;
+                } catch (const std::exception& e) {
+                    logs::critical("Async: coroutine terminated by exception: {}", e.what());
+                } catch (...) {
+                    logs::critical("Async: coroutine terminated by unknown exception");
+                }
+            }
+        };
+    };
+
+    // co_await ResumeOnWorker{} continues the coroutine on the shared worker
+    // pool. If the pool refuses the job it simply keeps running inline.
+    struct ResumeOnWorker {
+        TaskPriority priority = TaskPriority::kHigh;
+        const char*  name     = "coroutine";
+
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle) const {
+            return WorkerPool::GetSingleton().Submit(priority, name, [handle]() { handle.resume(); });
+        }
+        void await_resume() const noexcept {}
+    };
+
+    // co_await ResumeOnGameThread{} continues the coroutine from the SKSE
+    // task queue, i.e. on the game's main thread between frames. Required
+    // before touching live game records.
+    struct ResumeOnGameThread {
+        bool await_ready() const noexcept { return false; }
+        bool await_suspend(std::coroutine_handle<> handle) const {
+            auto* tasks = SKSE::GetTaskInterface();
+            if (!tasks) return false;
+            tasks->AddTask([handle]() { handle.resume(); });
+            return true;
+        }
+        void await_resume() const noexcept {}
+    };
+}
@@ -0,0 +1,224 @@
+#include "ChanceTable.h"
+#include "Config.h"
+#include "EntryOverrides.h"
+#include "MonthCurves.h"
+#include "PerfStats.h"
+#include "RegionOverrides.h"
+#include "RegionScanner.h"
+#include "WeatherOverrides.h"
+
+namespace SWF {
+
+    namespace {
+        // For injected weathers (baseChance == 0), use a small base value
+        // so season multipliers can give them a non-zero chance.
+        // This allows e.g. snow to appear in regions that don't normally have it.
+        constexpr float kInjectedBaseChance = 10.0f;
+
+        float GetClassMultiplier(const SeasonWeatherMultipliers& mults, WeatherClass wc) {
+            // kUnknown weathers (quest / scripted weathers with no
+            // pleasant/cloudy/rainy/snow flag) are zeroed out so they
+            // don't compete with seasonal weathers in the region table.
+            switch (wc) {
+                case WeatherClass::kPleasant: return mults.pleasantMult;
+                case WeatherClass::kCloudy:   return mults.cloudyMult;
+                case WeatherClass::kRainy:    return mults.rainyMult;
+                case WeatherClass::kSnow:     return mults.snowMult;
+                default:                      return 0.0f;
+            }
+        }
+
+        // `entryIndex` is the entry's position in the table's weight arrays.
+        float ComputeWeight(const RegionWeatherEntry& orig, std::size_t entryIndex,
+                            const SeasonWeatherMultipliers& mults, const MultiplierOverride* worldspaceMults,
+                            const MultiplierOverride* regionMults, const ChanceOverrides& overrides, Season season) {
+            const EntryOverride* entry = overrides.entries ? overrides.entries->Find(season, entryIndex) : nullptr;
+            if (entry && entry->chance >= 0.0f) return entry->chance;
+
+            float base = (orig.baseChance > 0)
+                ? static_cast<float>(orig.baseChance)
+                : kInjectedBaseChance;
+            if (entry) return base * entry->multiplier;
+
+            float mult = GetClassMultiplier(mults, orig.classification);
+            if (worldspaceMults) mult = worldspaceMults->Get(season, orig.classification, mult);
+            if (regionMults) mult = regionMults->Get(season, orig.classification, mult);
+            if (overrides.weathers) {
+                // Dense index lookup; the FormID was resolved when the rules were compiled.
+                if (const auto* rule = overrides.weathers->ForWeather(orig.weatherIndex)) {
+                    mult = rule->Get(season, mult);
+                }
+            }
+            return base * mult;
+        }
+    }
+
+    const ChanceTable::RegionSlot* ChanceTable::FindSlot(const RE::TESRegion* region) const {
+        auto& scanner = RegionScanner::GetSingleton();
+        if (!region || scanner.GetGeneration() != scanGeneration) return nullptr;
+
+        auto index = scanner.GetRegionIndex(region->GetFormID());
+        return index < regions.size() ? &regions[index] : nullptr;
+    }
+
+    std::size_t ChanceTable::FindPartition(std::string_view worldspace) const {
+        for (std::size_t p = 1; p < partitions.size(); ++p) {
+            if (partitions[p].worldspace == worldspace) return p;
+        }
+        return 0;
+    }
+
+    void ChanceTable::BuildPartitions(ChanceTable& table, const std::vector<RegionWeatherInfo>& regionInfos,
+                                      const Config& config) {
+        table.partitions.assign(1, {});
+
+        // Last rule per worldspace wins.
+        std::unordered_map<std::string_view, std::int32_t> ruleFor;
+        for (std::size_t i = 0; i < config.worldspaceSeasons.size(); ++i) {
+            ruleFor[config.worldspaceSeasons[i].worldspace] = static_cast<std::int32_t>(i);
+        }
+
+        std::unordered_map<std::int32_t, std::uint16_t> partitionFor;
+        for (std::size_t r = 0; r < table.regions.size() && r < regionInfos.size(); ++r) {
+            std::uint16_t p = 0;
+            auto it = ruleFor.empty() ? ruleFor.end() : ruleFor.find(regionInfos[r].worldSpaceEditorID);
+            if (it != ruleFor.end()) {
+                auto [slot, added] = partitionFor.try_emplace(it->second,
+                    static_cast<std::uint16_t>(table.partitions.size()));
+                if (added) {
+                    const auto& rule = config.worldspaceSeasons[it->second];
+                    table.partitions.push_back({ rule.worldspace, rule.offsetDays, it->second, {} });
+                }
+                p = slot->second;
+            }
+            table.regions[r].partition = p;
+            if (table.regions[r].managed) {
+                table.partitions[p].regions.push_back(static_cast<std::uint32_t>(r));
+            }
+        }
+    }
+
+    std::size_t ChanceTable::GetMemoryBytes() const {
+        auto bytes = regions.capacity() * sizeof(RegionSlot) + partitions.capacity() * sizeof(Partition);
+        for (const auto& partition : partitions) {
+            bytes += partition.worldspace.capacity() + partition.regions.capacity() * sizeof(std::uint32_t);
+        }
+        for (const auto& slot : weights) bytes += slot.capacity() * sizeof(float);
+        for (const auto& slot : monthWeights) bytes += slot.capacity() * sizeof(float);
+        return bytes;
+    }
+
+    std::shared_ptr<const ChanceTable> ChanceTable::Build(
+        const std::vector<RegionWeatherInfo>& regionInfos,
+        const Config& config,
+        const ChanceOverrides& overrides,
+        std::uint64_t configVersion,
+        std::uint64_t scanGeneration)
+    {
+        PerfScope perf(PerfTimer::kTableBuild);
+        auto table = std::make_shared<ChanceTable>();
+        table->configVersion  = configVersion;
+        table->scanGeneration = scanGeneration;
+        table->entryImport    = overrides.entries ? overrides.entries->importId : 0;
+        table->regions.reserve(regionInfos.size());
+
+        std::uint32_t totalEntries = 0;
+        for (const auto& info : regionInfos) {
+            ChanceTable::RegionSlot slot;
+            slot.firstEntry = totalEntries;
+            slot.entryCount = static_cast<std::uint32_t>(info.originalWeatherEntries.size());
+            // Regions with no associated worldspace are never managed — we
+            // can't determine where they apply, so it's safer to leave them alone.
+            slot.managed    = info.worldSpace && info.weatherData &&
+                              !info.worldSpaceEditorID.empty() &&
+                              config.IsWorldspaceEnabled(info.worldSpaceEditorID);
+            table->regions.push_back(slot);
+            totalEntries += slot.entryCount;
+        }
+        BuildPartitions(*table, regionInfos, config);
+
+        auto worldspaceMultsFor = [&](const RegionSlot& slot) -> const MultiplierOverride* {
+            auto rule = table->partitions[slot.partition].rule;
+            return rule >= 0 ? &config.worldspaceSeasons[rule].multipliers : nullptr;
+        };
+
+        auto fill = [&](std::vector<float>& weights, const SeasonWeatherMultipliers& mults, Season season) {
+            weights.assign(totalEntries, 0.0f);
+            for (std::size_t r = 0; r < regionInfos.size(); ++r) {
+                const auto& slot = table->regions[r];
+                if (!slot.managed) continue;
+
+                const auto* worldspaceMults = worldspaceMultsFor(slot);
+                const auto* regionMults = overrides.regions ? overrides.regions->ForRegion(r) : nullptr;
+                const auto& entries = regionInfos[r].originalWeatherEntries;
+                for (std::uint32_t i = 0; i < slot.entryCount; ++i) {
+                    weights[slot.firstEntry + i] = ComputeWeight(entries[i], slot.firstEntry + i, mults,
+                                                                  worldspaceMults, regionMults, overrides, season);
+                }
+            }
+        };
+
+        for (std::size_t s = 0; s < table->weights.size(); ++s) {
+            auto season = static_cast<Season>(s);
+            fill(table->weights[s], config.GetMultipliers(season), season);
+        }
+
+        // Month slots take the curve-sampled class multipliers; region,
+        // weather and CSV overrides still apply for the month's season.
+        if (config.useMonthCurves) {
+            auto months = BakeMonthMultipliers(config);
+            for (std::uint32_t m = 0; m < kMonthsPerYear; ++m) {
+                fill(table->monthWeights[m], months[m], config.GetSeasonForMonth(m));
+            }
+            table->hasMonthWeights = true;
+        }
+
+        PerfStats::GetSingleton().NoteBuild(PerfMemory::kChanceTable, table->GetMemoryBytes());
+        return table;
+    }
+
+    std::shared_ptr<const ChanceTable> ChanceTable::WithUpdatedClasses(
+        const ChanceTable& base,
+        const std::vector<RegionWeatherInfo>& regionInfos,
+        const Config& config,
+        const ChanceOverrides& overrides,
+        std::uint64_t configVersion,
+        const std::array<std::uint8_t, static_cast<std::size_t>(Season::kTotal)>& seasonClassMasks)
+    {
+        PerfScope perf(PerfTimer::kTableBuild);
+        auto table = std::make_shared<ChanceTable>(base);
+        table->configVersion = configVersion;
+        table->entryImport   = overrides.entries ? overrides.entries->importId : 0;
+
+        for (std::size_t s = 0; s < table->weights.size(); ++s) {
+            auto mask = seasonClassMasks[s];
+            if (mask == 0) continue;
+
+            auto& weights = table->weights[s];
+            auto season = static_cast<Season>(s);
+            const auto& mults = config.GetMultipliers(season);
+
+            for (std::size_t r = 0; r < regionInfos.size() && r < table->regions.size(); ++r) {
+                const auto& slot = table->regions[r];
+                if (!slot.managed) continue;
+
+                // Worldspace rules are unchanged here (a change rebuilds), so
+                // the partition's rule index is still valid.
+                auto rule = slot.partition < table->partitions.size() ? table->partitions[slot.partition].rule : -1;
+                const auto* worldspaceMults = rule >= 0 ? &config.worldspaceSeasons[rule].multipliers : nullptr;
+                const auto* regionMults = overrides.regions ? overrides.regions->ForRegion(r) : nullptr;
+                const auto& entries = regionInfos[r].originalWeatherEntries;
+                for (std::uint32_t i = 0; i < slot.entryCount; ++i) {
+                    const auto& orig = entries[i];
+                    if (mask & (1u << static_cast<std::uint32_t>(orig.classification))) {
+                        weights[slot.firstEntry + i] = ComputeWeight(orig, slot.firstEntry + i, mults,
+                                                                     worldspaceMults, regionMults, overrides, season);
+                    }
+                }
+            }
+        }
+
+        PerfStats::GetSingleton().NoteBuild(PerfMemory::kChanceTable, table->GetMemoryBytes());
+        return table;
+    }
+}
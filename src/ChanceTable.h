@@ -0,0 +1,111 @@
+#pragma once
+
+#include "pch.h"
+#include "Season.h"
+
+#include <array>
+#include <memory>
+
+namespace SWF {
+
+    struct Config;
+    struct RegionWeatherInfo;
+    struct CompiledRegionOverrides;
+    struct CompiledWeatherOverrides;
+    struct CompiledEntryOverrides;
+
+    // Compiled override indices feeding a table build; any may be null.
+    // Precedence per entry: CSV entry value, then weather rule, then
+    // region rule, then the worldspace set, then the global class multiplier.
+    struct ChanceOverrides {
+        const CompiledRegionOverrides*  regions  = nullptr;
+        const CompiledWeatherOverrides* weathers = nullptr;
+        const CompiledEntryOverrides*   entries  = nullptr;
+    };
+
+    // Precomputed per-season weather weights for every scanned region entry.
+    // Built off the game thread whenever the config or the region table
+    // changes; applying a season is then a straight table walk that only
+    // writes entries whose chance actually differs.
+    struct ChanceTable {
+        struct RegionSlot {
+            std::uint32_t firstEntry = 0;   // index into the weight arrays
+            std::uint32_t entryCount = 0;
+            bool          managed    = false;  // worldspace enabled in the config
+            std::uint16_t partition  = 0;      // index into `partitions`
+        };
+
+        // Regions that follow one calendar. Partition 0 follows the game
+        // date (every region without a [WorldspaceSeasons] rule); each rule
+        // that matched a scanned worldspace gets its own, so applying walks
+        // one flat index list per partition. Only managed regions are
+        // listed: apply never touches the others.
+        struct Partition {
+            std::string                worldspace;        // empty for partition 0
+            std::int32_t               offsetDays = 0;
+            std::int32_t               rule       = -1;   // index into Config::worldspaceSeasons
+            std::vector<std::uint32_t> regions;           // indices into `regions`, ascending
+        };
+
+        // Parallel to RegionScanner::GetRegionWeatherInfos().
+        std::vector<RegionSlot> regions;
+        std::vector<Partition>  partitions;
+
+        // Weight per entry, per season, before TESGlobal scaling. Entries of
+        // unmanaged regions are left at zero and never applied.
+        std::array<std::vector<float>, static_cast<std::size_t>(Season::kTotal)> weights;
+
+        // Same layout per month, from the baked month curves. Only filled
+        // when Config::useMonthCurves is on; empty otherwise.
+        std::array<std::vector<float>, kMonthsPerYear> monthWeights;
+        bool                                           hasMonthWeights = false;
+
+        std::uint64_t configVersion  = 0;
+        std::uint64_t scanGeneration = 0;
+        std::uint64_t entryImport    = 0;   // CompiledEntryOverrides::importId built with, 0 = none
+
+        const float* GetSeasonWeights(Season season) const {
+            return weights[static_cast<std::size_t>(season)].data();
+        }
+
+        bool HasMonthWeights() const { return hasMonthWeights; }
+
+        // Heap bytes held by the table, for the Debug tab.
+        std::size_t GetMemoryBytes() const;
+
+        // Slot of `region`, or null if it has no weather data or the table
+        // was built from an older scan. O(1) via the scanner's region index.
+        const RegionSlot* FindSlot(const RE::TESRegion* region) const;
+
+        // Partition of the regions in `worldspace` (0 if it has no rule).
+        std::size_t FindPartition(std::string_view worldspace) const;
+
+        // Groups `table.regions` by worldspace rule and stamps each slot's
+        // partition. Done by Build(); tables loaded from a preset call it
+        // against the live config before they are installed.
+        static void BuildPartitions(ChanceTable& table, const std::vector<RegionWeatherInfo>& regionInfos,
+                                    const Config& config);
+        const float* GetMonthWeights(std::uint32_t month) const {
+            return monthWeights[month % kMonthsPerYear].data();
+        }
+
+        static std::shared_ptr<const ChanceTable> Build(
+            const std::vector<RegionWeatherInfo>& regionInfos,
+            const Config& config,
+            const ChanceOverrides& overrides,
+            std::uint64_t configVersion,
+            std::uint64_t scanGeneration);
+
+        // Copy of `base` with only the entries of the given classes
+        // recomputed (one WeatherClass bit mask per season). Region
+        // membership and worldspace flags are reused from `base`. Month
+        // weights are not patched; month-curve configs rebuild instead.
+        static std::shared_ptr<const ChanceTable> WithUpdatedClasses(
+            const ChanceTable& base,
+            const std::vector<RegionWeatherInfo>& regionInfos,
+            const Config& config,
+            const ChanceOverrides& overrides,
+            std::uint64_t configVersion,
+            const std::array<std::uint8_t, static_cast<std::size_t>(Season::kTotal)>& seasonClassMasks);
+    };
+}
@@ -0,0 +1,246 @@
+#include "CommandQueue.h"
+#include "ChanceTable.h"
+#include "Config.h"
+#include "ConfigHistory.h"
+#include "ConfigSchema.h"
+#include "ConfigWatcher.h"
+#include "PerfStats.h"
+#include "PresetStore.h"
+#include "RegionScanner.h"
+#include "WeatherManager.h"
+#include "WeatherResetPolicy.h"
+
+namespace SWF {
+
+    void CommandQueue::Push(Command command) {
+        queue_.Push(std::move(command));
+        ScheduleDrain();
+    }
+
+    void CommandQueue::ScheduleDrain() {
+        if (drainScheduled_.exchange(true, std::memory_order_acq_rel)) return;
+
+        auto* tasks = SKSE::GetTaskInterface();
+        if (!tasks) {
+            drainScheduled_.store(false, std::memory_order_release);
+            return;
+        }
+        tasks->AddTask([]() { CommandQueue::GetSingleton().Drain(); });
+    }
+
+    void CommandQueue::Drain() {
+        // Clear first: anything pushed from here on schedules a new drain.
+        drainScheduled_.store(false, std::memory_order_release);
+
+        auto& configManager = ConfigManager::GetSingleton();
+        auto& config = configManager.GetConfig();
+        auto& wm = WeatherManager::GetSingleton();
+        auto& history = ConfigHistory::GetSingleton();
+        history.Sync(config, configManager.GetVersion());
+
+        bool configChanged = false;
+        bool needsRefresh  = false;
+        bool needsSave     = false;
+        bool loadRequested = false;
+        ConfigDiff reloadDiff;
+        std::uint32_t executed = 0;
+
+        // What goes into the undo history: a label for the batch's edits,
+        // and a merge key so one slider drag becomes one entry.
+        std::string   editLabel;
+        std::uint32_t edits    = 0;
+        std::uint32_t mergeKey = 0;
+        bool          restored = false;
+
+        // Multiplier slider edits can be previewed without a refresh; any
+        // other config change ends the preview.
+        WeatherManager::SeasonClassMasks multiplierClasses{};
+        bool otherEdits       = false;
+        bool previewRequested = false;
+        bool previewForce     = false;
+        auto noteEdit = [&](std::string label, std::uint32_t key = 0) {
+            mergeKey  = edits == 0 || key == mergeKey ? key : 0;
+            editLabel = edits == 0 || label == editLabel ? std::move(label) : std::string("Multiple edits");
+            ++edits;
+        };
+        auto restore = [&](std::optional<Config> previous) {
+            if (!previous) return;
+            reloadDiff |= DiffConfigs(config, *previous);
+            config = std::move(*previous);
+            restored = true;
+        };
+
+        Command cmd;
+        while (queue_.Pop(cmd)) {
+            ++executed;
+
+            switch (cmd.type) {
+                case CommandType::kReapply:
+                    WeatherResetPolicy::GetSingleton().RequestImmediateReset();
+                    needsRefresh = true;
+                    break;
+                case CommandType::kRefresh:
+                    needsRefresh = true;
+                    break;
+                case CommandType::kSetField:
+                    if (cmd.index < kConfigSchema.size()) {
+                        const auto& field = kConfigSchema[cmd.index];
+                        if (SetConfigField(config, field, cmd.value)) {
+                            configChanged = true;
+                            noteEdit(std::string(field.label), cmd.index + 1);
+                            if (field.effect == FieldEffect::kMultiplier && field.weatherClass < WeatherClass::kUnknown) {
+                                multiplierClasses[static_cast<std::size_t>(field.season)] |=
+                                    static_cast<std::uint8_t>(1u << static_cast<std::uint32_t>(field.weatherClass));
+                            } else {
+                                otherEdits = true;
+                            }
+                            // Sliders queue their own kRefresh when the drag ends.
+                            if (field.effect == FieldEffect::kEnabled) needsRefresh = true;
+                        }
+                    }
+                    break;
+                case CommandType::kAddWorldspace:
+                    if (!cmd.Text().empty() && config.enabledWorldspaces.insert(cmd.Text()).second) {
+                        configChanged = needsRefresh = true;
+                        noteEdit("Add worldspace " + cmd.Text());
+                    }
+                    break;
+                case CommandType::kRemoveWorldspace:
+                    if (config.enabledWorldspaces.erase(cmd.Text()) > 0) {
+                        configChanged = needsRefresh = true;
+                        noteEdit("Remove worldspace " + cmd.Text());
+                    }
+                    break;
+                case CommandType::kSetSeasonOverride:
+                    wm.SetSeasonOverride(static_cast<Season>(cmd.index));
+                    needsRefresh = true;
+                    break;
+                case CommandType::kClearSeasonOverride:
+                    wm.ClearSeasonOverride();
+                    needsRefresh = true;
+                    break;
+                case CommandType::kSaveConfig:
+                    // After a load in this batch, saving would overwrite the
+                    // file before it is read with what is about to be replaced.
+                    if (!loadRequested) needsSave = true;
+                    break;
+                case CommandType::kLoadConfig:
+                    // Read on the worker pool after any save queued so far,
+                    // this batch's included; the result comes back as
+                    // kApplyConfig. The game thread never waits for the disk.
+                    if (needsSave) {
+                        configManager.Save();
+                        needsSave = false;
+                    }
+                    configManager.LoadAsync([](std::shared_ptr<const Config> loaded) {
+                        Command command{ CommandType::kApplyConfig };
+                        command.payload = std::make_unique<CommandPayload>();
+                        command.payload->config = std::move(loaded);
+                        command.payload->text   = "Load settings";
+                        CommandQueue::GetSingleton().Push(std::move(command));
+                    });
+                    loadRequested = true;
+                    break;
+                case CommandType::kResetDefaults:
+                    config = Config{};
+                    configChanged = needsRefresh = true;
+                    noteEdit("Reset to defaults");
+                    break;
+                case CommandType::kApplyPreset:
+                    // Applies and refreshes on its own; later commands in
+                    // this batch see the preset's config.
+                    if (PresetStore::GetSingleton().Apply(cmd.Text())) noteEdit("Preset " + cmd.Text());
+                    break;
+                case CommandType::kSavePreset:
+                    PresetStore::GetSingleton().SaveCurrent(cmd.Text());
+                    break;
+                case CommandType::kRefreshPresets:
+                    PresetStore::GetSingleton().RequestRefresh();
+                    break;
+                case CommandType::kApplyConfig:
+                    // A hot reload applies only what changed on disk since the
+                    // watcher's snapshot, keeping menu edits drained after it;
+                    // an explicit load (no base) replaces the config.
+                    if (cmd.payload && cmd.payload->config) {
+                        ConfigDiff diff;
+                        if (cmd.payload->base) {
+                            auto before = config;
+                            MergeConfigChanges(config, *cmd.payload->base, *cmd.payload->config);
+                            diff = DiffConfigs(before, config);
+                        } else {
+                            diff = DiffConfigs(config, *cmd.payload->config);
+                            config = *cmd.payload->config;
+                        }
+                        reloadDiff |= diff;
+                        if (diff.Any()) noteEdit(cmd.payload->text.empty() ? std::string("Hot reload") : cmd.Text());
+                    }
+                    break;
+                case CommandType::kUndo:
+                    restore(history.Undo());
+                    break;
+                case CommandType::kRedo:
+                    restore(history.Redo());
+                    break;
+                case CommandType::kPreview:
+                    previewRequested = true;
+                    previewForce    |= cmd.value != 0.0f;
+                    break;
+            }
+        }
+
+        if (executed == 0) return;
+
+        auto previousVersion = configManager.GetVersion();
+        if (configChanged || reloadDiff.Any()) {
+            configManager.BumpVersion();
+            ConfigWatcher::GetSingleton().Sync(config.hotReload);
+        }
+
+        // Recorded before the refresh below replaces the live table, so the
+        // previous version keeps it. An undo or redo on its own reinstalls
+        // the table cached with the version it moved to, if the scan still
+        // matches, instead of rebuilding it.
+        if (edits > 0) {
+            history.Record(config, configManager.GetVersion(), std::move(editLabel), mergeKey);
+        } else if (restored) {
+            auto cached = history.OnRestored(configManager.GetVersion());
+            if (cached && cached->scanGeneration == RegionScanner::GetSingleton().GetGeneration()) {
+                auto table = std::make_shared<ChanceTable>(*cached);
+                table->configVersion = configManager.GetVersion();
+                wm.InstallChanceTable(std::move(table));
+            }
+        }
+
+        bool anyMultipliers = std::ranges::any_of(multiplierClasses, [](std::uint8_t m) { return m != 0; });
+        if (otherEdits || needsRefresh || reloadDiff.Any() || (edits > 0 && !anyMultipliers)) {
+            wm.EndPreview();
+        } else {
+            if (anyMultipliers) wm.NoteMultiplierEdits(multiplierClasses, previousVersion);
+            if (previewRequested) wm.RequestPreview(previewForce);
+        }
+
+        // A hot reload on its own only redoes the work its diff calls for;
+        // mixed with menu edits it falls back to the full refresh below.
+        if (reloadDiff.Any() && !configChanged) {
+            wm.ApplyConfigDiff(reloadDiff, previousVersion);
+        } else if (reloadDiff.Any()) {
+            needsRefresh = true;
+        }
+
+        if (needsSave) {
+            configManager.Save();
+        }
+
+        if (needsRefresh) {
+            wm.ForceRefresh();
+            wm.Update();
+        }
+
+        PerfStats::GetSingleton().Count(PerfEvent::kCommand, executed);
+
+        if (config.debugMode) {
+            logs::info("CommandQueue: Drained {} commands (refresh={}, save={})",
+                executed, needsRefresh, needsSave);
+        }
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "pch.h"
+#include "MpscQueue.h"
+#include "Season.h"
+
+#include <memory>
+
+namespace SWF {
+
+    struct Config;
+
+    // Actions requested by the menu. Render callbacks only enqueue these;
+    // the game thread drains and executes them in one batch.
+    enum class CommandType : std::uint8_t {
+        kReapply,              // re-apply season weights to all regions
+        kRefresh,              // config was edited, re-apply on the next drain
+        kSetField,             // index = kConfigSchema index, value = new value (bools 0/1)
+        kAddWorldspace,        // text = worldspace EditorID
+        kRemoveWorldspace,     // text = worldspace EditorID
+        kSetSeasonOverride,    // index = season
+        kClearSeasonOverride,
+        kSaveConfig,
+        kLoadConfig,
+        kResetDefaults,
+        kApplyPreset,          // text = preset name
+        kSavePreset,           // text = preset name
+        kRefreshPresets,       // re-read the preset files
+        kApplyConfig,          // config = re-parsed INI; base = the snapshot it was parsed over (hot reload),
+                               // or null to replace the config (kLoadConfig's result); text = history label
+        kUndo,                 // step back one config version (ConfigHistory)
+        kRedo,
+        kPreview               // slider still moving: preview its multiplier edits; value = 1 to force the weather
+    };
+
+    // Out-of-line data for the few commands that carry more than a number;
+    // everything else is pushed without allocating.
+    struct CommandPayload {
+        std::string                   text;
+        std::shared_ptr<const Config> config;
+        std::shared_ptr<const Config> base;     // kApplyConfig: the snapshot `config` was parsed over
+    };
+
+    struct Command {
+        CommandType   type  = CommandType::kRefresh;
+        std::uint32_t index = 0;
+        std::uint32_t sub   = 0;
+        float         value = 0.0f;
+        std::unique_ptr<CommandPayload> payload = nullptr;
+
+        const std::string& Text() const {
+            static const std::string empty;
+            return payload ? payload->text : empty;
+        }
+    };
+
+    // Multi-producer / single-consumer command queue (MpscQueue). Producers
+    // (menu render callbacks, workers) push without locking unless the ring
+    // is full; the consumer (game thread, via the SKSE task interface)
+    // drains the whole queue at once and coalesces redundant work, so any
+    // number of edits within a frame turn into at most one weather apply.
+    class CommandQueue {
+    public:
+        static CommandQueue& GetSingleton() {
+            static CommandQueue instance;
+            return instance;
+        }
+
+        void Push(Command command);
+
+        // Convenience wrappers used by MenuUI.
+        void Push(CommandType type) { Push(Command{ type }); }
+        void Push(CommandType type, std::uint32_t index, std::uint32_t sub, float value) {
+            Push(Command{ type, index, sub, value });
+        }
+        void Push(CommandType type, std::string text) {
+            Command command{ type };
+            command.payload = std::make_unique<CommandPayload>();
+            command.payload->text = std::move(text);
+            Push(std::move(command));
+        }
+
+        // Execute every queued command. Game thread only.
+        void Drain();
+
+    private:
+        CommandQueue() = default;
+        ~CommandQueue() = default;
+        CommandQueue(const CommandQueue&) = delete;
+        CommandQueue& operator=(const CommandQueue&) = delete;
+
+        static constexpr std::size_t kCapacity = 1024;
+
+        void ScheduleDrain();
+
+        MpscQueue<Command, kCapacity> queue_;
+        std::atomic<bool>             drainScheduled_ = false;
+    };
+}
@@ -1,67 +1,328 @@
 #include "Config.h"
-
+#include "ConfigSchema.h"
+#include "ConfigWatcher.h"
+#include "IniParser.h"
+#include "MonthCurves.h"
+#include "RegionOverrides.h"
+#include "WeatherOverrides.h"
+#include "WorkerPool.h"
+
+#include <cctype>
+#include <chrono>
 #include <filesystem>
-#include <fstream>
-#include <sstream>
 
 namespace SWF {
 
-    // Simple INI-style config parser (no external dependency needed)
-    // Format: key = value (one per line, # for comments, [section] headers)
+    // INI-style config: key = value (one per line, # or ; for comments,
+    // [section] headers). The file is memory-mapped and tokenized in place;
+    // (section, key) pairs dispatch through a compile-time perfect hash.
 
     namespace {
-        std::string Trim(const std::string& str) {
-            auto start = str.find_first_not_of(" \t\r\n");
-            if (start == std::string::npos) return "";
-            auto end = str.find_last_not_of(" \t\r\n");
-            return str.substr(start, end - start + 1);
+        constexpr IniKeyTable<256, std::remove_cvref_t<decltype(kConfigSchema)>> kKeyTable{ kConfigSchema };
+        static_assert(kKeyTable.IsValid(), "no collision-free seed for the config key table");
+
+        constexpr int kWorldspaceListField = FindConfigField("Worldspaces", "sEnabledWorldspaces");
+        static_assert(kWorldspaceListField >= 0);
+
+        // Every numeric default must lie inside its own range.
+        static_assert(std::ranges::all_of(kConfigSchema, [](const FieldDesc& f) {
+            return !f.IsNumeric() || (f.defaultValue >= f.minValue && f.defaultValue <= f.maxValue);
+        }));
+
+        // Sections keyed by user data. Every file appends entries; the main
+        // INI clears the collection first, so it stays the source of truth.
+        constexpr std::array kDynamicSections{
+            DynamicSectionDesc{
+                "RegionOverrides",
+                "Per-region multipliers: pattern = Season.Class=multiplier, ...\n"
+                "Patterns: a glob on the region EditorID (*Pale*), re:<regex> on the region\n"
+                "EditorID, or ws:<glob> on the worldspace EditorID. Season and Class accept *.\n"
+                "Values 0.0-10.0 replace the global multiplier; later rules win.\n"
+                "Example: *Pale* = Winter.Snow=4.0, Fall.Snow=2.0",
+                FieldEffect::kTables,
+                [](Config& config) { config.regionOverrides.clear(); },
+                [](Config& config, std::string_view key, std::string_view value, std::string_view source) {
+                    RegionOverrideRule rule;
+                    if (!ParseRegionOverrideRule(key, value, rule)) return false;
+                    rule.source = source;
+                    config.regionOverrides.push_back(std::move(rule));
+                    return true;
+                },
+                [](const Config& config, std::string& out, bool mainFileOnly) {
+                    for (const auto& rule : config.regionOverrides) {
+                        if (mainFileOnly && !rule.source.empty()) continue;
+                        std::format_to(std::back_inserter(out), "{} = ", rule.pattern);
+                        FormatMultiplierOverride(rule.multipliers, out);
+                        out += '\n';
+                    }
+                },
+                [](const Config& a, const Config& b) { return a.regionOverrides == b.regionOverrides; },
+                [](Config& to, const Config& from) { to.regionOverrides = from.regionOverrides; } },
+            DynamicSectionDesc{
+                "WeatherOverrides",
+                "Per-weather multipliers, independent of the weather's class flags:\n"
+                "Plugin.esp|0xLocalFormID = Season=multiplier, ... (Season accepts *).\n"
+                "Values 0.0-10.0 replace the class multiplier and win over [RegionOverrides].\n"
+                "Example: MyWeathers.esp|0x000D62 = Winter=3.0, Summer=0.0",
+                FieldEffect::kTables,
+                [](Config& config) { config.weatherOverrides.clear(); },
+                [](Config& config, std::string_view key, std::string_view value, std::string_view source) {
+                    WeatherOverrideRule rule;
+                    if (!ParseWeatherOverrideRule(key, value, rule)) return false;
+                    rule.source = source;
+                    config.weatherOverrides.push_back(std::move(rule));
+                    return true;
+                },
+                [](const Config& config, std::string& out, bool mainFileOnly) {
+                    for (const auto& rule : config.weatherOverrides) {
+                        if (!mainFileOnly || rule.source.empty()) FormatWeatherOverrideRule(rule, out);
+                    }
+                },
+                [](const Config& a, const Config& b) { return a.weatherOverrides == b.weatherOverrides; },
+                [](Config& to, const Config& from) { to.weatherOverrides = from.weatherOverrides; } },
+            DynamicSectionDesc{
+                "WorldspaceSeasons",
+                "Per-worldspace calendars: WorldspaceEditorID = offset=<days>, Season.Class=multiplier, ...\n"
+                "offset shifts that worldspace's date (e.g. 30 runs a month ahead into winter).\n"
+                "Multipliers replace the global ones there; [RegionOverrides] still win.\n"
+                "Example: DLC2SolstheimWorld = offset=30, Winter.Snow=3.5, Summer.Pleasant=1.0",
+                FieldEffect::kTables,
+                [](Config& config) { config.worldspaceSeasons.clear(); },
+                [](Config& config, std::string_view key, std::string_view value, std::string_view source) {
+                    WorldspaceSeasonRule rule;
+                    if (!ParseWorldspaceSeasonRule(key, value, rule)) return false;
+                    rule.source = source;
+                    config.worldspaceSeasons.push_back(std::move(rule));
+                    return true;
+                },
+                [](const Config& config, std::string& out, bool mainFileOnly) {
+                    for (const auto& rule : config.worldspaceSeasons) {
+                        if (!mainFileOnly || rule.source.empty()) FormatWorldspaceSeasonRule(rule, out);
+                    }
+                },
+                [](const Config& a, const Config& b) { return a.worldspaceSeasons == b.worldspaceSeasons; },
+                [](Config& to, const Config& from) { to.worldspaceSeasons = from.worldspaceSeasons; } },
+        };
+
+        int FindDynamicSection(std::string_view section) {
+            for (std::size_t i = 0; i < kDynamicSections.size(); ++i) {
+                if (kDynamicSections[i].section == section) return static_cast<int>(i);
+            }
+            return -1;
         }
 
-        float ParseFloat(const std::string& val, float def) {
-            try { return std::stof(val); } catch (...) { return def; }
+        void MarkChanged(ConfigDiff& diff, FieldEffect effect, Season season, WeatherClass weatherClass) {
+            switch (effect) {
+                case FieldEffect::kNone:        diff.other = true; break;
+                case FieldEffect::kEnabled:     diff.enabled = true; break;
+                case FieldEffect::kMonths:      diff.months = true; break;
+                case FieldEffect::kWorldspaces: diff.worldspaces = true; break;
+                case FieldEffect::kTables:      diff.tables = true; break;
+                case FieldEffect::kMultiplier:
+                    diff.multiplierClasses[static_cast<std::size_t>(season)] |=
+                        static_cast<std::uint8_t>(1u << static_cast<std::uint32_t>(weatherClass));
+                    break;
+            }
         }
 
-        int ParseInt(const std::string& val, int def) {
-            try { return std::stoi(val); } catch (...) { return def; }
+        void AddWorldspaces(Config& config, std::string_view value) {
+            ForEachCSVToken(value, [&](std::string_view ws) {
+                config.enabledWorldspaces.emplace(ws);
+            });
         }
 
-        bool ParseBool(const std::string& val, bool def) {
-            auto v = Trim(val);
-            if (v == "true" || v == "1" || v == "yes") return true;
-            if (v == "false" || v == "0" || v == "no") return false;
-            return def;
+        enum class ParseResult { kOk, kInvalid, kClamped };
+
+        // Parses one value into its field. Drop-in files extend the
+        // worldspace list instead of replacing it.
+        ParseResult ParseField(Config& config, const FieldDesc& field, std::string_view value, bool isDropIn) {
+            switch (field.type) {
+                case FieldType::kBool:
+                    return ParseIniBool(value, field.Get<bool>(config)) ? ParseResult::kOk : ParseResult::kInvalid;
+
+                case FieldType::kUInt: {
+                    std::uint32_t parsed = 0;
+                    if (!ParseIniUInt(value, parsed)) return ParseResult::kInvalid;
+                    auto clamped = std::clamp(parsed, static_cast<std::uint32_t>(field.minValue),
+                                              static_cast<std::uint32_t>(field.maxValue));
+                    field.Get<std::uint32_t>(config) = clamped;
+                    return clamped == parsed ? ParseResult::kOk : ParseResult::kClamped;
+                }
+
+                case FieldType::kFloat: {
+                    float parsed = 0.0f;
+                    if (!ParseIniFloat(value, parsed)) return ParseResult::kInvalid;
+                    auto clamped = std::clamp(parsed, field.minValue, field.maxValue);
+                    field.Get<float>(config) = clamped;
+                    return clamped == parsed ? ParseResult::kOk : ParseResult::kClamped;
+                }
+
+                case FieldType::kWorldspaceList:
+                    if (!isDropIn) config.enabledWorldspaces.clear();
+                    AddWorldspaces(config, value);
+                    return ParseResult::kOk;
+
+                case FieldType::kWorldspaceToggle: {
+                    bool enable = true;
+                    if (!ParseIniBool(value, enable)) return ParseResult::kInvalid;
+                    if (enable)
+                        config.enabledWorldspaces.emplace(field.arg);
+                    else
+                        config.enabledWorldspaces.erase(std::string(field.arg));
+                    return ParseResult::kOk;
+                }
+
+                case FieldType::kCurve:
+                    return ParseMonthCurve(value, field.Get<MonthCurve>(config)) ? ParseResult::kOk
+                                                                                 : ParseResult::kInvalid;
+            }
+            return ParseResult::kInvalid;
         }
 
-        void WriteSection(std::ofstream& file, const char* section) {
-            file << "\n[" << section << "]\n";
+        bool FieldEquals(const Config& a, const Config& b, const FieldDesc& field) {
+            switch (field.type) {
+                case FieldType::kBool:             return field.Get<bool>(a) == field.Get<bool>(b);
+                case FieldType::kUInt:             return field.Get<std::uint32_t>(a) == field.Get<std::uint32_t>(b);
+                case FieldType::kFloat:            return field.Get<float>(a) == field.Get<float>(b);
+                case FieldType::kWorldspaceList:   return a.enabledWorldspaces == b.enabledWorldspaces;
+                case FieldType::kWorldspaceToggle: return true;   // covered by the list
+                case FieldType::kCurve:            return field.Get<MonthCurve>(a) == field.Get<MonthCurve>(b);
+            }
+            return true;
         }
 
-        void WriteFloat(std::ofstream& file, const char* key, float val) {
-            file << key << " = " << std::fixed << std::setprecision(2) << val << "\n";
+        void CopyField(Config& to, const Config& from, const FieldDesc& field) {
+            switch (field.type) {
+                case FieldType::kBool:             field.Get<bool>(to) = field.Get<bool>(from); break;
+                case FieldType::kUInt:             field.Get<std::uint32_t>(to) = field.Get<std::uint32_t>(from); break;
+                case FieldType::kFloat:            field.Get<float>(to) = field.Get<float>(from); break;
+                case FieldType::kWorldspaceList:   to.enabledWorldspaces = from.enabledWorldspaces; break;
+                case FieldType::kWorldspaceToggle: break;
+                case FieldType::kCurve:            field.Get<MonthCurve>(to) = field.Get<MonthCurve>(from); break;
+            }
         }
 
-        void WriteInt(std::ofstream& file, const char* key, int val) {
-            file << key << " = " << val << "\n";
+        bool IsKnownSection(std::string_view section) {
+            return std::ranges::any_of(kConfigSchema, [&](const FieldDesc& f) { return f.section == section; }) ||
+                   FindDynamicSection(section) >= 0;
         }
 
-        void WriteBool(std::ofstream& file, const char* key, bool val) {
-            file << key << " = " << (val ? "true" : "false") << "\n";
+        // Assignment field indices at or past this refer to kDynamicSections.
+        constexpr std::size_t kDynamicFieldBase = kConfigSchema.size();
+
+        // One recognised "key = value" line; key and value view the mapped file.
+        struct IniAssignment {
+            std::uint16_t    field   = 0;
+            std::uint32_t    line    = 0;
+            std::string_view value;
+            std::string_view key;   // only read for dynamic sections
+        };
+
+        // A file tokenized and resolved against the key table. Scanning is
+        // independent per file and runs in parallel; applying the
+        // assignments to a Config is a cheap, ordered second step.
+        // Warnings are collected rather than logged so the log order does
+        // not depend on thread scheduling.
+        struct ScannedIniFile {
+            std::string                name;
+            MappedFile                 file;
+            std::vector<IniAssignment> assignments;
+            std::vector<std::string>   warnings;
+        };
+
+        void ScanIniFile(const std::filesystem::path& path, ScannedIniFile& out) {
+            out.name = path.filename().string();
+            out.file = MappedFile(path);
+            if (!out.file.IsOpen()) return;
+
+            TokenizeIni(out.file.GetView(),
+                [&](const IniEntry& entry) {
+                    if (entry.key.empty()) {
+                        out.warnings.push_back(std::format("{}:{}: expected 'key = value', got '{}'",
+                            out.name, entry.line, entry.value));
+                        return;
+                    }
+
+                    auto index = kKeyTable.Find(kConfigSchema, entry.section, entry.key);
+                    if (index < 0) {
+                        if (auto dynamic = FindDynamicSection(entry.section); dynamic >= 0) {
+                            out.assignments.push_back({ static_cast<std::uint16_t>(kDynamicFieldBase + dynamic),
+                                entry.line, entry.value, entry.key });
+                            return;
+                        }
+                        // Keys of unknown sections were already reported with the header.
+                        if (IsKnownSection(entry.section)) {
+                            out.warnings.push_back(std::format("{}:{}: unknown key '{}' in [{}]",
+                                out.name, entry.line, entry.key, entry.section));
+                        }
+                        return;
+                    }
+
+                    out.assignments.push_back({ static_cast<std::uint16_t>(index), entry.line, entry.value, {} });
+                },
+                [&](std::string_view section, std::uint32_t line) {
+                    if (!IsKnownSection(section)) {
+                        out.warnings.push_back(std::format("{}:{}: unknown section [{}], its keys are ignored",
+                            out.name, line, section));
+                    }
+                });
+        }
+
+        void ApplyIniFile(const ScannedIniFile& scanned, Config& out, bool isDropIn, ConfigProvenance* provenance) {
+            for (const auto& warning : scanned.warnings) {
+                logs::warn("Config: {}", warning);
+            }
+
+            if (!isDropIn) {
+                for (const auto& section : kDynamicSections) section.clear(out);
+            }
+
+            for (const auto& a : scanned.assignments) {
+                if (a.field >= kDynamicFieldBase) {
+                    const auto& section = kDynamicSections[a.field - kDynamicFieldBase];
+                    if (!section.parse(out, a.key, a.value, isDropIn ? std::string_view(scanned.name) : std::string_view())) {
+                        logs::warn("Config: {}:{}: invalid [{}] entry '{} = {}', ignored",
+                            scanned.name, a.line, section.section, a.key, a.value);
+                    }
+                    continue;
+                }
+
+                const auto& field = kConfigSchema[a.field];
+
+                auto result = ParseField(out, field, a.value, isDropIn);
+                if (result == ParseResult::kInvalid) {
+                    logs::warn("Config: {}:{}: invalid value '{}' for {}, keeping the previous value",
+                        scanned.name, a.line, a.value, field.key);
+                    continue;
+                }
+                if (result == ParseResult::kClamped) {
+                    logs::warn("Config: {}:{}: {} = {} is outside [{}, {}], clamped",
+                        scanned.name, a.line, field.key, a.value, field.minValue, field.maxValue);
+                }
+
+                if (!provenance) continue;
+                auto& source = (*provenance)[a.field];
+                if (isDropIn && !source.file.empty() && source.file != scanned.name) {
+                    logs::info("Config: [{}] {} from {}:{} overrides {}:{}",
+                        field.section, field.key, scanned.name, a.line, source.file, source.line);
+                }
+                source.file = scanned.name;
+                source.line = a.line;
+            }
         }
 
-        void WriteComment(std::ofstream& file, const char* comment) {
-            file << "# " << comment << "\n";
+        // Save() formats the whole file into one buffer before any I/O.
+        void WriteComment(std::string& out, std::string_view comment) {
+            std::format_to(std::back_inserter(out), "# {}\n", comment);
         }
 
-        // Split a comma-separated string into trimmed tokens.
-        std::vector<std::string> SplitCSV(const std::string& str) {
-            std::vector<std::string> tokens;
-            std::stringstream ss(str);
-            std::string token;
-            while (std::getline(ss, token, ',')) {
-                auto t = Trim(token);
-                if (!t.empty()) tokens.push_back(std::move(t));
+        void WriteCommentLines(std::string& out, std::string_view comment) {
+            while (!comment.empty()) {
+                auto eol = comment.find('\n');
+                WriteComment(out, comment.substr(0, eol));
+                if (eol == std::string_view::npos) break;
+                comment.remove_prefix(eol + 1);
             }
-            return tokens;
         }
 
         std::string JoinCSV(const std::unordered_set<std::string>& set) {
@@ -74,6 +335,101 @@ namespace SWF {
         }
     } 
 
+    std::span<const DynamicSectionDesc> GetDynamicSections() {
+        return kDynamicSections;
+    }
+
+    float GetConfigField(const Config& config, const FieldDesc& field) {
+        switch (field.type) {
+            case FieldType::kBool:  return field.Get<bool>(config) ? 1.0f : 0.0f;
+            case FieldType::kUInt:  return static_cast<float>(field.Get<std::uint32_t>(config));
+            case FieldType::kFloat: return field.Get<float>(config);
+            default:                return 0.0f;
+        }
+    }
+
+    bool SetConfigField(Config& config, const FieldDesc& field, float value) {
+        switch (field.type) {
+            case FieldType::kBool: {
+                auto& target = field.Get<bool>(config);
+                bool newValue = value != 0.0f;
+                return std::exchange(target, newValue) != newValue;
+            }
+            case FieldType::kUInt: {
+                auto& target = field.Get<std::uint32_t>(config);
+                auto newValue = static_cast<std::uint32_t>(std::clamp(value, field.minValue, field.maxValue));
+                return std::exchange(target, newValue) != newValue;
+            }
+            case FieldType::kFloat: {
+                auto& target = field.Get<float>(config);
+                auto newValue = std::clamp(value, field.minValue, field.maxValue);
+                return std::exchange(target, newValue) != newValue;
+            }
+            default:
+                return false;
+        }
+    }
+
+    ConfigDiff DiffConfigs(const Config& before, const Config& after) {
+        ConfigDiff diff;
+
+        for (const auto& field : kConfigSchema) {
+            bool changed = false;
+            switch (field.type) {
+                case FieldType::kBool:
+                case FieldType::kUInt:
+                case FieldType::kFloat:
+                    changed = GetConfigField(before, field) != GetConfigField(after, field);
+                    break;
+                case FieldType::kWorldspaceList:
+                    changed = before.enabledWorldspaces != after.enabledWorldspaces;
+                    break;
+                case FieldType::kWorldspaceToggle:
+                    break;  // covered by the list
+                case FieldType::kCurve:
+                    changed = field.Get<MonthCurve>(before) != field.Get<MonthCurve>(after);
+                    break;
+            }
+            if (changed) MarkChanged(diff, field.effect, field.season, field.weatherClass);
+        }
+
+        for (const auto& section : kDynamicSections) {
+            if (!section.equal(before, after)) MarkChanged(diff, section.effect, {}, {});
+        }
+        return diff;
+    }
+
+    void MergeConfigChanges(Config& live, const Config& base, const Config& changed) {
+        for (const auto& field : kConfigSchema) {
+            if (!FieldEquals(base, changed, field)) CopyField(live, changed, field);
+        }
+
+        for (const auto& section : kDynamicSections) {
+            if (!section.equal(base, changed)) section.assign(live, changed);
+        }
+    }
+
+    Config ToMainFile(const Config& live, const ConfigLayers& layers) {
+        Config out = live;
+        for (const auto& field : kConfigSchema) {
+            if (field.type == FieldType::kWorldspaceList) {
+                // Drop-ins only add worldspaces, so the edit is a delta on
+                // the main INI's list.
+                out.enabledWorldspaces = layers.main.enabledWorldspaces;
+                for (const auto& ws : live.enabledWorldspaces) {
+                    if (!layers.merged.enabledWorldspaces.contains(ws)) out.enabledWorldspaces.insert(ws);
+                }
+                for (const auto& ws : layers.merged.enabledWorldspaces) {
+                    if (!live.enabledWorldspaces.contains(ws)) out.enabledWorldspaces.erase(ws);
+                }
+            } else if (FieldEquals(live, layers.merged, field)) {
+                CopyField(out, layers.main, field);
+            }
+        }
+        // Dynamic sections drop their drop-in entries in Serialize().
+        return out;
+    }
+
     std::string ConfigManager::GetConfigPath() const {
         wchar_t modulePath[MAX_PATH] = {};
         if (GetModuleFileNameW(GetModuleHandleW(L"SeasonalWeatherFramework.dll"),
@@ -87,176 +443,303 @@ namespace SWF {
         return "Data/SKSE/Plugins/SeasonalWeatherFramework.ini";
     }
 
-    void ConfigManager::Load() {
-        std::unique_lock<std::mutex> lock(mutex_);
+    bool ConfigManager::ParseFile(const std::string& path, Config& out) {
+        ScannedIniFile scanned;
+        ScanIniFile(std::filesystem::path(path), scanned);
+        if (!scanned.file.IsOpen()) {
+            logs::warn("Failed to open config file: {}", path);
+            return false;
+        }
 
-        auto path = GetConfigPath();
-        if (!std::filesystem::exists(path)) {
-            lock.unlock();  
-            logs::info("Config file not found at {}, using defaults and creating one", path);
-            Save();
-            return;
+        ApplyIniFile(scanned, out, false, nullptr);
+        return true;
+    }
+
+    std::filesystem::path ConfigManager::GetDropInDirectory(const std::string& path) {
+        auto ini = std::filesystem::path(path);
+        return ini.parent_path() / ini.stem();
+    }
+
+    std::vector<std::filesystem::path> ConfigManager::ListDropIns(const std::string& path) {
+        std::vector<std::filesystem::path> files;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(GetDropInDirectory(path), ec)) {
+            if (!entry.is_regular_file(ec)) continue;
+            auto ext = entry.path().extension().string();
+            std::ranges::transform(ext, ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+            if (ext == ".ini") files.push_back(entry.path());
         }
 
-        std::ifstream file(path);
-        if (!file.is_open()) {
+        // Merge order is the file name order, independent of how the
+        // file system happens to enumerate the directory.
+        std::ranges::sort(files, [](const auto& a, const auto& b) {
+            return a.filename().native() < b.filename().native();
+        });
+        return files;
+    }
+
+    bool ConfigManager::ParseLayered(const std::string& path, Config& out, ConfigLayers* layers) {
+        auto start = std::chrono::steady_clock::now();
+
+        // Slot 0 is the main INI; drop-ins follow in file name order, so a
+        // later file wins for every key it sets.
+        std::vector<std::filesystem::path> paths{ std::filesystem::path(path) };
+        auto dropIns = ListDropIns(path);
+        paths.insert(paths.end(), dropIns.begin(), dropIns.end());
+
+        std::vector<ScannedIniFile> scanned(paths.size());
+        WorkerPool::GetSingleton().ParallelFor(TaskPriority::kHigh, "Config: scan INI", paths.size(),
+            [&](std::size_t i) { ScanIniFile(paths[i], scanned[i]); });
+
+        if (!scanned[0].file.IsOpen()) {
             logs::warn("Failed to open config file: {}", path);
-            return;
+            return false;
         }
 
-        std::string line;
-        std::string currentSection;
+        auto parsed = std::chrono::steady_clock::now();
 
-        while (std::getline(file, line)) {
-            line = Trim(line);
-            if (line.empty() || line[0] == '#' || line[0] == ';') continue;
+        auto* provenance = layers ? &layers->provenance : nullptr;
+        if (provenance) {
+            provenance->assign(kConfigSchema.size(), {});
+            for (std::size_t i = 0; i < kConfigSchema.size(); ++i) {
+                (*provenance)[i].section = kConfigSchema[i].section;
+                (*provenance)[i].key     = kConfigSchema[i].key;
+            }
+        }
 
-            // Section header
-            if (line[0] == '[') {
-                auto end = line.find(']');
-                if (end != std::string::npos) {
-                    currentSection = Trim(line.substr(1, end - 1));
-                }
+        for (std::size_t i = 0; i < scanned.size(); ++i) {
+            if (!scanned[i].file.IsOpen()) {
+                logs::warn("Config: could not open drop-in {}, skipped", scanned[i].name);
                 continue;
             }
+            ApplyIniFile(scanned[i], out, i > 0, provenance);
+            if (i == 0 && layers) layers->main = out;
+        }
+        if (layers) layers->merged = out;
+
+        if (!dropIns.empty()) {
+            auto end = std::chrono::steady_clock::now();
+            logs::info("Config: merged {} drop-in files from {} (scan {:.3f} ms, merge {:.3f} ms)",
+                dropIns.size(), GetDropInDirectory(path).string(),
+                std::chrono::duration<double, std::milli>(parsed - start).count(),
+                std::chrono::duration<double, std::milli>(end - parsed).count());
+        }
+        return true;
+    }
 
-            // Key = Value
-            auto eq = line.find('=');
-            if (eq == std::string::npos) continue;
-            auto key = Trim(line.substr(0, eq));
-            auto val = Trim(line.substr(eq + 1));
+    void ConfigManager::Publish() {
+        snapshot_.store(std::make_shared<const Config>(config_), std::memory_order_release);
+        WorkerPool::GetSingleton().SetLogAllTasks(config_.debugMode);
+    }
 
-            if (currentSection == "General") {
-                if (key == "bEnabled")             config_.enabled             = ParseBool(val, config_.enabled);
-                if (key == "bEnableNotifications") config_.enableNotifications = ParseBool(val, config_.enableNotifications);
-                if (key == "bDebugMode")           config_.debugMode           = ParseBool(val, config_.debugMode);
-            }
-            else if (currentSection == "SeasonMonths") {
-                if (key == "iSpringStart") config_.springStart = ParseInt(val, config_.springStart);
-                if (key == "iSpringEnd")   config_.springEnd   = ParseInt(val, config_.springEnd);
-                if (key == "iSummerStart") config_.summerStart  = ParseInt(val, config_.summerStart);
-                if (key == "iSummerEnd")   config_.summerEnd    = ParseInt(val, config_.summerEnd);
-                if (key == "iFallStart")   config_.fallStart    = ParseInt(val, config_.fallStart);
-                if (key == "iFallEnd")     config_.fallEnd      = ParseInt(val, config_.fallEnd);
-            }
-            else if (currentSection == "Worldspaces") {
-                if (key == "sEnabledWorldspaces") {
-                    // Comma-separated list of worldspace EditorIDs.
-                    config_.enabledWorldspaces.clear();
-                    for (auto& ws : SplitCSV(val))
-                        config_.enabledWorldspaces.insert(ws);
-                }
-                if (key == "bEnableTamriel") {
-                    if (ParseBool(val, true))
-                        config_.enabledWorldspaces.insert("Tamriel");
-                    else
-                        config_.enabledWorldspaces.erase("Tamriel");
-                }
-                if (key == "bEnableSolstheim") {
-                    if (ParseBool(val, true))
-                        config_.enabledWorldspaces.insert("DLC2SolstheimWorld");
-                    else
-                        config_.enabledWorldspaces.erase("DLC2SolstheimWorld");
-                }
+    void ConfigManager::Load() {
+        auto path = GetConfigPath();
+        if (!std::filesystem::exists(path)) {
+            // Written here rather than queued, so the parse below reads it
+            // back and still merges any drop-ins.
+            logs::info("Config file not found at {}, using defaults and creating one", path);
+            WriteConfigFile(*GetSnapshot(), nullptr);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+
+        // Keys missing from every file keep their current values.
+        Config parsed = *GetSnapshot();
+        ConfigLayers layers;
+
+        if (!ParseLayered(path, parsed, &layers)) return;
+
+        auto shared = std::make_shared<const ConfigLayers>(std::move(layers));
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_ = std::move(parsed);
+            layers_ = std::move(shared);
+        }
+        Publish();
+
+        auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        logs::info("Config loaded successfully from {} ({:.3f} ms)", path, ms);
+    }
+
+    std::string ConfigManager::Serialize(const Config& snapshot) {
+        std::string out;
+        out.reserve(4096);
+
+        WriteComment(out, "Seasonal Weather Framework SKSE - Configuration");
+        WriteComment(out, "Modifies region weather probabilities based on the current in-game season.");
+        WriteComment(out, "Any *.ini in the SeasonalWeatherFramework folder next to this file is merged");
+        WriteComment(out, "after it, in file name order; worldspace lists from those files are added.");
+        WriteComment(out, "");
+
+        std::string_view section;
+        for (const auto& field : kConfigSchema) {
+            if (!field.IsSaved()) continue;
+
+            if (field.section != section) {
+                section = field.section;
+                std::format_to(std::back_inserter(out), "\n[{}]\n", section);
             }
-            else if (currentSection == "Transitions") {
 
+            WriteCommentLines(out, field.comment);
+
+            switch (field.type) {
+                case FieldType::kBool:
+                    std::format_to(std::back_inserter(out), "{} = {}\n", field.key,
+                        field.Get<bool>(snapshot) ? "true" : "false");
+                    break;
+                case FieldType::kUInt:
+                    std::format_to(std::back_inserter(out), "{} = {}\n", field.key,
+                        field.Get<std::uint32_t>(snapshot));
+                    break;
+                case FieldType::kFloat:
+                    std::format_to(std::back_inserter(out), "{} = {:.2f}\n", field.key,
+                        field.Get<float>(snapshot));
+                    break;
+                case FieldType::kWorldspaceList:
+                    std::format_to(std::back_inserter(out), "{} = {}\n", field.key,
+                        JoinCSV(snapshot.enabledWorldspaces));
+                    break;
+                case FieldType::kWorldspaceToggle:
+                    break;
+                case FieldType::kCurve:
+                    std::format_to(std::back_inserter(out), "{} = ", field.key);
+                    FormatMonthCurve(field.Get<MonthCurve>(snapshot), out);
+                    out += '\n';
+                    break;
             }
-            else if (currentSection == "SpringMultipliers") {
-                if (key == "fPleasant") config_.springMultipliers.pleasantMult = ParseFloat(val, config_.springMultipliers.pleasantMult);
-                if (key == "fCloudy")   config_.springMultipliers.cloudyMult   = ParseFloat(val, config_.springMultipliers.cloudyMult);
-                if (key == "fRainy")    config_.springMultipliers.rainyMult    = ParseFloat(val, config_.springMultipliers.rainyMult);
-                if (key == "fSnow")     config_.springMultipliers.snowMult     = ParseFloat(val, config_.springMultipliers.snowMult);
+        }
+
+        for (const auto& dynamic : kDynamicSections) {
+            std::format_to(std::back_inserter(out), "\n[{}]\n", dynamic.section);
+            WriteCommentLines(out, dynamic.comment);
+            dynamic.write(snapshot, out, true);
+        }
+
+        return out;
+    }
+
+    void ConfigManager::Save() {
+        auto start = std::chrono::steady_clock::now();
+
+        auto snapshot = std::make_shared<const Config>(config_);
+        auto layers   = GetLayers();
+
+        bool schedule  = false;
+        bool coalesced = false;
+        {
+            std::lock_guard<std::mutex> lock(saveMutex_);
+            coalesced      = pendingSave_ != nullptr;
+            pendingSave_   = std::move(snapshot);
+            pendingLayers_ = std::move(layers);
+            if (!saveScheduled_) {
+                saveScheduled_ = schedule = true;
             }
-            else if (currentSection == "SummerMultipliers") {
-                if (key == "fPleasant") config_.summerMultipliers.pleasantMult = ParseFloat(val, config_.summerMultipliers.pleasantMult);
-                if (key == "fCloudy")   config_.summerMultipliers.cloudyMult   = ParseFloat(val, config_.summerMultipliers.cloudyMult);
-                if (key == "fRainy")    config_.summerMultipliers.rainyMult    = ParseFloat(val, config_.summerMultipliers.rainyMult);
-                if (key == "fSnow")     config_.summerMultipliers.snowMult     = ParseFloat(val, config_.summerMultipliers.snowMult);
+        }
+
+        if (schedule && !WorkerPool::GetSingleton().Submit(TaskPriority::kLow, "Save config",
+                [this]() { RunPendingSaves(); })) {
+            // Pool not running (or saturated): write on this thread instead.
+            RunPendingSaves();
+        }
+
+        if (GetConfig().debugMode) {
+            auto us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            logs::info("Config: Save requested ({:.1f} us on the calling thread{})", us,
+                coalesced ? ", merged into the pending save" : "");
+        }
+    }
+
+    void ConfigManager::LoadAsync(LoadCallback onLoaded) {
+        // Copied here, on the game thread; the worker never reads config_.
+        auto base = std::make_shared<const Config>(config_);
+
+        bool schedule = false;
+        {
+            std::lock_guard<std::mutex> lock(saveMutex_);
+            pendingLoad_     = std::move(onLoaded);
+            pendingLoadBase_ = std::move(base);
+            if (!saveScheduled_) {
+                saveScheduled_ = schedule = true;
             }
-            else if (currentSection == "FallMultipliers") {
-                if (key == "fPleasant") config_.fallMultipliers.pleasantMult = ParseFloat(val, config_.fallMultipliers.pleasantMult);
-                if (key == "fCloudy")   config_.fallMultipliers.cloudyMult   = ParseFloat(val, config_.fallMultipliers.cloudyMult);
-                if (key == "fRainy")    config_.fallMultipliers.rainyMult    = ParseFloat(val, config_.fallMultipliers.rainyMult);
-                if (key == "fSnow")     config_.fallMultipliers.snowMult     = ParseFloat(val, config_.fallMultipliers.snowMult);
+        }
+
+        // Otherwise the running chain reaches the load after its saves.
+        if (schedule && !WorkerPool::GetSingleton().Submit(TaskPriority::kNormal, "Load config",
+                [this]() { RunPendingSaves(); })) {
+            RunPendingSaves();
+        }
+    }
+
+    void ConfigManager::RunPendingSaves() {
+        for (;;) {
+            std::shared_ptr<const Config>       snapshot;
+            std::shared_ptr<const ConfigLayers> layers;
+            LoadCallback                        onLoaded;
+            std::shared_ptr<const Config>       loadBase;
+            {
+                std::lock_guard<std::mutex> lock(saveMutex_);
+                // Saves first, so a load reads back everything queued before it.
+                snapshot = std::move(pendingSave_);
+                layers   = std::move(pendingLayers_);
+                if (!snapshot) {
+                    onLoaded = std::exchange(pendingLoad_, nullptr);
+                    loadBase = std::move(pendingLoadBase_);
+                }
+                if (!snapshot && !onLoaded) {
+                    saveScheduled_ = false;
+                    saveIdle_.notify_all();
+                    return;
+                }
             }
-            else if (currentSection == "WinterMultipliers") {
-                if (key == "fPleasant") config_.winterMultipliers.pleasantMult = ParseFloat(val, config_.winterMultipliers.pleasantMult);
-                if (key == "fCloudy")   config_.winterMultipliers.cloudyMult   = ParseFloat(val, config_.winterMultipliers.cloudyMult);
-                if (key == "fRainy")    config_.winterMultipliers.rainyMult    = ParseFloat(val, config_.winterMultipliers.rainyMult);
-                if (key == "fSnow")     config_.winterMultipliers.snowMult     = ParseFloat(val, config_.winterMultipliers.snowMult);
+            if (snapshot) {
+                WriteConfigFile(*snapshot, layers.get());
+            } else {
+                RunLoad(*loadBase, onLoaded);
             }
         }
+    }
+
+    void ConfigManager::RunLoad(const Config& base, const LoadCallback& onLoaded) {
+        auto start = std::chrono::steady_clock::now();
+        auto path  = GetConfigPath();
 
-        logs::info("Config loaded successfully from {}", path);
+        // Keys missing from every file keep their values from `base`.
+        auto loaded = std::make_shared<Config>(base);
+        ConfigLayers layers;
+        if (!ParseLayered(path, *loaded, &layers)) return;
+        SetLayers(std::move(layers));
+
+        auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        logs::info("Config re-read from {} ({:.3f} ms)", path, ms);
+        onLoaded(std::move(loaded));
     }
 
-    void ConfigManager::Save() {
+    void ConfigManager::WaitForPendingSave() {
+        std::unique_lock<std::mutex> lock(saveMutex_);
+        saveIdle_.wait(lock, [this]() { return !saveScheduled_; });
+    }
 
-        Config snapshot;
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            snapshot = config_;
-        }
+    void ConfigManager::WriteConfigFile(const Config& snapshot, const ConfigLayers* layers) {
+        auto start = std::chrono::steady_clock::now();
 
-        auto path = GetConfigPath();
+        std::filesystem::path path(GetConfigPath());
+        auto dir = path.parent_path();
+        std::error_code ec;
+        if (!dir.empty()) std::filesystem::create_directories(dir, ec);
 
-        auto dir = std::filesystem::path(path).parent_path();
-        if (!dir.empty() && !std::filesystem::exists(dir)) {
-            std::filesystem::create_directories(dir);
-        }
-
-        std::ofstream file(path);
-        if (!file.is_open()) {
-            logs::error("Failed to write config file: {}", path);
-            return;
-        }
-
-        WriteComment(file, "Seasonal Weather Framework SKSE - Configuration");
-        WriteComment(file, "Modifies region weather probabilities based on the current in-game season.");
-        WriteComment(file, "");
-
-        WriteSection(file, "General");
-        WriteComment(file, "Master toggle for the framework");
-        WriteBool(file, "bEnabled", snapshot.enabled);
-        WriteComment(file, "Show HUD notification when season changes");
-        WriteBool(file, "bEnableNotifications", snapshot.enableNotifications);
-        WriteComment(file, "Enable debug logging");
-        WriteBool(file, "bDebugMode", snapshot.debugMode);
-
-        WriteSection(file, "SeasonMonths");
-        WriteComment(file, "Month indices (0 = Morning Star ... 11 = Evening Star)");
-        WriteInt(file, "iSpringStart", snapshot.springStart);
-        WriteInt(file, "iSpringEnd", snapshot.springEnd);
-        WriteInt(file, "iSummerStart", snapshot.summerStart);
-        WriteInt(file, "iSummerEnd", snapshot.summerEnd);
-        WriteInt(file, "iFallStart", snapshot.fallStart);
-        WriteInt(file, "iFallEnd", snapshot.fallEnd);
-
-        WriteSection(file, "Worldspaces");
-        WriteComment(file, "Comma-separated list of worldspace EditorIDs to apply seasonal weather to.");
-        WriteComment(file, "Add any modded worldspace EditorID here (e.g. Tamriel,DLC2SolstheimWorld,Falskaar).");
-        file << "sEnabledWorldspaces = " << JoinCSV(snapshot.enabledWorldspaces) << "\n";
-
-        WriteSection(file, "Transitions");
-        WriteComment(file, "Note: smoothed transitions and transition speed have been removed.");
-        WriteComment(file, "Skyrim's own weather system handles all transitions naturally now.");
-
-        auto writeMultipliers = [&](const char* section, const SeasonWeatherMultipliers& m) {
-            WriteSection(file, section);
-            WriteComment(file, "Multipliers applied to base region weather chances for this season.");
-            WriteComment(file, "Values > 1.0 increase probability, < 1.0 decrease, 0.0 removes entirely.");
-            WriteFloat(file, "fPleasant", m.pleasantMult);
-            WriteFloat(file, "fCloudy", m.cloudyMult);
-            WriteFloat(file, "fRainy", m.rainyMult);
-            WriteFloat(file, "fSnow", m.snowMult);
-        };
+        auto text = Serialize(layers ? ToMainFile(snapshot, *layers) : snapshot);
+        auto formatted = std::chrono::steady_clock::now();
+
+        // Temp file + flush + rename: a crash mid-write never leaves a
+        // truncated config.
+        if (!WriteFileAtomic(path, text)) return;
 
-        writeMultipliers("SpringMultipliers", snapshot.springMultipliers);
-        writeMultipliers("SummerMultipliers", snapshot.summerMultipliers);
-        writeMultipliers("FallMultipliers",   snapshot.fallMultipliers);
-        writeMultipliers("WinterMultipliers", snapshot.winterMultipliers);
+        ConfigWatcher::GetSingleton().NoteOwnWrite();
 
-        logs::info("Config saved to {}", path);
+        auto end = std::chrono::steady_clock::now();
+        logs::info("Config saved to {} ({} bytes; format {:.3f} ms, write+flush+rename {:.3f} ms)",
+            path.string(), text.size(),
+            std::chrono::duration<double, std::milli>(formatted - start).count(),
+            std::chrono::duration<double, std::milli>(end - formatted).count());
     }
 }
@@ -3,7 +3,11 @@
 #include "pch.h"
 #include "Season.h"
 
+#include <array>
+#include <condition_variable>
 #include <fstream>
+#include <functional>
+#include <memory>
 #include <mutex>
 
 namespace SWF {
@@ -15,10 +19,115 @@ namespace SWF {
         float snowMult     = 1.0f;
     };
 
-    struct Config {
+    // Sparse replacement for the global multipliers: one optional value per
+    // (season, weather class). Used by region override rules.
+    struct MultiplierOverride {
+        static constexpr std::size_t kClasses = 4;  // kPleasant..kSnow
+        static constexpr std::size_t kSlots   = static_cast<std::size_t>(Season::kTotal) * kClasses;
+
+        std::uint16_t                 mask = 0;  // bit = season * kClasses + class
+        std::array<float, kSlots>     values{};
+
+        static constexpr std::size_t Slot(Season season, WeatherClass wc) {
+            return static_cast<std::size_t>(season) * kClasses + static_cast<std::size_t>(wc);
+        }
+
+        bool Has(Season season, WeatherClass wc) const {
+            return wc < WeatherClass::kUnknown && (mask & (1u << Slot(season, wc)));
+        }
+
+        float Get(Season season, WeatherClass wc, float fallback) const {
+            return Has(season, wc) ? values[Slot(season, wc)] : fallback;
+        }
+
+        void Set(Season season, WeatherClass wc, float value) {
+            mask |= static_cast<std::uint16_t>(1u << Slot(season, wc));
+            values[Slot(season, wc)] = value;
+        }
+
+        // Values set in `later` win.
+        void Merge(const MultiplierOverride& later) {
+            for (std::size_t i = 0; i < kSlots; ++i) {
+                if (later.mask & (1u << i)) values[i] = later.values[i];
+            }
+            mask |= later.mask;
+        }
+
+        bool operator==(const MultiplierOverride& rhs) const {
+            if (mask != rhs.mask) return false;
+            for (std::size_t i = 0; i < kSlots; ++i) {
+                if ((mask & (1u << i)) && values[i] != rhs.values[i]) return false;
+            }
+            return true;
+        }
+    };
+
+    // [RegionOverrides] pattern = Season.Class=multiplier, ...
+    // Pattern forms: glob on the region EditorID ("*Pale*"), "re:<regex>"
+    // on the region EditorID, or "ws:<glob>" on the worldspace EditorID.
+    struct RegionOverrideRule {
+        std::string        pattern;
+        MultiplierOverride multipliers;
+        std::string        source;   // drop-in file name; empty for the main INI, menu and presets
+
+        bool operator==(const RegionOverrideRule&) const = default;
+    };
+
+    // [WeatherOverrides] Plugin.esp|0xLocalID = Season=multiplier, ...
+    // Replaces the class multiplier of one specific weather, whatever its
+    // class flags (and wins over region rules).
+    struct WeatherOverrideRule {
+        std::string   plugin;
+        RE::FormID    localFormID = 0;
+        std::uint8_t  seasonMask  = 0;   // bit per Season
+        std::array<float, static_cast<std::size_t>(Season::kTotal)> multipliers{};
+        std::string   source;            // drop-in file name; empty for the main INI, menu and presets
+
+        bool Has(Season season) const { return seasonMask & (1u << static_cast<std::uint32_t>(season)); }
+        float Get(Season season, float fallback) const {
+            return Has(season) ? multipliers[static_cast<std::size_t>(season)] : fallback;
+        }
+
+        bool operator==(const WeatherOverrideRule&) const = default;
+    };
+
+    // Keyframes (month, multiplier) over the 12-month year, interpolated
+    // linearly and wrapping from Evening Star back to Morning Star. An
+    // empty curve follows the season bucket multipliers instead.
+    struct MonthCurve {
+        struct Keyframe {
+            float month = 0.0f;   // 0 = Morning Star ... 11 = Evening Star; fractions allowed
+            float value = 1.0f;
+
+            bool operator==(const Keyframe&) const = default;
+        };
+
+        std::vector<Keyframe> keyframes;   // sorted by month
+
+        bool operator==(const MonthCurve&) const = default;
+    };
+
+    // [WorldspaceSeasons] WorldspaceEditorID = offset=<days>, Season.Class=multiplier, ...
+    // The worldspace runs its own calendar `offsetDays` ahead of (or, when
+    // negative, behind) the game date, and the multipliers it sets replace
+    // the global ones for its regions. Region rules still win over them.
+    struct WorldspaceSeasonRule {
+        std::string        worldspace;
+        std::int32_t       offsetDays = 0;
+        MultiplierOverride multipliers;
+        std::string        source;   // drop-in file name; empty for the main INI, menu and presets
+
+        bool operator==(const WorldspaceSeasonRule&) const = default;
+    };
+
+    // The scalar settings. Kept apart from the containers in Config so it
+    // can be built in a constant expression: kConfigSchema reads its
+    // defaults from ConfigValues{} at compile time instead of repeating them.
+    struct ConfigValues {
         // General
         bool  enabled             = true;
         bool  enableNotifications = true;     // show notification on season change
+        bool  hotReload           = false;    // watch the INI and apply edits live
 
         // Season month ranges (configurable)
         std::uint32_t springStart = 2;  // First Seed
@@ -34,6 +143,28 @@ namespace SWF {
         SeasonWeatherMultipliers fallMultipliers   = { 0.8f, 1.3f, 1.2f, 0.5f };  // More clouds and rain, some snow
         SeasonWeatherMultipliers winterMultipliers = { 0.3f, 1.0f, 0.8f, 2.5f };  // Heavy snow, few pleasant days
 
+        // Transitions — minimum real-time seconds between forced weather
+        // resets. Resets that are not needed right away wait for the next
+        // natural weather transition or loading screen instead.
+        float minResetIntervalSeconds = 30.0f;
+
+        // Month curves — instead of four hard season buckets, each weather
+        // class follows a curve over the 12 months (Config::monthCurves).
+        bool useMonthCurves  = false;
+        bool interpolateDays = false;    // blend toward the next month, once per game day
+
+        // Day calendar — seasons start on a day of the year (0 = 1st of
+        // Morning Star) and blend over a window centred on each start day,
+        // instead of switching on the month ranges above.
+        bool          useDayCalendar = false;
+        std::array<std::uint32_t, 4> seasonStartDays = { 59, 151, 243, 334 };  // indexed by Season
+        std::uint32_t transitionDays = 14;
+
+        // Advanced
+        bool  debugMode              = false;
+    };
+
+    struct Config : ConfigValues {
         // Worldspace settings — add any modded worldspace EditorID to this set
         // to enable seasonal weather there. Serialised as a comma-separated list
         // in the INI under [Worldspaces] sEnabledWorldspaces.
@@ -43,8 +174,19 @@ namespace SWF {
             return enabledWorldspaces.count(std::string(name)) > 0;
         }
 
-        // Advanced
-        bool  debugMode              = false;
+        // One curve per weather class (indexed by WeatherClass), used when
+        // useMonthCurves is set.
+        std::array<MonthCurve, 4> monthCurves;
+
+        // Region-specific multiplier overrides, applied in order (later
+        // rules win for the (season, class) pairs they set).
+        std::vector<RegionOverrideRule> regionOverrides;
+
+        // Per-weather multipliers; the last rule for a weather wins.
+        std::vector<WeatherOverrideRule> weatherOverrides;
+
+        // Per-worldspace calendars; the last rule for a worldspace wins.
+        std::vector<WorldspaceSeasonRule> worldspaceSeasons;
 
         Season GetSeasonForMonth(std::uint32_t month) const {
             if (month >= springStart && month <= springEnd)  return Season::kSpring;
@@ -74,6 +216,67 @@ namespace SWF {
         }
     };
 
+    // What changed between two configs, at the granularity the weather
+    // pipeline can act on. Produced by DiffConfigs() for hot reload.
+    struct ConfigDiff {
+        bool enabled     = false;
+        bool months      = false;
+        bool worldspaces = false;
+        bool other       = false;  // settings that need no weather work
+        bool tables      = false;  // needs a full chance-table rebuild (override rules)
+
+        // Per season, one bit per WeatherClass whose multiplier changed.
+        std::array<std::uint8_t, static_cast<std::size_t>(Season::kTotal)> multiplierClasses{};
+
+        bool HasMultiplierChanges() const {
+            return std::ranges::any_of(multiplierClasses, [](std::uint8_t m) { return m != 0; });
+        }
+        bool Any() const { return enabled || months || worldspaces || other || tables || HasMultiplierChanges(); }
+
+        ConfigDiff& operator|=(const ConfigDiff& rhs) {
+            enabled     |= rhs.enabled;
+            months      |= rhs.months;
+            worldspaces |= rhs.worldspaces;
+            other       |= rhs.other;
+            tables      |= rhs.tables;
+            for (std::size_t s = 0; s < multiplierClasses.size(); ++s) {
+                multiplierClasses[s] |= rhs.multiplierClasses[s];
+            }
+            return *this;
+        }
+    };
+
+    ConfigDiff DiffConfigs(const Config& before, const Config& after);
+
+    // Copies into `live` only the settings that differ between `base` and
+    // `changed`, so edits made to `live` since `base` was taken survive.
+    // Rule sections and worldspace lists are replaced as a whole.
+    void MergeConfigChanges(Config& live, const Config& base, const Config& changed);
+
+    // Which file and line last set a config key; file is empty for keys
+    // that kept their built-in default.
+    struct ConfigKeySource {
+        std::string_view section;
+        std::string_view key;
+        std::string      file;
+        std::uint32_t    line = 0;
+    };
+    using ConfigProvenance = std::vector<ConfigKeySource>;
+
+    // What the last load read, per layer. Save() writes a key that is
+    // unchanged since that load with the main INI's own value, so values
+    // from drop-ins are never baked into the main file.
+    struct ConfigLayers {
+        ConfigProvenance provenance;
+        Config           main;     // the live config as of the load, plus the main INI
+        Config           merged;   // main plus every drop-in: what the load produced
+    };
+
+    // The config to write to the main INI for `live`: keys still as
+    // `layers` merged them take the main INI's value, edited keys the live
+    // one. Worldspace list edits are applied to the main INI's list.
+    Config ToMainFile(const Config& live, const ConfigLayers& layers);
+
     class ConfigManager {
     public:
         static ConfigManager& GetSingleton() {
@@ -81,21 +284,104 @@ namespace SWF {
             return instance;
         }
 
+        // The live config. Game thread only: it is edited in place, unlocked.
         Config& GetConfig() { return config_; }
         const Config& GetConfig() const { return config_; }
 
+        // Immutable copy of the live config as of the last BumpVersion() or
+        // Load(), for readers off the game thread. Never null.
+        std::shared_ptr<const Config> GetSnapshot() const {
+            return snapshot_.load(std::memory_order_acquire);
+        }
+
+        // Parses the INI and its drop-ins into the live config on the
+        // calling thread. Startup only: it does not wait for queued saves,
+        // so it is safe from a WorkerPool task.
         void Load();
+
+        // Parses the INI and its drop-ins on the worker pool once every save
+        // queued before the call has been written, over a copy of the live
+        // config taken by this call, and passes the result to `onLoaded` on
+        // that worker. Game thread; never blocks, and without the pool it
+        // runs inline.
+        using LoadCallback = std::function<void(std::shared_ptr<const Config> loaded)>;
+        void LoadAsync(LoadCallback onLoaded);
+
+        // Copies the live config and returns; formatting and the atomic
+        // temp-file + rename write run on the worker pool. Saves requested
+        // while one is queued collapse into a single write of the latest
+        // state. Game thread (or startup, before it runs).
         void Save();
 
+        // Blocks until queued saves and loads have finished. Never call it
+        // from the game thread or a WorkerPool task.
+        void WaitForPendingSave();
+
         std::string GetConfigPath() const;
 
+        // Parse an INI file on top of `out`; keys absent from the file keep
+        // their current values. Returns false if the file cannot be opened.
+        static bool ParseFile(const std::string& path, Config& out);
+
+        // ParseFile() of the main INI followed by every *.ini in the drop-in
+        // directory, merged in file name order. Files are scanned in parallel
+        // on the worker pool; the merge itself is sequential and deterministic.
+        // `layers`, if given, receives the per-layer record for SetLayers().
+        static bool ParseLayered(const std::string& path, Config& out, ConfigLayers* layers);
+
+        // "<dir>/SeasonalWeatherFramework/" next to the INI at `path`.
+        static std::filesystem::path GetDropInDirectory(const std::string& path);
+
+        // The *.ini files in GetDropInDirectory(path), in merge order.
+        static std::vector<std::filesystem::path> ListDropIns(const std::string& path);
+
+        std::shared_ptr<const ConfigLayers> GetLayers() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return layers_;
+        }
+        void SetLayers(ConfigLayers layers) {
+            auto shared = std::make_shared<const ConfigLayers>(std::move(layers));
+            std::lock_guard<std::mutex> lock(mutex_);
+            layers_ = std::move(shared);
+        }
+
+        // Incremented whenever the live config is mutated, so consumers can
+        // tell when derived data is stale.
+        std::uint64_t GetVersion() const { return version_.load(std::memory_order_acquire); }
+
+        // After every change to the live config, on the game thread:
+        // publishes it to GetSnapshot(), then bumps the version.
+        void BumpVersion() {
+            Publish();
+            version_.fetch_add(1, std::memory_order_acq_rel);
+        }
+
     private:
         ConfigManager() = default;
         ~ConfigManager() = default;
         ConfigManager(const ConfigManager&) = delete;
         ConfigManager& operator=(const ConfigManager&) = delete;
 
+        static std::string Serialize(const Config& snapshot);
+        void RunPendingSaves();
+        void RunLoad(const Config& base, const LoadCallback& onLoaded);
+        void WriteConfigFile(const Config& snapshot, const ConfigLayers* layers);
+        void Publish();
+
         Config config_;
+        std::atomic<std::shared_ptr<const Config>> snapshot_{ std::make_shared<const Config>() };
+        std::shared_ptr<const ConfigLayers> layers_;   // null until a load has read the INI
+        std::atomic<std::uint64_t> version_ = 0;
         mutable std::mutex mutex_;
+
+        std::mutex                          saveMutex_;
+        std::condition_variable             saveIdle_;
+        // Saves and loads run one after another on one pool task chain;
+        // saveScheduled_ is set while that chain is queued or running.
+        std::shared_ptr<const Config>       pendingSave_;
+        std::shared_ptr<const ConfigLayers> pendingLayers_;   // layers as of pendingSave_
+        LoadCallback                        pendingLoad_;
+        std::shared_ptr<const Config>       pendingLoadBase_;   // live config when pendingLoad_ was queued
+        bool                                saveScheduled_ = false;
     };
 }
@@ -0,0 +1,235 @@
+#include "ConfigHistory.h"
+#include "ChanceTable.h"
+#include "WeatherManager.h"
+
+namespace SWF {
+
+    namespace {
+        std::size_t PartBytes(const std::unordered_set<std::string>& set) {
+            auto bytes = set.bucket_count() * sizeof(void*) + set.size() * (sizeof(std::string) + 2 * sizeof(void*));
+            for (const auto& value : set) bytes += value.capacity();
+            return bytes;
+        }
+
+        std::size_t PartBytes(const std::array<MonthCurve, 4>& curves) {
+            std::size_t bytes = sizeof(curves);
+            for (const auto& curve : curves) bytes += curve.keyframes.capacity() * sizeof(MonthCurve::Keyframe);
+            return bytes;
+        }
+
+        std::size_t PartBytes(const std::vector<RegionOverrideRule>& rules) {
+            auto bytes = rules.capacity() * sizeof(RegionOverrideRule);
+            for (const auto& rule : rules) bytes += rule.pattern.capacity() + rule.source.capacity();
+            return bytes;
+        }
+
+        std::size_t PartBytes(const std::vector<WeatherOverrideRule>& rules) {
+            auto bytes = rules.capacity() * sizeof(WeatherOverrideRule);
+            for (const auto& rule : rules) bytes += rule.plugin.capacity() + rule.source.capacity();
+            return bytes;
+        }
+
+        std::size_t PartBytes(const std::vector<WorldspaceSeasonRule>& rules) {
+            auto bytes = rules.capacity() * sizeof(WorldspaceSeasonRule);
+            for (const auto& rule : rules) bytes += rule.worldspace.capacity() + rule.source.capacity();
+            return bytes;
+        }
+
+        // `previous` if it holds the same value, else a new copy whose size
+        // is added to `bytes`.
+        template <class T>
+        std::shared_ptr<const T> Share(const T& value, const std::shared_ptr<const T>* previous, std::size_t& bytes) {
+            if (previous && *previous && **previous == value) return *previous;
+            bytes += PartBytes(value);
+            return std::make_shared<const T>(value);
+        }
+
+        // Bytes of `part` if `next` shares it, i.e. what `next` takes over
+        // when the entry before it is evicted.
+        template <class T>
+        std::size_t SharedBytes(const std::shared_ptr<const T>& part, const std::shared_ptr<const T>& next) {
+            return part && part == next ? PartBytes(*part) : 0;
+        }
+    }
+
+    Config ConfigHistory::Entry::Materialize() const {
+        Config config = scalars;
+        if (worldspaces)       config.enabledWorldspaces = *worldspaces;
+        if (monthCurves)       config.monthCurves        = *monthCurves;
+        if (regionOverrides)   config.regionOverrides    = *regionOverrides;
+        if (weatherOverrides)  config.weatherOverrides   = *weatherOverrides;
+        if (worldspaceSeasons) config.worldspaceSeasons  = *worldspaceSeasons;
+        return config;
+    }
+
+    ConfigHistory::Entry ConfigHistory::MakeEntry(const Config& config, const Entry* previous) const {
+        Entry entry;
+        entry.bytes = sizeof(Entry);
+        entry.worldspaces       = Share(config.enabledWorldspaces, previous ? &previous->worldspaces : nullptr,
+                                        entry.bytes);
+        entry.monthCurves       = Share(config.monthCurves, previous ? &previous->monthCurves : nullptr,
+                                        entry.bytes);
+        entry.regionOverrides   = Share(config.regionOverrides, previous ? &previous->regionOverrides : nullptr,
+                                        entry.bytes);
+        entry.weatherOverrides  = Share(config.weatherOverrides, previous ? &previous->weatherOverrides : nullptr,
+                                        entry.bytes);
+        entry.worldspaceSeasons = Share(config.worldspaceSeasons, previous ? &previous->worldspaceSeasons : nullptr,
+                                        entry.bytes);
+
+        entry.scalars = config;
+        entry.scalars.enabledWorldspaces = {};
+        entry.scalars.monthCurves        = {};
+        entry.scalars.regionOverrides    = {};
+        entry.scalars.weatherOverrides   = {};
+        entry.scalars.worldspaceSeasons  = {};
+        return entry;
+    }
+
+    void ConfigHistory::KeepTable(Entry& entry) {
+        auto live = WeatherManager::GetSingleton().GetChanceTable();
+        if (!live || live->configVersion != entry.version || live == entry.table) return;
+
+        DropTable(entry);
+        entry.table      = std::move(live);
+        entry.tableBytes = entry.table->GetMemoryBytes();
+        bytes_ += entry.tableBytes;
+    }
+
+    void ConfigHistory::DropTable(Entry& entry) {
+        bytes_ -= entry.tableBytes;
+        entry.table.reset();
+        entry.tableBytes = 0;
+    }
+
+    void ConfigHistory::PopFront() {
+        auto& front = entries_.front();
+        if (entries_.size() > 1) {
+            // Parts the next entry shares become its own.
+            auto& next = entries_[1];
+            auto shared = SharedBytes(front.worldspaces, next.worldspaces) +
+                          SharedBytes(front.monthCurves, next.monthCurves) +
+                          SharedBytes(front.regionOverrides, next.regionOverrides) +
+                          SharedBytes(front.weatherOverrides, next.weatherOverrides) +
+                          SharedBytes(front.worldspaceSeasons, next.worldspaceSeasons);
+            next.bytes  += shared;
+            front.bytes -= shared;
+        }
+        DropTable(front);
+        bytes_ -= front.bytes;
+        entries_.pop_front();
+        if (cursor_ > 0) --cursor_;
+    }
+
+    void ConfigHistory::PopBack() {
+        auto& back = entries_.back();
+        DropTable(back);
+        bytes_ -= back.bytes;
+        entries_.pop_back();
+        if (cursor_ >= entries_.size() && cursor_ > 0) cursor_ = entries_.size() - 1;
+    }
+
+    void ConfigHistory::Trim() {
+        while (bytes_ > kMaxBytes) {
+            // Cached tables go first, farthest from the live version.
+            Entry*      farthest = nullptr;
+            std::size_t distance = 0;
+            for (std::size_t i = 0; i < entries_.size(); ++i) {
+                if (!entries_[i].table) continue;
+                auto d = i > cursor_ ? i - cursor_ : cursor_ - i;
+                if (!farthest || d > distance) {
+                    farthest = &entries_[i];
+                    distance = d;
+                }
+            }
+            if (farthest) {
+                DropTable(*farthest);
+                continue;
+            }
+
+            if (entries_.size() <= 1) break;
+            if (cursor_ > 0) PopFront();
+            else             PopBack();
+        }
+    }
+
+    void ConfigHistory::Sync(const Config& config, std::uint64_t version) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (entries_.empty()) {
+            auto entry = MakeEntry(config, nullptr);
+            entry.version  = version;
+            entry.label    = "Initial settings";
+            entry.recorded = std::chrono::steady_clock::now();
+            bytes_ += entry.bytes;
+            entries_.push_back(std::move(entry));
+            cursor_ = 0;
+        }
+        KeepTable(entries_[cursor_]);
+        Trim();
+    }
+
+    void ConfigHistory::Record(const Config& config, std::uint64_t version, std::string label,
+                               std::uint32_t mergeKey) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = std::chrono::steady_clock::now();
+
+        // Anything past the live version can no longer be redone.
+        while (entries_.size() > cursor_ + 1) PopBack();
+
+        if (entries_.size() > 1 && mergeKey != 0 && entries_.back().mergeKey == mergeKey &&
+            now - entries_.back().recorded < kMergeWindow) {
+            PopBack();
+        } else if (!entries_.empty()) {
+            KeepTable(entries_.back());
+        }
+
+        auto entry = MakeEntry(config, entries_.empty() ? nullptr : &entries_.back());
+        entry.version  = version;
+        entry.label    = std::move(label);
+        entry.mergeKey = mergeKey;
+        entry.recorded = now;
+        entry.bytes   += entry.label.capacity();
+        bytes_ += entry.bytes;
+        entries_.push_back(std::move(entry));
+        cursor_ = entries_.size() - 1;
+        Trim();
+
+        if (ConfigManager::GetSingleton().GetConfig().debugMode) {
+            logs::info("ConfigHistory: Recorded '{}' ({} versions, {} bytes)", entries_.back().label,
+                entries_.size(), bytes_);
+        }
+    }
+
+    std::optional<Config> ConfigHistory::Undo() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cursor_ == 0 || entries_.empty()) return std::nullopt;
+        logs::info("ConfigHistory: Undo '{}'", entries_[cursor_].label);
+        return entries_[--cursor_].Materialize();
+    }
+
+    std::optional<Config> ConfigHistory::Redo() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (cursor_ + 1 >= entries_.size()) return std::nullopt;
+        logs::info("ConfigHistory: Redo '{}'", entries_[cursor_ + 1].label);
+        return entries_[++cursor_].Materialize();
+    }
+
+    std::shared_ptr<const ChanceTable> ConfigHistory::OnRestored(std::uint64_t version) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (entries_.empty()) return nullptr;
+        auto& entry = entries_[cursor_];
+        entry.version = version;
+        return entry.table;
+    }
+
+    ConfigHistory::Status ConfigHistory::GetStatus() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        Status status;
+        if (cursor_ > 0 && cursor_ < entries_.size()) status.undoLabel = entries_[cursor_].label;
+        if (cursor_ + 1 < entries_.size())           status.redoLabel = entries_[cursor_ + 1].label;
+        status.entries = entries_.size();
+        status.cachedTables = static_cast<std::size_t>(
+            std::ranges::count_if(entries_, [](const Entry& entry) { return entry.table != nullptr; }));
+        status.bytes = bytes_;
+        return status;
+    }
+}
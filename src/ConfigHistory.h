@@ -0,0 +1,105 @@
+#pragma once
+
+#include "pch.h"
+#include "Config.h"
+
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace SWF {
+
+    struct ChanceTable;
+
+    // Undo/redo over config versions. Each entry keeps the scalar settings
+    // by value and the rule lists, month curves and worldspace set by shared
+    // pointer, reused from the previous entry when an edit leaves them alone,
+    // so recording a slider move costs one Config's worth of scalars. Each
+    // entry also keeps the chance table that was live for it, so stepping
+    // back can reinstall it instead of rebuilding. The history is bounded by
+    // memory, not entry count: cached tables are released first, then the
+    // oldest versions.
+    //
+    // Mutated by CommandQueue::Drain on the game thread; GetStatus() is safe
+    // from the render thread.
+    class ConfigHistory {
+    public:
+        static ConfigHistory& GetSingleton() {
+            static ConfigHistory instance;
+            return instance;
+        }
+
+        static constexpr std::size_t kMaxBytes = 16u << 20;
+
+        // Edits with the same non-zero merge key within this window replace
+        // the newest entry (one entry per slider drag, not per step).
+        static constexpr std::chrono::milliseconds kMergeWindow{ 1000 };
+
+        // Start of a command batch: records `config` as the first version if
+        // the history is empty, and keeps the live chance table with the
+        // current entry if it was built for `version`.
+        void Sync(const Config& config, std::uint64_t version);
+
+        // A new version after an edit. Drops anything that could be redone.
+        void Record(const Config& config, std::uint64_t version, std::string label, std::uint32_t mergeKey = 0);
+
+        // Move one version back or forward; nullopt at either end.
+        std::optional<Config> Undo();
+        std::optional<Config> Redo();
+
+        // After an Undo() or Redo() has become the live config as `version`:
+        // restamps the entry and returns its cached table, if any.
+        std::shared_ptr<const ChanceTable> OnRestored(std::uint64_t version);
+
+        struct Status {
+            std::string undoLabel;          // empty if nothing to undo
+            std::string redoLabel;          // empty if nothing to redo
+            std::size_t entries      = 0;
+            std::size_t cachedTables = 0;
+            std::size_t bytes        = 0;
+        };
+        Status GetStatus() const;
+
+    private:
+        ConfigHistory() = default;
+        ~ConfigHistory() = default;
+        ConfigHistory(const ConfigHistory&) = delete;
+        ConfigHistory& operator=(const ConfigHistory&) = delete;
+
+        using Worldspaces = std::unordered_set<std::string>;
+        using MonthCurves = std::array<MonthCurve, 4>;
+
+        struct Entry {
+            Config                                                   scalars;   // shared members left empty
+            std::shared_ptr<const Worldspaces>                       worldspaces;
+            std::shared_ptr<const MonthCurves>                       monthCurves;
+            std::shared_ptr<const std::vector<RegionOverrideRule>>   regionOverrides;
+            std::shared_ptr<const std::vector<WeatherOverrideRule>>  weatherOverrides;
+            std::shared_ptr<const std::vector<WorldspaceSeasonRule>> worldspaceSeasons;
+
+            std::shared_ptr<const ChanceTable>    table;       // live table for `version`, if one was built
+            std::size_t                           tableBytes = 0;
+            std::uint64_t                         version    = 0;
+            std::string                           label;
+            std::uint32_t                         mergeKey   = 0;
+            std::chrono::steady_clock::time_point recorded;
+            std::size_t                           bytes      = 0;  // scalars plus the parts this entry introduced
+
+            Config Materialize() const;
+        };
+
+        Entry MakeEntry(const Config& config, const Entry* previous) const;
+        void  KeepTable(Entry& entry);
+        void  DropTable(Entry& entry);
+        void  PopFront();
+        void  PopBack();
+        void  Trim();
+
+        std::deque<Entry>  entries_;
+        std::size_t        cursor_ = 0;   // index of the live version
+        std::size_t        bytes_  = 0;   // entry bytes plus cached table bytes
+        mutable std::mutex mutex_;
+    };
+}
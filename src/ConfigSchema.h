@@ -0,0 +1,268 @@
+#pragma once
+
+#include "pch.h"
+#include "Config.h"
+
+#include <array>
+#include <span>
+#include <string_view>
+
+namespace SWF {
+
+    // Single description of every INI key. The parser's key table, the
+    // writer, range validation, DiffConfigs() and the generic MenuUI
+    // widgets are all driven from kConfigSchema; adding a setting means
+    // adding one row here (plus the Config member).
+
+    enum class FieldType : std::uint8_t {
+        kBool,
+        kUInt,
+        kFloat,
+        kWorldspaceList,    // comma-separated EditorIDs, replaces the set
+        kWorldspaceToggle,  // legacy bEnableX key, adds/removes `arg`; never written
+        kCurve              // MonthCurve keyframes, "month:value, ..."
+    };
+
+    // Which part of the weather pipeline has to react when the field changes.
+    enum class FieldEffect : std::uint8_t {
+        kNone,          // read where it is used, no re-apply needed
+        kEnabled,
+        kMonths,
+        kWorldspaces,
+        kMultiplier,    // season + weatherClass identify the weight
+        kTables         // anything else that feeds the chance table; full rebuild
+    };
+
+    struct FieldDesc {
+        std::string_view section;
+        std::string_view key;
+        FieldType        type   = FieldType::kBool;
+        FieldEffect      effect = FieldEffect::kNone;
+
+        // Address of the field inside a Config; the pointee type follows `type`.
+        void* (*ref)(Config&) = nullptr;
+
+        float minValue     = 0.0f;  // numeric fields only
+        float maxValue     = 0.0f;
+        float defaultValue = 0.0f;  // taken from ConfigValues{}, see detail::DefaultOf
+
+        std::string_view comment = {};  // written above the key; '\n' separates lines
+        std::string_view label   = {};  // menu label; empty = no generic widget
+        std::string_view arg     = {};  // kWorldspaceToggle: the EditorID
+
+        Season        season       = Season::kSpring;
+        WeatherClass  weatherClass = WeatherClass::kUnknown;
+
+        template <class T>
+        T& Get(Config& config) const { return *static_cast<T*>(ref(config)); }
+        template <class T>
+        const T& Get(const Config& config) const { return *static_cast<T*>(ref(const_cast<Config&>(config))); }
+
+        constexpr bool IsNumeric() const { return type == FieldType::kUInt || type == FieldType::kFloat; }
+        constexpr bool IsSaved() const { return type != FieldType::kWorldspaceToggle; }
+    };
+
+    namespace detail {
+        template <auto Member>
+        void* FieldRef(Config& config) { return &(config.*Member); }
+
+        template <auto Outer, auto Inner>
+        void* NestedFieldRef(Config& config) { return &((config.*Outer).*Inner); }
+
+        template <auto Member, std::size_t Index>
+        void* ElementFieldRef(Config& config) { return &(config.*Member)[Index]; }
+
+        // Schema defaults are read from the member initialisers of
+        // ConfigValues, so the two cannot disagree.
+        template <auto Member>
+        constexpr float DefaultOf() { return static_cast<float>(ConfigValues{}.*Member); }
+
+        template <auto Outer, auto Inner>
+        constexpr float NestedDefaultOf() { return static_cast<float>((ConfigValues{}.*Outer).*Inner); }
+
+        template <auto Member, std::size_t Index>
+        constexpr float ElementDefaultOf() { return static_cast<float>((ConfigValues{}.*Member)[Index]); }
+
+        template <auto Member>
+        constexpr FieldDesc Bool(std::string_view section, std::string_view key, FieldEffect effect,
+                                 std::string_view comment, std::string_view label) {
+            return { section, key, FieldType::kBool, effect, &FieldRef<Member>,
+                     0.0f, 1.0f, DefaultOf<Member>(), comment, label };
+        }
+
+        template <auto Member>
+        constexpr FieldDesc Month(std::string_view key, std::string_view comment, std::string_view label) {
+            return { "SeasonMonths", key, FieldType::kUInt, FieldEffect::kMonths, &FieldRef<Member>,
+                     0.0f, 11.0f, DefaultOf<Member>(), comment, label };
+        }
+
+        template <auto Member>
+        constexpr std::array<FieldDesc, 4> Multipliers(std::string_view section, Season season) {
+            constexpr std::string_view kComment =
+                "Multipliers applied to base region weather chances for this season.\n"
+                "Values > 1.0 increase probability, < 1.0 decrease, 0.0 removes entirely.";
+
+            auto make = [&](std::string_view key, void* (*ref)(Config&), WeatherClass wc, float value,
+                            std::string_view comment, std::string_view label) {
+                FieldDesc d{ section, key, FieldType::kFloat, FieldEffect::kMultiplier, ref,
+                             0.0f, 10.0f, value, comment, label };
+                d.season       = season;
+                d.weatherClass = wc;
+                return d;
+            };
+
+            return { {
+                make("fPleasant", &NestedFieldRef<Member, &SeasonWeatherMultipliers::pleasantMult>,
+                     WeatherClass::kPleasant,
+                     NestedDefaultOf<Member, &SeasonWeatherMultipliers::pleasantMult>(), kComment, "Pleasant"),
+                make("fCloudy", &NestedFieldRef<Member, &SeasonWeatherMultipliers::cloudyMult>,
+                     WeatherClass::kCloudy,
+                     NestedDefaultOf<Member, &SeasonWeatherMultipliers::cloudyMult>(), {}, "Cloudy"),
+                make("fRainy", &NestedFieldRef<Member, &SeasonWeatherMultipliers::rainyMult>,
+                     WeatherClass::kRainy,
+                     NestedDefaultOf<Member, &SeasonWeatherMultipliers::rainyMult>(), {}, "Rainy"),
+                make("fSnow", &NestedFieldRef<Member, &SeasonWeatherMultipliers::snowMult>,
+                     WeatherClass::kSnow,
+                     NestedDefaultOf<Member, &SeasonWeatherMultipliers::snowMult>(), {}, "Snow"),
+            } };
+        }
+
+        constexpr std::array<FieldDesc, 6> MonthCurves() {
+            auto curve = [](std::string_view key, void* (*ref)(Config&), WeatherClass wc, std::string_view comment) {
+                FieldDesc d{ "MonthCurves", key, FieldType::kCurve, FieldEffect::kTables, ref,
+                             0.0f, 10.0f, 0.0f, comment };
+                d.weatherClass = wc;
+                return d;
+            };
+
+            return { {
+                Bool<&Config::useMonthCurves>("MonthCurves", "bUseMonthCurves", FieldEffect::kTables,
+                    "Use per-class curves over the 12 months instead of the four season buckets",
+                    "Use Month Curves"),
+                Bool<&Config::interpolateDays>("MonthCurves", "bInterpolateDays", FieldEffect::kTables,
+                    "Blend day by day toward the next month's values (one update per game day)",
+                    "Interpolate Between Days"),
+                curve("sPleasantCurve", &ElementFieldRef<&Config::monthCurves, 0>, WeatherClass::kPleasant,
+                    "Keyframes as month:multiplier pairs (0 = Morning Star ... 11 = Evening Star),\n"
+                    "interpolated linearly and wrapping around the year. Leave a curve empty to use\n"
+                    "the season multipliers for that class. Example: 0:0.3, 6:1.6, 9:0.8"),
+                curve("sCloudyCurve", &ElementFieldRef<&Config::monthCurves, 1>, WeatherClass::kCloudy, {}),
+                curve("sRainyCurve",  &ElementFieldRef<&Config::monthCurves, 2>, WeatherClass::kRainy, {}),
+                curve("sSnowCurve",   &ElementFieldRef<&Config::monthCurves, 3>, WeatherClass::kSnow, {}),
+            } };
+        }
+
+        constexpr std::array<FieldDesc, 6> SeasonCalendar() {
+            auto start = [](std::string_view key, void* (*ref)(Config&), float def,
+                            std::string_view comment, std::string_view label) {
+                return FieldDesc{ "SeasonCalendar", key, FieldType::kUInt, FieldEffect::kMonths, ref,
+                                  0.0f, static_cast<float>(kDaysPerYear - 1), def, comment, label };
+            };
+
+            return { {
+                Bool<&Config::useDayCalendar>("SeasonCalendar", "bUseDayCalendar", FieldEffect::kMonths,
+                    "Pick the season by day of the year, blending across transition windows,\n"
+                    "instead of by the month ranges in [SeasonMonths]", "Use Day Calendar"),
+                start("iSpringStartDay", &ElementFieldRef<&Config::seasonStartDays, 0>,
+                    ElementDefaultOf<&Config::seasonStartDays, 0>(),
+                    "Day of the year each season starts (0 = 1st of Morning Star ... 364 = 31st of Evening Star)",
+                    "Spring Start Day"),
+                start("iSummerStartDay", &ElementFieldRef<&Config::seasonStartDays, 1>,
+                    ElementDefaultOf<&Config::seasonStartDays, 1>(), {}, "Summer Start Day"),
+                start("iFallStartDay",   &ElementFieldRef<&Config::seasonStartDays, 2>,
+                    ElementDefaultOf<&Config::seasonStartDays, 2>(), {}, "Fall Start Day"),
+                start("iWinterStartDay", &ElementFieldRef<&Config::seasonStartDays, 3>,
+                    ElementDefaultOf<&Config::seasonStartDays, 3>(), {}, "Winter Start Day"),
+                { "SeasonCalendar", "iTransitionDays", FieldType::kUInt, FieldEffect::kMonths,
+                  &FieldRef<&Config::transitionDays>, 0.0f, 90.0f, DefaultOf<&Config::transitionDays>(),
+                  "Length in days of the blend between two seasons, centred on the start day (0 = hard switch)",
+                  "Transition Days" },
+            } };
+        }
+
+        template <class T, std::size_t... N>
+        constexpr auto Concat(const std::array<T, N>&... arrays) {
+            std::array<T, (N + ...)> result{};
+            std::size_t i = 0;
+            ((std::ranges::copy(arrays, result.begin() + i), i += N), ...);
+            return result;
+        }
+    }
+
+    inline constexpr auto kConfigSchema = detail::Concat(
+        std::array<FieldDesc, 14>{ {
+            detail::Bool<&Config::enabled>("General", "bEnabled", FieldEffect::kEnabled,
+                "Master toggle for the framework", "Enabled"),
+            detail::Bool<&Config::enableNotifications>("General", "bEnableNotifications", FieldEffect::kNone,
+                "Show HUD notification when season changes", "Show Season Change Notifications"),
+            detail::Bool<&Config::debugMode>("General", "bDebugMode", FieldEffect::kNone,
+                "Enable debug logging", "Debug Mode (verbose logging)"),
+            detail::Bool<&Config::hotReload>("General", "bHotReload", FieldEffect::kNone,
+                "Watch this file and apply edits while the game is running", "Hot Reload INI"),
+
+            detail::Month<&Config::springStart>("iSpringStart",
+                "Month indices (0 = Morning Star ... 11 = Evening Star)", "Spring Start"),
+            detail::Month<&Config::springEnd>("iSpringEnd",     {}, "Spring End"),
+            detail::Month<&Config::summerStart>("iSummerStart", {}, "Summer Start"),
+            detail::Month<&Config::summerEnd>("iSummerEnd",     {}, "Summer End"),
+            detail::Month<&Config::fallStart>("iFallStart",     {}, "Fall Start"),
+            detail::Month<&Config::fallEnd>("iFallEnd",         {}, "Fall End"),
+
+            { "Worldspaces", "sEnabledWorldspaces", FieldType::kWorldspaceList, FieldEffect::kWorldspaces,
+              &detail::FieldRef<&Config::enabledWorldspaces>, 0.0f, 0.0f, 0.0f,
+              "Comma-separated list of worldspace EditorIDs to apply seasonal weather to.\n"
+              "Add any modded worldspace EditorID here (e.g. Tamriel,DLC2SolstheimWorld,Falskaar)." },
+            { "Worldspaces", "bEnableTamriel", FieldType::kWorldspaceToggle, FieldEffect::kWorldspaces,
+              &detail::FieldRef<&Config::enabledWorldspaces>, 0.0f, 1.0f, 1.0f, {}, {}, "Tamriel" },
+            { "Worldspaces", "bEnableSolstheim", FieldType::kWorldspaceToggle, FieldEffect::kWorldspaces,
+              &detail::FieldRef<&Config::enabledWorldspaces>, 0.0f, 1.0f, 1.0f, {}, {}, "DLC2SolstheimWorld" },
+
+            { "Transitions", "fMinResetIntervalSeconds", FieldType::kFloat, FieldEffect::kNone,
+              &detail::FieldRef<&Config::minResetIntervalSeconds>, 0.0f, 600.0f,
+              detail::DefaultOf<&Config::minResetIntervalSeconds>(),
+              "Skyrim's own weather system handles transitions. When new season weights remove\n"
+              "the current weather, the re-pick waits for the next natural transition or loading\n"
+              "screen. Minimum real-time seconds between forced weather resets:",
+              "Min Seconds Between Weather Resets" },
+        } },
+        detail::Multipliers<&Config::springMultipliers>("SpringMultipliers", Season::kSpring),
+        detail::Multipliers<&Config::summerMultipliers>("SummerMultipliers", Season::kSummer),
+        detail::Multipliers<&Config::fallMultipliers>("FallMultipliers",     Season::kFall),
+        detail::Multipliers<&Config::winterMultipliers>("WinterMultipliers", Season::kWinter),
+        detail::MonthCurves(),
+        detail::SeasonCalendar());
+
+    // Schema index of a key, resolved at compile time by callers that name
+    // a specific field (e.g. the menu). -1 if the key does not exist.
+    constexpr int FindConfigField(std::string_view section, std::string_view key) {
+        for (std::size_t i = 0; i < kConfigSchema.size(); ++i) {
+            if (kConfigSchema[i].section == section && kConfigSchema[i].key == key) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    // Sections whose keys are user data rather than fixed names (e.g.
+    // [RegionOverrides], keyed by pattern). Every file appends to the
+    // collection; the collection is cleared before a load merges files.
+    // Each entry remembers the drop-in it came from (`source`, empty for the
+    // main INI), and the main INI is written back without drop-in entries.
+    struct DynamicSectionDesc {
+        std::string_view section;
+        std::string_view comment;   // written under the header; '\n' separates lines
+        FieldEffect      effect;
+
+        void (*clear)(Config&);
+        bool (*parse)(Config&, std::string_view key, std::string_view value, std::string_view source);
+        void (*write)(const Config&, std::string& out, bool mainFileOnly);   // "key = value\n" lines
+        bool (*equal)(const Config&, const Config&);
+        void (*assign)(Config& to, const Config& from);
+    };
+
+    std::span<const DynamicSectionDesc> GetDynamicSections();
+
+    // Numeric/bool access through a float, used by the menu and the
+    // command queue. SetConfigField clamps to the field's range and
+    // returns false if the value did not change.
+    float GetConfigField(const Config& config, const FieldDesc& field);
+    bool  SetConfigField(Config& config, const FieldDesc& field, float value);
+}
@@ -0,0 +1,155 @@
+#include "ConfigWatcher.h"
+#include "CommandQueue.h"
+#include "Config.h"
+#include "EntryOverrides.h"
+#include "PerfStats.h"
+
+namespace SWF {
+
+    ConfigWatcher::FileStamp ConfigWatcher::ReadStamp(const std::filesystem::path& path) {
+        FileStamp stamp;
+        stamp.csvFiles = EntryOverrideIndex::ReadSourceStamp();
+
+        WIN32_FILE_ATTRIBUTE_DATA data{};
+        if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &data)) return stamp;
+
+        stamp.writeTime = (static_cast<std::uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+                          data.ftLastWriteTime.dwLowDateTime;
+        stamp.size      = (static_cast<std::uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+        stamp.exists    = true;
+
+        std::uint64_t hash = 14695981039346656037ull;
+        auto mix = [&](std::uint64_t value) {
+            hash ^= value;
+            hash *= 1099511628211ull;
+        };
+        for (const auto& file : ConfigManager::ListDropIns(path.string())) {
+            std::error_code ec;
+            mix(std::hash<std::filesystem::path::string_type>{}(file.filename().native()));
+            mix(static_cast<std::uint64_t>(std::filesystem::file_size(file, ec)));
+            mix(static_cast<std::uint64_t>(std::filesystem::last_write_time(file, ec).time_since_epoch().count()));
+        }
+        stamp.dropIns = hash;
+        return stamp;
+    }
+
+    void ConfigWatcher::Start() {
+        if (running_.load(std::memory_order_acquire)) return;
+
+        std::filesystem::path path(ConfigManager::GetSingleton().GetConfigPath());
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            known_ = ReadStamp(path);
+        }
+
+        running_.store(true, std::memory_order_release);
+        thread_ = std::jthread([this, path](std::stop_token stop) {
+            SetThreadDescription(GetCurrentThread(), L"SWF Config Watcher");
+            Run(stop);
+        });
+
+        logs::info("ConfigWatcher: Watching {} and {} (poll every {} ms)", path.string(),
+            ConfigManager::GetDropInDirectory(path.string()).string(), kPollInterval.count());
+    }
+
+    void ConfigWatcher::Stop() {
+        if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+
+        thread_.request_stop();
+        wake_.notify_all();
+        if (thread_.joinable()) thread_.join();
+
+        logs::info("ConfigWatcher: Stopped");
+    }
+
+    void ConfigWatcher::NoteOwnWrite() {
+        if (!running_.load(std::memory_order_acquire)) return;
+
+        auto stamp = ReadStamp(ConfigManager::GetSingleton().GetConfigPath());
+        std::lock_guard<std::mutex> lock(mutex_);
+        stamp.csvFiles = known_.csvFiles;   // a CSV edit in the meantime is still pending
+        known_ = stamp;
+    }
+
+    void ConfigWatcher::Run(std::stop_token stop) {
+        auto path = std::filesystem::path(ConfigManager::GetSingleton().GetConfigPath());
+        FileStamp candidate;
+        bool hasCandidate = false;
+
+        while (!stop.stop_requested()) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                // Returns early only when a stop is requested.
+                wake_.wait_for(lock, stop, kPollInterval, []() { return false; });
+                if (stop.stop_requested()) break;
+            }
+
+            auto stamp = ReadStamp(path);
+            FileStamp known;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                known = known_;
+            }
+
+            if (stamp == known) {
+                hasCandidate = false;
+                continue;
+            }
+
+            // Editors often save in several writes; wait until the stamp is
+            // the same on two consecutive polls before reading the file.
+            if (!hasCandidate || stamp != candidate) {
+                candidate    = stamp;
+                hasCandidate = true;
+                continue;
+            }
+
+            hasCandidate = false;
+            if (stamp.csvFiles != known.csvFiles) {
+                {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    known_.csvFiles = stamp.csvFiles;
+                }
+                logs::info("ConfigWatcher: Climate CSV files changed, queueing re-import");
+                EntryOverrideIndex::GetSingleton().RequestRefresh();
+            }
+
+            auto ini = stamp;
+            ini.csvFiles = known.csvFiles;
+            if (ini != known && stamp.exists) Reload(path, stamp);
+        }
+    }
+
+    void ConfigWatcher::Reload(const std::filesystem::path& path, const FileStamp& stamp) {
+        auto start = std::chrono::steady_clock::now();
+        PerfStats::GetSingleton().Count(PerfEvent::kConfigReload);
+
+        // Same semantics as Load(): keys missing from every file keep their
+        // current values.
+        auto& configManager = ConfigManager::GetSingleton();
+        auto base   = configManager.GetSnapshot();
+        auto parsed = std::make_shared<Config>(*base);
+        ConfigLayers layers;
+        if (!ConfigManager::ParseLayered(path.string(), *parsed, &layers)) {
+            // Probably still locked by the editor; the stamp is left unknown
+            // so the next polls retry.
+            logs::warn("ConfigWatcher: Could not read {}, will retry", path.string());
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            known_ = stamp;
+        }
+        configManager.SetLayers(std::move(layers));
+
+        auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        logs::info("ConfigWatcher: Re-parsed {} in {:.3f} ms, queueing apply", path.string(), ms);
+
+        Command command{ CommandType::kApplyConfig };
+        command.payload = std::make_unique<CommandPayload>();
+        command.payload->config = std::move(parsed);
+        command.payload->base   = std::move(base);
+        CommandQueue::GetSingleton().Push(std::move(command));
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "pch.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <thread>
+
+namespace SWF {
+
+    // Optional INI hot reload ([General] bHotReload). A background thread
+    // polls the write time and size of the INI and of every *.ini in its
+    // drop-in directory; once a change has held still for one poll interval
+    // the files are re-parsed off the game thread and the result is handed
+    // to the command queue, which diffs it against the live config and
+    // re-applies only what changed. The climate CSV files are polled the
+    // same way; a change there queues a re-import on the worker pool.
+    class ConfigWatcher {
+    public:
+        static ConfigWatcher& GetSingleton() {
+            static ConfigWatcher instance;
+            return instance;
+        }
+
+        static constexpr std::chrono::milliseconds kPollInterval{ 250 };
+
+        void Start();
+
+        // Joins the polling thread. Called from the quit hook, or to follow
+        // the config flag; never from the destructor.
+        void Stop();
+        bool IsRunning() const { return running_.load(std::memory_order_acquire); }
+
+        // Start or stop to match the config flag. Game thread.
+        void Sync(bool enabled) {
+            if (enabled) Start();
+            else Stop();
+        }
+
+        // Called after ConfigManager::Save() so our own write is not read
+        // back as an external edit.
+        void NoteOwnWrite();
+
+    private:
+        ConfigWatcher() = default;
+
+        // Static destruction runs under the loader lock, where joining can
+        // deadlock. The quit hook stops the thread; if it never ran, the
+        // process is exiting, so only ask the thread to stop and let it go.
+        ~ConfigWatcher() {
+            if (!thread_.joinable()) return;
+            thread_.request_stop();
+            wake_.notify_all();
+            thread_.detach();
+        }
+        ConfigWatcher(const ConfigWatcher&) = delete;
+        ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+        struct FileStamp {
+            std::uint64_t writeTime = 0;
+            std::uint64_t size      = 0;
+            std::uint64_t dropIns   = 0;   // drop-in names, sizes and write times
+            std::uint64_t csvFiles  = 0;   // climate CSV names, sizes and write times
+            bool          exists    = false;
+
+            bool operator==(const FileStamp&) const = default;
+        };
+
+        // Stamp of the INI at `path`, its drop-ins and the climate CSVs.
+        static FileStamp ReadStamp(const std::filesystem::path& path);
+
+        void Run(std::stop_token stop);
+        void Reload(const std::filesystem::path& path, const FileStamp& stamp);
+
+        std::jthread                thread_;
+        std::atomic<bool>           running_ = false;
+        std::mutex                  mutex_;
+        std::condition_variable_any wake_;
+        FileStamp                   known_;  // last stamp we applied or wrote ourselves
+    };
+}
@@ -0,0 +1,65 @@
+#include "ConsoleCommands.h"
+#include "CommandQueue.h"
+#include "PresetStore.h"
+
+namespace SWF {
+
+    namespace {
+        // Vanilla debug command with no use in release builds.
+        constexpr std::string_view kTakeoverCommand = "TestSeenData";
+
+        template <class... Args>
+        void Print(std::format_string<Args...> fmt, Args&&... args) {
+            if (auto* console = RE::ConsoleLog::GetSingleton()) {
+                console->Print(std::format(fmt, std::forward<Args>(args)...).c_str());
+            }
+        }
+    }
+
+    void ConsoleCommands::Register() {
+        auto* command = RE::SCRIPT_FUNCTION::LocateConsoleCommand(kTakeoverCommand);
+        if (!command) {
+            logs::warn("ConsoleCommands: '{}' not found, SWFPreset will not be available", kTakeoverCommand);
+            return;
+        }
+
+        static RE::SCRIPT_PARAMETER params[] = {
+            { "Preset", RE::SCRIPT_PARAM_TYPE::kChar, true }
+        };
+
+        command->functionName      = "SWFPreset";
+        command->shortName         = "swfp";
+        command->helpString        = "SWFPreset [name] - list or switch Seasonal Weather presets";
+        command->referenceFunction = false;
+        command->SetParameters(params);
+        command->executeFunction   = &ExecutePreset;
+        command->conditionFunction = nullptr;
+
+        logs::info("ConsoleCommands: Registered SWFPreset (replacing {})", kTakeoverCommand);
+    }
+
+    bool ConsoleCommands::ExecutePreset(const RE::SCRIPT_PARAMETER*, RE::SCRIPT_FUNCTION::ScriptData* scriptData,
+                                        RE::TESObjectREFR*, RE::TESObjectREFR*, RE::Script*, RE::ScriptLocals*,
+                                        double&, std::uint32_t&) {
+        std::string name;
+        if (auto* chunk = scriptData ? scriptData->GetStringChunk() : nullptr) {
+            name = chunk->GetString();
+        }
+
+        if (name.empty()) {
+            auto presets = PresetStore::GetSingleton().GetPresets();
+            if (!presets || presets->empty()) {
+                Print("SWFPreset: no presets in {}", PresetStore::GetSingleton().GetPresetDirectory().string());
+                return true;
+            }
+            for (const auto& preset : *presets) {
+                Print("  {}{}", preset->name, preset->stale ? " (stale: table recomputed on apply)" : "");
+            }
+            return true;
+        }
+
+        Print("SWFPreset: switching to '{}'", name);
+        CommandQueue::GetSingleton().Push(CommandType::kApplyPreset, std::move(name));
+        return true;
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "pch.h"
+
+namespace SWF {
+
+    // "SWFPreset [name]" in the game console: without a name it lists the
+    // loaded presets, with a name it queues a switch to that preset.
+    // Implemented by taking over an unused vanilla debug command.
+    class ConsoleCommands {
+    public:
+        // Call once after kDataLoaded.
+        static void Register();
+
+    private:
+        static bool ExecutePreset(const RE::SCRIPT_PARAMETER* paramInfo, RE::SCRIPT_FUNCTION::ScriptData* scriptData,
+                                  RE::TESObjectREFR* thisObj, RE::TESObjectREFR* containingObj,
+                                  RE::Script* scriptObj, RE::ScriptLocals* locals,
+                                  double& result, std::uint32_t& opcodeOffsetPtr);
+    };
+}
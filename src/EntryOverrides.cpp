@@ -0,0 +1,399 @@
+#include "EntryOverrides.h"
+#include "CommandQueue.h"
+#include "Config.h"
+#include "IniParser.h"
+#include "RegionOverrides.h"
+#include "RegionScanner.h"
+#include "WorkerPool.h"
+
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace SWF {
+
+    namespace {
+        constexpr float kMaxMultiplier = 10.0f;
+        constexpr float kMaxChance     = 100.0f;
+
+        // Files are split at line boundaries into chunks of about this size,
+        // each parsed and resolved by one ParallelFor task.
+        constexpr std::size_t kChunkBytes = 1 << 20;
+
+        constexpr std::size_t kMaxReportedUnresolved = 32;
+
+        constexpr std::uint32_t kNotFound = 0xFFFFFFFF;
+
+        char ToLower(char c) {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+
+        // EditorIDs are case-insensitive in game, and spreadsheets are not
+        // careful about case either.
+        struct CaseInsensitiveHash {
+            std::size_t operator()(std::string_view str) const {
+                std::uint64_t hash = 14695981039346656037ull;
+                for (char c : str) {
+                    hash ^= static_cast<std::uint8_t>(ToLower(c));
+                    hash *= 1099511628211ull;
+                }
+                return static_cast<std::size_t>(hash);
+            }
+        };
+
+        struct CaseInsensitiveEqual {
+            bool operator()(std::string_view a, std::string_view b) const {
+                return a.size() == b.size() &&
+                       std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) { return ToLower(x) == ToLower(y); });
+            }
+        };
+
+        using NameIndex = std::unordered_map<std::string_view, std::uint32_t, CaseInsensitiveHash, CaseInsensitiveEqual>;
+
+        enum class Unresolved : std::uint8_t { kRegion, kWeather, kNotInRegion, kMalformed, kTotal };
+
+        const char* UnresolvedToString(Unresolved reason) {
+            switch (reason) {
+                case Unresolved::kRegion:      return "unknown region";
+                case Unresolved::kWeather:     return "unknown weather";
+                case Unresolved::kNotInRegion: return "weather not in region";
+                default:                       return "malformed row";
+            }
+        }
+
+        // Read-only lookup state shared by every parse task. Name keys view
+        // the scanner's strings (or weatherNames), never the CSV text.
+        struct Resolver {
+            const std::vector<RegionWeatherInfo>& regionInfos;
+            std::vector<std::uint32_t>            regionFirst;   // first entry of each region
+            NameIndex                             regionsByName;
+            std::vector<std::string>              weatherNames;
+            NameIndex                             weathersByName;
+            RE::TESDataHandler*                   dataHandler = nullptr;
+
+            explicit Resolver(const std::vector<RegionWeatherInfo>& infos) : regionInfos(infos) {
+                auto& scanner = RegionScanner::GetSingleton();
+                dataHandler = RE::TESDataHandler::GetSingleton();
+
+                regionFirst.reserve(infos.size());
+                regionsByName.reserve(infos.size());
+                std::uint32_t first = 0;
+                for (std::uint32_t r = 0; r < infos.size(); ++r) {
+                    regionFirst.push_back(first);
+                    first += static_cast<std::uint32_t>(infos[r].originalWeatherEntries.size());
+                    regionsByName.try_emplace(infos[r].editorID, r);
+                }
+
+                const auto& weathers = scanner.GetUniqueWeathers();
+                weatherNames.reserve(weathers.size());
+                for (auto* weather : weathers) weatherNames.push_back(RegionScanner::GetWeatherName(weather));
+                weathersByName.reserve(weathers.size());
+                for (std::uint32_t w = 0; w < weatherNames.size(); ++w) weathersByName.try_emplace(weatherNames[w], w);
+            }
+
+            // "Plugin.esp|0xLocalID" -> plugin + local FormID.
+            static bool SplitFormKey(std::string_view key, std::string_view& plugin, RE::FormID& localID) {
+                auto bar = key.find('|');
+                if (bar == std::string_view::npos) return false;
+                plugin = TrimView(key.substr(0, bar));
+                auto id = TrimView(key.substr(bar + 1));
+                if (id.starts_with("0x") || id.starts_with("0X")) id.remove_prefix(2);
+                auto [ptr, ec] = std::from_chars(id.data(), id.data() + id.size(), localID, 16);
+                return !plugin.empty() && ec == std::errc{} && ptr == id.data() + id.size();
+            }
+
+            std::uint32_t FindRegion(std::string_view key) const {
+                std::string_view plugin;
+                RE::FormID localID = 0;
+                if (SplitFormKey(key, plugin, localID)) {
+                    auto* region = dataHandler ? dataHandler->LookupForm<RE::TESRegion>(localID, plugin) : nullptr;
+                    auto index = region ? RegionScanner::GetSingleton().GetRegionIndex(region->GetFormID())
+                                        : kNoRegionIndex;
+                    return index != kNoRegionIndex ? index : kNotFound;
+                }
+                auto it = regionsByName.find(key);
+                return it != regionsByName.end() ? it->second : kNotFound;
+            }
+
+            std::uint32_t FindWeather(std::string_view key) const {
+                std::string_view plugin;
+                RE::FormID localID = 0;
+                if (SplitFormKey(key, plugin, localID)) {
+                    auto* weather = dataHandler ? dataHandler->LookupForm<RE::TESWeather>(localID, plugin) : nullptr;
+                    return weather ? RegionScanner::GetSingleton().GetWeatherIndex(weather->GetFormID()) : kNoWeatherIndex;
+                }
+                auto it = weathersByName.find(key);
+                return it != weathersByName.end() ? it->second : kNoWeatherIndex;
+            }
+
+            // Entry of `weather` in `region`, numbered like ChanceTable.
+            std::uint32_t FindEntry(std::uint32_t region, std::uint32_t weather) const {
+                const auto& entries = regionInfos[region].originalWeatherEntries;
+                for (std::uint32_t i = 0; i < entries.size(); ++i) {
+                    if (entries[i].weatherIndex == weather) return regionFirst[region] + i;
+                }
+                return kNotFound;
+            }
+        };
+
+        struct ResolvedRow {
+            std::uint32_t entry      = 0;
+            std::uint8_t  seasonMask = 0;
+            bool          absolute   = false;
+            float         value      = 0.0f;
+        };
+
+        struct UnresolvedRow {
+            Unresolved       reason = Unresolved::kMalformed;
+            std::uint32_t    line   = 0;    // within the chunk until merged
+            std::string_view name;          // views the mapped CSV
+        };
+
+        struct CsvChunk {
+            std::size_t                file  = 0;
+            std::string_view           text;
+            bool                       first = false;  // may start with a header row
+            std::uint32_t              lines = 0;
+            std::size_t                rows  = 0;
+            std::vector<ResolvedRow>   resolved;
+            std::vector<UnresolvedRow> unresolved;
+        };
+
+        void ParseChunk(const Resolver& resolver, CsvChunk& chunk) {
+            chunk.lines = static_cast<std::uint32_t>(std::ranges::count(chunk.text, '\n'));
+            bool headerAllowed = chunk.first;
+
+            TokenizeCsv<5>(chunk.text, [&](std::span<const std::string_view> fields, std::uint32_t line) {
+                bool maybeHeader = std::exchange(headerAllowed, false);
+
+                float value = 0.0f;
+                if (fields.size() < 5 || !ParseIniFloat(fields[4], value)) {
+                    if (!maybeHeader) chunk.unresolved.push_back({ Unresolved::kMalformed, line, {} });
+                    return;
+                }
+                ++chunk.rows;
+
+                auto seasons = ParseSeasonMask(fields[2]);
+                bool absolute = CaseInsensitiveEqual{}(fields[3], "chance");
+                if (seasons == 0 || (!absolute && !CaseInsensitiveEqual{}(fields[3], "mult"))) {
+                    chunk.unresolved.push_back({ Unresolved::kMalformed, line, {} });
+                    return;
+                }
+
+                auto region = resolver.FindRegion(fields[0]);
+                if (region == kNotFound) {
+                    chunk.unresolved.push_back({ Unresolved::kRegion, line, fields[0] });
+                    return;
+                }
+                auto weather = resolver.FindWeather(fields[1]);
+                if (weather == kNoWeatherIndex) {
+                    chunk.unresolved.push_back({ Unresolved::kWeather, line, fields[1] });
+                    return;
+                }
+                auto entry = resolver.FindEntry(region, weather);
+                if (entry == kNotFound) {
+                    chunk.unresolved.push_back({ Unresolved::kNotInRegion, line, fields[1] });
+                    return;
+                }
+
+                value = std::clamp(value, 0.0f, absolute ? kMaxChance : kMaxMultiplier);
+                chunk.resolved.push_back({ entry, static_cast<std::uint8_t>(seasons), absolute, value });
+            });
+        }
+
+        // Splits `text` into pieces of roughly kChunkBytes ending on a newline.
+        void SplitIntoChunks(std::size_t file, std::string_view text, std::vector<CsvChunk>& out) {
+            bool first = true;
+            while (!text.empty()) {
+                auto end = std::min(kChunkBytes, text.size());
+                if (end < text.size()) {
+                    auto eol = text.find('\n', end);
+                    end = eol == std::string_view::npos ? text.size() : eol + 1;
+                }
+                CsvChunk chunk;
+                chunk.file  = file;
+                chunk.text  = text.substr(0, end);
+                chunk.first = std::exchange(first, false);
+                out.push_back(std::move(chunk));
+                text.remove_prefix(end);
+            }
+        }
+
+        std::vector<std::filesystem::path> ListCsvFiles(const std::filesystem::path& dir) {
+            std::vector<std::filesystem::path> files;
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+                if (!entry.is_regular_file(ec)) continue;
+                auto ext = entry.path().extension().string();
+                std::ranges::transform(ext, ext.begin(), [](char c) { return ToLower(c); });
+                if (ext == ".csv") files.push_back(entry.path());
+            }
+            std::ranges::sort(files, [](const auto& a, const auto& b) {
+                return a.filename().native() < b.filename().native();
+            });
+            return files;
+        }
+
+        std::uint64_t StampFiles(const std::vector<std::filesystem::path>& files) {
+            std::uint64_t hash = 14695981039346656037ull;
+            auto mix = [&](std::uint64_t value) {
+                hash ^= value;
+                hash *= 1099511628211ull;
+            };
+            for (const auto& file : files) {
+                std::error_code ec;
+                mix(std::hash<std::filesystem::path::string_type>{}(file.filename().native()));
+                mix(static_cast<std::uint64_t>(std::filesystem::file_size(file, ec)));
+                mix(static_cast<std::uint64_t>(std::filesystem::last_write_time(file, ec).time_since_epoch().count()));
+            }
+            return hash;
+        }
+    }
+
+    std::filesystem::path EntryOverrideIndex::GetCsvDirectory() {
+        return ConfigManager::GetDropInDirectory(ConfigManager::GetSingleton().GetConfigPath());
+    }
+
+    std::uint64_t EntryOverrideIndex::ReadSourceStamp() {
+        return StampFiles(ListCsvFiles(GetCsvDirectory()));
+    }
+
+    std::shared_ptr<CompiledEntryOverrides> EntryOverrideIndex::Import(
+        const std::vector<std::filesystem::path>& files,
+        const std::vector<RegionWeatherInfo>& regionInfos,
+        std::uint64_t scanGeneration,
+        std::uint64_t sourceStamp)
+    {
+        auto compiled = std::make_shared<CompiledEntryOverrides>();
+        compiled->scanGeneration = scanGeneration;
+        compiled->sourceStamp    = sourceStamp;
+        if (files.empty()) return compiled;
+
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<MappedFile> mapped;
+        std::vector<CsvChunk> chunks;
+        std::size_t totalBytes = 0;
+        for (const auto& path : files) {
+            auto& file = mapped.emplace_back(path);
+            if (!file.IsOpen()) {
+                logs::warn("EntryOverrides: could not open {}, skipped", path.filename().string());
+                continue;
+            }
+            totalBytes += file.GetView().size();
+            SplitIntoChunks(mapped.size() - 1, file.GetView(), chunks);
+        }
+
+        Resolver resolver(regionInfos);
+        auto indexed = std::chrono::steady_clock::now();
+
+        WorkerPool::GetSingleton().ParallelFor(TaskPriority::kHigh, "Import climate CSV", chunks.size(),
+            [&](std::size_t i) { ParseChunk(resolver, chunks[i]); });
+
+        auto parsed = std::chrono::steady_clock::now();
+
+        // Merge in file and row order so later rows win.
+        std::size_t totalEntries = resolver.regionFirst.empty() ? 0 :
+            resolver.regionFirst.back() + regionInfos.back().originalWeatherEntries.size();
+        std::size_t rows = 0, unresolved = 0;
+        std::array<std::size_t, static_cast<std::size_t>(Unresolved::kTotal)> unresolvedByReason{};
+        std::unordered_set<std::string_view, CaseInsensitiveHash, CaseInsensitiveEqual> reported;
+        std::size_t logged = 0;
+        std::size_t lineBase = 0, currentFile = SIZE_MAX;
+
+        for (auto& chunk : chunks) {
+            if (chunk.file != currentFile) {
+                currentFile = chunk.file;
+                lineBase = 0;
+            }
+
+            rows += chunk.rows;
+            for (const auto& row : chunk.resolved) {
+                for (std::size_t s = 0; s < compiled->seasons.size(); ++s) {
+                    if (!(row.seasonMask & (1u << s))) continue;
+                    auto& values = compiled->seasons[s];
+                    if (values.empty()) values.resize(totalEntries);
+                    auto& value = values[row.entry];
+                    if (row.absolute) {
+                        value.chance = row.value;
+                    } else {
+                        value.multiplier = row.value;
+                        value.chance = EntryOverride::kUnset;
+                    }
+                }
+            }
+            compiled->rowsApplied += chunk.resolved.size();
+
+            for (const auto& row : chunk.unresolved) {
+                ++unresolved;
+                ++unresolvedByReason[static_cast<std::size_t>(row.reason)];
+                // Each unknown name once, up to a cap; the summary below has the totals.
+                bool distinct = row.reason == Unresolved::kMalformed || reported.insert(row.name).second;
+                if (distinct && logged < kMaxReportedUnresolved) {
+                    ++logged;
+                    logs::warn("EntryOverrides: {}:{}: {}{}{}", files[chunk.file].filename().string(),
+                        lineBase + row.line, UnresolvedToString(row.reason), row.name.empty() ? "" : " ", row.name);
+                }
+            }
+            lineBase += chunk.lines;
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        auto ms = [](auto a, auto b) { return std::chrono::duration<double, std::milli>(b - a).count(); };
+        auto parseSeconds = std::max(std::chrono::duration<double>(parsed - indexed).count(), 1e-9);
+
+        if (unresolved > 0) {
+            logs::warn("EntryOverrides: {} rows not applied ({} unknown region, {} unknown weather, "
+                "{} weather not in region, {} malformed)", unresolved,
+                unresolvedByReason[static_cast<std::size_t>(Unresolved::kRegion)],
+                unresolvedByReason[static_cast<std::size_t>(Unresolved::kWeather)],
+                unresolvedByReason[static_cast<std::size_t>(Unresolved::kNotInRegion)],
+                unresolvedByReason[static_cast<std::size_t>(Unresolved::kMalformed)]);
+        }
+        logs::info("EntryOverrides: Imported {} rows ({} applied) from {} CSV files, {:.2f} MB in {:.3f} ms "
+            "(lookup maps {:.3f} ms, parse+resolve {:.3f} ms in {} chunks = {:.1f} MB/s, {:.0f} rows/s; merge {:.3f} ms)",
+            rows, compiled->rowsApplied, files.size(), totalBytes / 1048576.0, ms(start, end),
+            ms(start, indexed), ms(indexed, parsed), chunks.size(),
+            totalBytes / 1048576.0 / parseSeconds, rows / parseSeconds, ms(parsed, end));
+
+        return compiled;
+    }
+
+    std::shared_ptr<const CompiledEntryOverrides> EntryOverrideIndex::Refresh(const RegionScanSnapshot& scan) {
+        std::lock_guard<std::mutex> lock(importMutex_);
+
+        auto files = ListCsvFiles(GetCsvDirectory());
+        auto stamp = StampFiles(files);
+
+        auto current = compiled_.load(std::memory_order_acquire);
+        if (current && current->scanGeneration == scan.generation && current->sourceStamp == stamp) {
+            return current;
+        }
+
+        auto compiled = Import(files, scan.infos, scan.generation, stamp);
+        compiled->importId = ++lastImportId_;
+        compiled_.store(compiled, std::memory_order_release);
+        return compiled;
+    }
+
+    void EntryOverrideIndex::RequestRefresh() {
+        if (refreshQueued_.exchange(true, std::memory_order_acq_rel)) return;
+
+        auto refresh = [this]() {
+            // Cleared first, so a request made while this runs queues another.
+            refreshQueued_.store(false, std::memory_order_release);
+            auto scan = RegionScanner::GetSingleton().GetSnapshot();
+            if (!scan) return;
+
+            auto before = compiled_.load(std::memory_order_acquire);
+            if (Refresh(*scan) != before) {
+                CommandQueue::GetSingleton().Push(CommandType::kRefresh);
+            }
+        };
+        if (!WorkerPool::GetSingleton().Submit(TaskPriority::kNormal, "Import climate CSV", refresh)) {
+            // Without the pool there is no thread to import on; the next
+            // request retries.
+            refreshQueued_.store(false, std::memory_order_release);
+        }
+    }
+}
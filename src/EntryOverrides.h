@@ -0,0 +1,103 @@
+#pragma once
+
+#include "pch.h"
+#include "Season.h"
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace SWF {
+
+    struct RegionWeatherInfo;
+    struct RegionScanSnapshot;
+
+    // Value for one (region entry, season), imported from a climate CSV.
+    // The most specific override: it wins over weather and region rules.
+    struct EntryOverride {
+        static constexpr float kUnset = -1.0f;
+
+        float multiplier = kUnset;  // replaces the class multiplier
+        float chance     = kUnset;  // absolute weight; wins over `multiplier`
+
+        bool IsSet() const { return multiplier >= 0.0f || chance >= 0.0f; }
+    };
+
+    // Climate CSV rows resolved to region entry positions. Entries are
+    // numbered like ChanceTable (regions in scan order, each region's
+    // entries contiguous), so a table build indexes them directly.
+    //
+    // CSV files are every *.csv in the drop-in directory, imported in file
+    // name order (later rows win). Columns:
+    //   region, weather, season, kind, value
+    // region/weather: EditorID or Plugin.esp|0xLocalID; season: name or *;
+    // kind: "mult" (0-10) or "chance" (0-100). A first row whose value
+    // column is not a number is taken as a header.
+    struct CompiledEntryOverrides {
+        // Per season, one slot per region entry; empty if no row set that season.
+        std::array<std::vector<EntryOverride>, static_cast<std::size_t>(Season::kTotal)> seasons;
+
+        std::uint64_t scanGeneration = 0;
+        std::uint64_t sourceStamp    = 0;   // CSV names, sizes and write times
+        std::uint64_t importId       = 0;   // distinct per import, so tables can tell which one they used
+        std::size_t   rowsApplied    = 0;
+
+        const EntryOverride* Find(Season season, std::size_t entry) const {
+            const auto& values = seasons[static_cast<std::size_t>(season)];
+            if (entry >= values.size() || !values[entry].IsSet()) return nullptr;
+            return &values[entry];
+        }
+    };
+
+    class EntryOverrideIndex {
+    public:
+        static EntryOverrideIndex& GetSingleton() {
+            static EntryOverrideIndex instance;
+            return instance;
+        }
+
+        // Re-imports the CSV files if `scan` or any CSV file changed since
+        // the last import; otherwise returns the cached result. Lists, stats
+        // and parses files, so never on the game thread: startup calls it
+        // directly, everything else through RequestRefresh(). Parsing and
+        // resolving run in parallel on the worker pool.
+        std::shared_ptr<const CompiledEntryOverrides> Refresh(const RegionScanSnapshot& scan);
+
+        // Queues Refresh() of the latest scan snapshot on the worker pool;
+        // if the import changed, asks the command queue to re-apply, which
+        // rebuilds the chance table with it. Requests made while one is
+        // queued merge. Any thread.
+        void RequestRefresh();
+
+        // The last import if it was made against `scanGeneration`, else
+        // null. No I/O; this is all the game thread calls.
+        std::shared_ptr<const CompiledEntryOverrides> Get(std::uint64_t scanGeneration) const {
+            auto compiled = compiled_.load(std::memory_order_acquire);
+            return compiled && compiled->scanGeneration == scanGeneration ? compiled : nullptr;
+        }
+
+        static std::filesystem::path GetCsvDirectory();
+
+        // Names, sizes and write times of the CSV files, folded into one value.
+        static std::uint64_t ReadSourceStamp();
+
+    private:
+        EntryOverrideIndex() = default;
+        ~EntryOverrideIndex() = default;
+        EntryOverrideIndex(const EntryOverrideIndex&) = delete;
+        EntryOverrideIndex& operator=(const EntryOverrideIndex&) = delete;
+
+        static std::shared_ptr<CompiledEntryOverrides> Import(
+            const std::vector<std::filesystem::path>& files,
+            const std::vector<RegionWeatherInfo>& regionInfos,
+            std::uint64_t scanGeneration,
+            std::uint64_t sourceStamp);
+
+        std::atomic<std::shared_ptr<const CompiledEntryOverrides>> compiled_;
+        std::mutex                                                 importMutex_;
+        std::uint64_t                                              lastImportId_  = 0;   // importMutex_
+        std::atomic<bool>                                          refreshQueued_ = false;
+    };
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "pch.h"
+
+#include <bit>
+#include <vector>
+
+namespace SWF {
+
+    // Open-addressing FormID -> Value table: one flat array, linear probing,
+    // load factor <= 1/2. FormID 0 (no form) marks an empty slot and cannot
+    // be stored. Built once and then only read, so there is no erase.
+    template <class Value>
+    class FlatFormMap {
+    public:
+        FlatFormMap() = default;
+        explicit FlatFormMap(std::size_t expected) { Reserve(expected); }
+
+        void Reserve(std::size_t expected) {
+            auto capacity = std::bit_ceil(std::max<std::size_t>(expected * 2, 16));
+            if (capacity <= slots_.size()) return;
+
+            auto old = std::move(slots_);
+            slots_.assign(capacity, Slot{});
+            shift_ = 64 - std::countr_zero(capacity);
+            size_  = 0;
+            for (const auto& slot : old) {
+                if (slot.key != 0) Insert(slot.key, slot.value);
+            }
+        }
+
+        // Inserts or overwrites. Returns false only for FormID 0.
+        bool Insert(RE::FormID key, const Value& value) {
+            if (key == 0) return false;
+            if ((size_ + 1) * 2 > slots_.size()) Reserve(size_ + 1);
+
+            for (auto i = Home(key);; i = (i + 1) & (slots_.size() - 1)) {
+                auto& slot = slots_[i];
+                if (slot.key == key) {
+                    slot.value = value;
+                    return true;
+                }
+                if (slot.key == 0) {
+                    slot = { key, value };
+                    ++size_;
+                    return true;
+                }
+            }
+        }
+
+        const Value* Find(RE::FormID key) const {
+            if (key == 0 || slots_.empty()) return nullptr;
+            for (auto i = Home(key);; i = (i + 1) & (slots_.size() - 1)) {
+                const auto& slot = slots_[i];
+                if (slot.key == key) return &slot.value;
+                if (slot.key == 0) return nullptr;
+            }
+        }
+
+        bool Contains(RE::FormID key) const { return Find(key) != nullptr; }
+
+        std::size_t Size() const { return size_; }
+        bool Empty() const { return size_ == 0; }
+
+        void Clear() {
+            slots_.clear();
+            size_ = 0;
+        }
+
+    private:
+        struct Slot {
+            RE::FormID key = 0;
+            Value      value{};
+        };
+
+        // Fibonacci hashing: FormIDs share their high (plugin index) byte,
+        // so the low bits alone would cluster.
+        std::size_t Home(RE::FormID key) const {
+            return static_cast<std::size_t>((static_cast<std::uint64_t>(key) * 0x9E3779B97F4A7C15ull) >> shift_);
+        }
+
+        std::vector<Slot> slots_;
+        std::size_t       size_  = 0;
+        int               shift_ = 64;
+    };
+}
@@ -0,0 +1,85 @@
+#include "IniParser.h"
+
+namespace SWF {
+
+    MappedFile::MappedFile(const std::filesystem::path& path) {
+        file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return;
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file_, &size)) {
+            Close();
+            return;
+        }
+
+        // Mapping a zero-length file fails; an open file with an empty view is fine.
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        if (size_ == 0) return;
+
+        mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) {
+            Close();
+            return;
+        }
+
+        data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (!data_) {
+            Close();
+        }
+    }
+
+    MappedFile::~MappedFile() {
+        Close();
+    }
+
+    MappedFile::MappedFile(MappedFile&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+        if (this != &other) {
+            Close();
+            file_    = std::exchange(other.file_, INVALID_HANDLE_VALUE);
+            mapping_ = std::exchange(other.mapping_, nullptr);
+            data_    = std::exchange(other.data_, nullptr);
+            size_    = std::exchange(other.size_, 0);
+        }
+        return *this;
+    }
+
+    bool WriteFileAtomic(const std::filesystem::path& path, std::string_view bytes) {
+        auto tempPath = path;
+        tempPath += L".tmp";
+
+        HANDLE file = CreateFileW(tempPath.c_str(), GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS,
+                                  FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            logs::error("Failed to create {} (error {})", tempPath.string(), GetLastError());
+            return false;
+        }
+
+        DWORD written = 0;
+        bool ok = WriteFile(file, bytes.data(), static_cast<DWORD>(bytes.size()), &written, nullptr) &&
+                  written == bytes.size() &&
+                  FlushFileBuffers(file);
+        CloseHandle(file);
+
+        if (!ok || !MoveFileExW(tempPath.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+            logs::error("Failed to write {} (error {})", path.string(), GetLastError());
+            DeleteFileW(tempPath.c_str());
+            return false;
+        }
+        return true;
+    }
+
+    void MappedFile::Close() {
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+        data_    = nullptr;
+        mapping_ = nullptr;
+        file_    = INVALID_HANDLE_VALUE;
+        size_    = 0;
+    }
+}
@@ -0,0 +1,255 @@
+#pragma once
+
+#include "pch.h"
+
+#include <array>
+#include <charconv>
+#include <span>
+#include <string_view>
+
+namespace SWF {
+
+    // Read-only memory mapping of a whole file. The view stays valid for the
+    // lifetime of the object; an empty or missing file yields an empty view.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::filesystem::path& path);
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool IsOpen() const { return file_ != INVALID_HANDLE_VALUE; }
+        std::string_view GetView() const { return { data_, size_ }; }
+
+    private:
+        void Close();
+
+        HANDLE      file_    = INVALID_HANDLE_VALUE;
+        HANDLE      mapping_ = nullptr;
+        const char* data_    = nullptr;
+        std::size_t size_    = 0;
+    };
+
+    // Replace `path` with `bytes` without ever leaving a partial file:
+    // write <path>.tmp, flush it to disk, then rename it over `path`.
+    // Returns false (and removes the temp file) on any failure.
+    bool WriteFileAtomic(const std::filesystem::path& path, std::string_view bytes);
+
+    // One "key = value" line. All views point into the source text.
+    struct IniEntry {
+        std::string_view section;
+        std::string_view key;
+        std::string_view value;
+        std::uint32_t    line = 0;
+    };
+
+    constexpr std::string_view TrimView(std::string_view str) {
+        constexpr std::string_view kWhitespace = " \t\r\n";
+        auto start = str.find_first_not_of(kWhitespace);
+        if (start == std::string_view::npos) return {};
+        auto end = str.find_last_not_of(kWhitespace);
+        return str.substr(start, end - start + 1);
+    }
+
+    // Tokenizes INI text in place: '#' and ';' start comment lines,
+    // [Section] headers, key = value pairs. Calls onEntry(const IniEntry&)
+    // for every pair and onSection(std::string_view, line) for every header.
+    // Lines that are neither are reported through onEntry with an empty key.
+    template <class EntryFn, class SectionFn>
+    void TokenizeIni(std::string_view text, EntryFn&& onEntry, SectionFn&& onSection) {
+        std::string_view section;
+        std::uint32_t lineNumber = 0;
+
+        // Skip a UTF-8 BOM written by some editors.
+        if (text.starts_with("\xEF\xBB\xBF")) text.remove_prefix(3);
+
+        while (!text.empty()) {
+            ++lineNumber;
+            auto eol = text.find('\n');
+            auto line = TrimView(text.substr(0, eol));
+            text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+
+            if (line.empty() || line.front() == '#' || line.front() == ';') continue;
+
+            if (line.front() == '[') {
+                auto end = line.find(']');
+                if (end != std::string_view::npos) {
+                    section = TrimView(line.substr(1, end - 1));
+                    onSection(section, lineNumber);
+                }
+                continue;
+            }
+
+            auto eq = line.find('=');
+            if (eq == std::string_view::npos) {
+                onEntry(IniEntry{ section, {}, line, lineNumber });
+                continue;
+            }
+            onEntry(IniEntry{ section, TrimView(line.substr(0, eq)), TrimView(line.substr(eq + 1)), lineNumber });
+        }
+    }
+
+    // Splits CSV text into rows and calls onRow(std::span<const std::string_view>,
+    // line) for every row that is neither blank nor a '#' comment. Fields
+    // view the source text: whitespace around them is trimmed and one
+    // pair of enclosing double quotes removed (commas inside quotes are
+    // kept; "" is not unescaped and quoted fields cannot span lines).
+    // Fields past MaxFields are dropped. Line numbers start at 1 within `text`.
+    template <std::size_t MaxFields, class RowFn>
+    void TokenizeCsv(std::string_view text, RowFn&& onRow) {
+        std::array<std::string_view, MaxFields> fields;
+        std::uint32_t lineNumber = 0;
+
+        if (text.starts_with("\xEF\xBB\xBF")) text.remove_prefix(3);
+
+        while (!text.empty()) {
+            ++lineNumber;
+            auto eol = text.find('\n');
+            auto row = text.substr(0, eol);
+            text.remove_prefix(eol == std::string_view::npos ? text.size() : eol + 1);
+
+            auto trimmed = TrimView(row);
+            if (trimmed.empty() || trimmed.front() == '#') continue;
+
+            std::size_t count = 0;
+            for (;;) {
+                std::string_view field;
+                auto start = row.find_first_not_of(" \t");
+                row.remove_prefix(start == std::string_view::npos ? row.size() : start);
+
+                std::size_t comma;
+                if (!row.empty() && row.front() == '"') {
+                    auto close = row.find('"', 1);
+                    field = row.substr(1, close == std::string_view::npos ? std::string_view::npos : close - 1);
+                    comma = row.find(',', close == std::string_view::npos ? row.size() : close + 1);
+                } else {
+                    comma = row.find(',');
+                    field = TrimView(row.substr(0, comma));
+                }
+
+                if (count < MaxFields) fields[count++] = field;
+                if (comma == std::string_view::npos) break;
+                row.remove_prefix(comma + 1);
+            }
+
+            onRow(std::span<const std::string_view>(fields.data(), count), lineNumber);
+        }
+    }
+
+    // A scalar value without a trailing "; comment" or "# comment" and the
+    // whitespace around it. The std::stof-based parser this replaced read
+    // "fMult = 1.0 ; default" as 1.0, so existing INIs rely on it.
+    constexpr std::string_view StripIniComment(std::string_view str) {
+        auto comment = str.find_first_of(";#");
+        return TrimView(comment == std::string_view::npos ? str : str.substr(0, comment));
+    }
+
+    // from_chars rejects a leading '+'; accept one (but not "+-1").
+    constexpr std::string_view StripIniPlus(std::string_view str) {
+        if (str.size() > 1 && str.front() == '+' && str[1] != '-' && str[1] != '+') str.remove_prefix(1);
+        return str;
+    }
+
+    // Non-throwing value parsers. On failure they return false and leave
+    // the output untouched, so the caller keeps its current/default value.
+    inline bool ParseIniFloat(std::string_view str, float& out) {
+        str = StripIniPlus(StripIniComment(str));
+        float value = 0.0f;
+        auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+        if (ec != std::errc{} || ptr != str.data() + str.size()) return false;
+        out = value;
+        return true;
+    }
+
+    inline bool ParseIniUInt(std::string_view str, std::uint32_t& out) {
+        str = StripIniPlus(StripIniComment(str));
+        std::uint32_t value = 0;
+        auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value);
+        if (ec != std::errc{} || ptr != str.data() + str.size()) return false;
+        out = value;
+        return true;
+    }
+
+    inline bool ParseIniBool(std::string_view str, bool& out) {
+        str = StripIniComment(str);
+        if (str == "true" || str == "1" || str == "yes") { out = true; return true; }
+        if (str == "false" || str == "0" || str == "no") { out = false; return true; }
+        return false;
+    }
+
+    // Calls fn(std::string_view) for each trimmed, non-empty comma-separated token.
+    template <class Fn>
+    void ForEachCSVToken(std::string_view str, Fn&& fn) {
+        while (!str.empty()) {
+            auto comma = str.find(',');
+            auto token = TrimView(str.substr(0, comma));
+            if (!token.empty()) fn(token);
+            if (comma == std::string_view::npos) break;
+            str.remove_prefix(comma + 1);
+        }
+    }
+
+    // FNV-1a over "section\x1Fkey", seeded so a collision-free seed can be
+    // searched for at compile time.
+    constexpr std::uint32_t HashIniKey(std::uint32_t seed, std::string_view section, std::string_view key) {
+        std::uint32_t hash = 2166136261u ^ seed;
+        for (char c : section) {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 16777619u;
+        }
+        hash ^= 0x1Fu;
+        hash *= 16777619u;
+        for (char c : key) {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // Compile-time perfect hash over a fixed set of (section, key) pairs.
+    // Bindings is a std::array of structs with .section and .key members.
+    // Find() returns the binding index or -1 for an unknown pair.
+    template <std::size_t TableSize, class Bindings>
+    class IniKeyTable {
+        static_assert((TableSize & (TableSize - 1)) == 0, "table size must be a power of two");
+
+    public:
+        constexpr explicit IniKeyTable(const Bindings& bindings) {
+            for (std::uint32_t seed = 0; seed < 4096; ++seed) {
+                if (TryBuild(bindings, seed)) {
+                    seed_  = seed;
+                    valid_ = true;
+                    return;
+                }
+            }
+        }
+
+        constexpr bool IsValid() const { return valid_; }
+
+        constexpr int Find(const Bindings& bindings, std::string_view section, std::string_view key) const {
+            auto slot = slots_[HashIniKey(seed_, section, key) & (TableSize - 1)];
+            if (slot == 0) return -1;
+            const auto& b = bindings[slot - 1];
+            return (b.section == section && b.key == key) ? static_cast<int>(slot - 1) : -1;
+        }
+
+    private:
+        constexpr bool TryBuild(const Bindings& bindings, std::uint32_t seed) {
+            for (auto& s : slots_) s = 0;
+            for (std::size_t i = 0; i < bindings.size(); ++i) {
+                auto& slot = slots_[HashIniKey(seed, bindings[i].section, bindings[i].key) & (TableSize - 1)];
+                if (slot != 0) return false;
+                slot = static_cast<std::uint16_t>(i + 1);
+            }
+            return true;
+        }
+
+        std::array<std::uint16_t, TableSize> slots_{};
+        std::uint32_t seed_  = 0;
+        bool          valid_ = false;
+    };
+}
@@ -1,13 +1,71 @@
 #include "MenuUI.h"
 #include "Config.h"
+#include "ConfigHistory.h"
+#include "ConfigSchema.h"
+#include "MonthCurves.h"
+#include "PerfStats.h"
 #include "Season.h"
+#include "SeasonCalendar.h"
 #include "WeatherManager.h"
 #include "RegionScanner.h"
+#include "RegionSearch.h"
+#include "CommandQueue.h"
+#include "RegionTracker.h"
+#include "PresetStore.h"
+#include "WorkerPool.h"
 
 #include <SKSEMenuFramework.h>
 
+#include <chrono>
+
 namespace SWF {
 
+    namespace {
+        // Live preview of multiplier drags; menu session state, not saved.
+        // The render callback only queues; patching and applying run on a
+        // worker and a game-thread task, at most once per interval.
+        struct LivePreview {
+            static constexpr std::chrono::milliseconds kInterval{ 100 };
+
+            bool                                  enabled      = false;
+            bool                                  forceWeather = false;
+            std::int64_t                          pendingField = -1;   // edited since the last preview request
+            std::chrono::steady_clock::time_point lastRequest;
+        };
+        LivePreview livePreview;
+
+        // Live sky weathers are looked up in the view; only weathers that
+        // were never scanned (quest or scripted ones) are named on the spot.
+        void WeatherLine(const MenuView* view, const char* label, RE::TESWeather* weather, bool withClass) {
+            if (const auto* cached = view ? view->FindWeather(weather) : nullptr) {
+                if (withClass)
+                    ImGuiMCP::Text("%s: %s (%s)", label, cached->name.c_str(), cached->classLabel);
+                else
+                    ImGuiMCP::Text("%s: %s", label, cached->name.c_str());
+                return;
+            }
+
+            auto name = RegionScanner::GetWeatherName(weather);
+            if (withClass) {
+                ImGuiMCP::Text("%s: %s (%s)", label, name.c_str(),
+                    WeatherClassToString(RegionScanner::ClassifyWeather(weather)));
+            } else {
+                ImGuiMCP::Text("%s: %s", label, name.c_str());
+            }
+        }
+
+        void FacetCombo(const char* label, const std::vector<std::string>& labels, std::int32_t& index) {
+            const char* preview = index >= 0 ? labels[index].c_str() : "Any";
+            if (ImGuiMCP::BeginCombo(label, preview)) {
+                if (ImGuiMCP::Selectable("Any", index < 0)) index = -1;
+                for (int i = 0; i < static_cast<int>(labels.size()); ++i) {
+                    if (ImGuiMCP::Selectable(labels[i].c_str(), index == i)) index = i;
+                }
+                ImGuiMCP::EndCombo();
+            }
+        }
+    }
+
     void MenuUI::Register() {
         if (registered_) return;
 
@@ -36,7 +94,11 @@ namespace SWF {
     }
 
     void __stdcall MenuUI::RenderStatus() {
+        PerfScope perf(PerfTimer::kMenuRender);
         auto& wm = WeatherManager::GetSingleton();
+        auto& viewModel = MenuViewModel::GetSingleton();
+        viewModel.Refresh();
+        auto view = viewModel.Get();
 
         ImGuiMCP::SeparatorText("Current Status");
 
@@ -56,6 +118,20 @@ namespace SWF {
         auto month = GetCurrentMonth();
         ImGuiMCP::Text("Current Month: %s (index %d)", MonthToString(month), month);
 
+        auto snapshot = ConfigManager::GetSingleton().GetSnapshot();
+        const auto& config = *snapshot;
+        if (config.useDayCalendar && !config.useMonthCurves) {
+            auto dayOfYear = GetDayOfYear(month, GetCurrentDayOfMonth());
+            auto calendar = SeasonCalendar::GetSingleton().Get();
+            if (calendar && calendar->Resolve(dayOfYear).IsBlending()) {
+                const auto& blend = calendar->Resolve(dayOfYear);
+                ImGuiMCP::Text("Day %u of the year: %s -> %s (%.0f%%)", dayOfYear, SeasonToString(blend.from),
+                    SeasonToString(blend.to), blend.t * 100.0f);
+            } else {
+                ImGuiMCP::Text("Day %u of the year", dayOfYear);
+            }
+        }
+
         if (wm.HasSeasonOverride()) {
             ImGuiMCP::TextColored({ 1.0f, 1.0f, 0.0f, 1.0f }, "Season Override: %s",
                 SeasonToString(wm.GetSeasonOverride()));
@@ -65,34 +141,43 @@ namespace SWF {
 
         auto* sky = RE::Sky::GetSingleton();
         if (sky && sky->currentWeather) {
-            auto name   = RegionScanner::GetWeatherName(sky->currentWeather);
-            auto wclass = RegionScanner::ClassifyWeather(sky->currentWeather);
-            ImGuiMCP::Text("Current Weather: %s (%s)", name.c_str(), WeatherClassToString(wclass));
+            WeatherLine(view.get(), "Current Weather", sky->currentWeather, true);
         } else {
             ImGuiMCP::Text("Current Weather: None");
         }
 
-        if (sky && sky->region) {
-            auto regionName = RegionScanner::GetRegionName(sky->region);
-            ImGuiMCP::Text("Current Region: %s", regionName.c_str());
+        // Region and worldspace lines are rebuilt only when the tracker
+        // reports a change or a new view arrives, not every frame.
+        auto& tracker = RegionTracker::GetSingleton();
+        static std::uint64_t   lastChange = ~0ull;
+        static const MenuView* lastView   = nullptr;
+        static std::string     regionLine;
+        static std::string     entriesLine;
+        static std::string     worldSpaceLine;
+        if (tracker.GetChangeCount() != lastChange || view.get() != lastView) {
+            lastChange = tracker.GetChangeCount();
+            lastView   = view.get();
+            regionLine.clear();
+            entriesLine.clear();
+            worldSpaceLine.clear();
+
+            if (auto* region = tracker.GetCurrentRegion()) {
+                const auto* row = view ? view->FindRegion(region) : nullptr;
+                regionLine = "Current Region: " + (row ? row->name : RegionScanner::GetRegionName(region));
+                if (row) entriesLine = std::format("  Weather entries: {}", row->weatherCount);
+            } else {
+                regionLine = "Current Region: None detected";
+            }
 
-            auto& regionInfos = RegionScanner::GetSingleton().GetRegionWeatherInfos();
-            for (const auto& info : regionInfos) {
-                if (info.region == sky->region) {
-                    ImGuiMCP::Text("  Weather entries: %d", (int)info.originalWeatherEntries.size());
-                    break;
-                }
+            if (auto* ws = tracker.GetCurrentWorldSpace()) {
+                auto editorID = ws->GetFormEditorID();
+                worldSpaceLine = std::string("Worldspace: ") + (editorID ? editorID : "Unknown");
             }
-        } else {
-            ImGuiMCP::Text("Current Region: None detected");
         }
 
-        // Worldspace
-        auto* ws = wm.GetCurrentWorldSpace();
-        if (ws) {
-            auto editorID = ws->GetFormEditorID();
-            ImGuiMCP::Text("Worldspace: %s", editorID ? editorID : "Unknown");
-        }
+        ImGuiMCP::TextUnformatted(regionLine.c_str());
+        if (!entriesLine.empty()) ImGuiMCP::TextUnformatted(entriesLine.c_str());
+        if (!worldSpaceLine.empty()) ImGuiMCP::TextUnformatted(worldSpaceLine.c_str());
 
         ImGuiMCP::Separator();
 
@@ -103,18 +188,20 @@ namespace SWF {
         ImGuiMCP::Spacing();
 
         if (ImGuiMCP::Button("Re-apply Season Weights")) {
-            wm.ForceRefresh();
-            wm.Update();
+            CommandQueue::GetSingleton().Push(CommandType::kReapply);
         }
     }
 
     void __stdcall MenuUI::RenderSettings() {
-        auto& config = ConfigManager::GetSingleton().GetConfig();
+        PerfScope perf(PerfTimer::kMenuRender);
+        auto snapshot = ConfigManager::GetSingleton().GetSnapshot();
+        const auto& config = *snapshot;
+        auto& queue = CommandQueue::GetSingleton();
 
+        // Widgets edit local copies; changes are queued and applied on the
+        // game thread so no weather work runs inside the ImGui frame.
         ImGuiMCP::SeparatorText("General");
-
-        ImGuiMCP::Checkbox("Enabled", &config.enabled);
-        ImGuiMCP::Checkbox("Show Season Change Notifications", &config.enableNotifications);
+        RenderConfigSection("General");
 
         ImGuiMCP::Separator();
         ImGuiMCP::SeparatorText("Worldspaces");
@@ -122,18 +209,14 @@ namespace SWF {
         ImGuiMCP::Text("Use the exact EditorID as it appears in xEdit (case-sensitive).");
         ImGuiMCP::Spacing();
 
-        std::vector<std::string> toRemove;
         for (const auto& ws : config.enabledWorldspaces) {
             ImGuiMCP::Text("  %s", ws.c_str());
             ImGuiMCP::SameLine();
-            auto removeLabel = std::string("Remove##") + ws;
-            if (ImGuiMCP::SmallButton(removeLabel.c_str())) {
-                toRemove.push_back(ws);
+            ImGuiMCP::PushID(ws.c_str());
+            if (ImGuiMCP::SmallButton("Remove")) {
+                queue.Push(CommandType::kRemoveWorldspace, ws);
             }
-        }
-        for (const auto& ws : toRemove) {
-            config.enabledWorldspaces.erase(ws);
-            WeatherManager::GetSingleton().ForceRefresh();
+            ImGuiMCP::PopID();
         }
 
         static char wsInputBuf[128] = {};
@@ -146,8 +229,7 @@ namespace SWF {
             if (start != std::string::npos) {
                 newWS = newWS.substr(start, end - start + 1);
                 if (!newWS.empty()) {
-                    config.enabledWorldspaces.insert(newWS);
-                    WeatherManager::GetSingleton().ForceRefresh();
+                    queue.Push(CommandType::kAddWorldspace, std::move(newWS));
                     wsInputBuf[0] = '\0';
                 }
             }
@@ -157,32 +239,39 @@ namespace SWF {
 
         ImGuiMCP::SeparatorText("Season Month Ranges");
         ImGuiMCP::Text("Month indices: 0=Morning Star ... 11=Evening Star");
-
-        int springStart = static_cast<int>(config.springStart);
-        int springEnd   = static_cast<int>(config.springEnd);
-        int summerStart = static_cast<int>(config.summerStart);
-        int summerEnd   = static_cast<int>(config.summerEnd);
-        int fallStart   = static_cast<int>(config.fallStart);
-        int fallEnd     = static_cast<int>(config.fallEnd);
-
-        if (ImGuiMCP::SliderInt("Spring Start", &springStart, 0, 11)) config.springStart = springStart;
-        if (ImGuiMCP::SliderInt("Spring End",   &springEnd,   0, 11)) config.springEnd   = springEnd;
-        if (ImGuiMCP::SliderInt("Summer Start", &summerStart, 0, 11)) config.summerStart  = summerStart;
-        if (ImGuiMCP::SliderInt("Summer End",   &summerEnd,   0, 11)) config.summerEnd    = summerEnd;
-        if (ImGuiMCP::SliderInt("Fall Start",   &fallStart,   0, 11)) config.fallStart    = fallStart;
-        if (ImGuiMCP::SliderInt("Fall End",     &fallEnd,     0, 11)) config.fallEnd      = fallEnd;
+        RenderConfigSection("SeasonMonths");
         ImGuiMCP::Text("Winter = everything outside the above ranges");
 
+        ImGuiMCP::Spacing();
+        ImGuiMCP::SeparatorText("Season Day Calendar");
+        RenderConfigSection("SeasonCalendar");
+        if (config.useMonthCurves) {
+            ImGuiMCP::TextColored({ 1.0f, 1.0f, 0.0f, 1.0f }, "Month curves are on and take precedence.");
+        }
+
         ImGuiMCP::Separator();
         ImGuiMCP::SeparatorText("Season Weather Multipliers");
         ImGuiMCP::Text("Multipliers adjust region weather chance per type per season.");
         ImGuiMCP::Text("> 1.0 = more likely, < 1.0 = less likely, 0.0 = never");
+        ImGuiMCP::Checkbox("Live preview while dragging", &livePreview.enabled);
+        if (livePreview.enabled) {
+            ImGuiMCP::SameLine();
+            ImGuiMCP::Checkbox("Force preview weather", &livePreview.forceWeather);
+        }
 
         RenderSeasonMultipliers("Spring", 0);
         RenderSeasonMultipliers("Summer", 1);
         RenderSeasonMultipliers("Fall",   2);
         RenderSeasonMultipliers("Winter", 3);
 
+        ImGuiMCP::Spacing();
+        ImGuiMCP::SeparatorText("Month Curves");
+        RenderMonthCurves();
+
+        ImGuiMCP::Spacing();
+        ImGuiMCP::SeparatorText("Transitions");
+        RenderConfigSection("Transitions");
+
         ImGuiMCP::Spacing();
         ImGuiMCP::Separator();
 
@@ -196,9 +285,9 @@ namespace SWF {
         const char* overrideItems[] = { "Auto (Calendar)", "Spring", "Summer", "Fall", "Winter" };
         if (ImGuiMCP::Combo("Season", &overrideIdx, overrideItems, 5)) {
             if (overrideIdx == 0) {
-                wm.ClearSeasonOverride();
+                queue.Push(CommandType::kClearSeasonOverride);
             } else {
-                wm.SetSeasonOverride(static_cast<Season>(overrideIdx - 1));
+                queue.Push(CommandType::kSetSeasonOverride, overrideIdx - 1, 0, 0.0f);
             }
         }
 
@@ -207,64 +296,265 @@ namespace SWF {
         // Save/Load buttons
         ImGuiMCP::Separator();
         if (ImGuiMCP::Button("Save Settings")) {
-            ConfigManager::GetSingleton().Save();
+            queue.Push(CommandType::kSaveConfig);
         }
         ImGuiMCP::SameLine();
         if (ImGuiMCP::Button("Load Settings")) {
-            ConfigManager::GetSingleton().Load();
+            queue.Push(CommandType::kLoadConfig);
         }
         ImGuiMCP::SameLine();
         if (ImGuiMCP::Button("Reset to Defaults")) {
-            config = Config{};
+            queue.Push(CommandType::kResetDefaults);
+        }
+
+        // Undo/redo step through config versions; the labels name the edit
+        // that would be undone or redone.
+        auto history = ConfigHistory::GetSingleton().GetStatus();
+        ImGuiMCP::BeginDisabled(history.undoLabel.empty());
+        if (ImGuiMCP::Button("Undo")) {
+            queue.Push(CommandType::kUndo);
+        }
+        ImGuiMCP::EndDisabled();
+        ImGuiMCP::SameLine();
+        ImGuiMCP::BeginDisabled(history.redoLabel.empty());
+        if (ImGuiMCP::Button("Redo")) {
+            queue.Push(CommandType::kRedo);
+        }
+        ImGuiMCP::EndDisabled();
+        ImGuiMCP::SameLine();
+        if (!history.undoLabel.empty()) {
+            ImGuiMCP::Text("Undo: %s", history.undoLabel.c_str());
+        } else if (!history.redoLabel.empty()) {
+            ImGuiMCP::Text("Redo: %s", history.redoLabel.c_str());
+        } else {
+            ImGuiMCP::TextUnformatted("No edits to undo");
         }
+        ImGuiMCP::Text("History: %d versions, %d cached tables, %.1f KiB", (int)history.entries,
+            (int)history.cachedTables, history.bytes / 1024.0);
+
+        RenderPresets();
     }
 
-    void MenuUI::RenderSeasonMultipliers(const char* label, int seasonIdx) {
-        auto& config = ConfigManager::GetSingleton().GetConfig();
-        auto& mults = config.GetMultipliersMut(static_cast<Season>(seasonIdx));
+    void MenuUI::RenderPresets() {
+        auto& queue = CommandQueue::GetSingleton();
+        auto& store = PresetStore::GetSingleton();
+
+        ImGuiMCP::Spacing();
+        ImGuiMCP::SeparatorText("Presets");
+
+        auto presets = store.GetPresets();
+        static std::string selected;
+
+        const char* preview = selected.empty() ? "(select a preset)" : selected.c_str();
+        if (ImGuiMCP::BeginCombo("##preset", preview)) {
+            if (presets) {
+                for (const auto& preset : *presets) {
+                    bool isSelected = preset->name == selected;
+                    auto label = preset->stale ? preset->name + " (stale)" : preset->name;
+                    if (ImGuiMCP::Selectable(label.c_str(), isSelected)) {
+                        selected = preset->name;
+                    }
+                }
+            }
+            ImGuiMCP::EndCombo();
+        }
+        ImGuiMCP::SameLine();
+        if (ImGuiMCP::Button("Apply Preset") && !selected.empty()) {
+            queue.Push(CommandType::kApplyPreset, selected);
+        }
+        ImGuiMCP::SameLine();
+        if (ImGuiMCP::Button("Rescan")) {
+            queue.Push(CommandType::kRefreshPresets);
+        }
 
+        static char nameBuf[64] = {};
+        ImGuiMCP::InputText("##presetName", nameBuf, sizeof(nameBuf));
+        ImGuiMCP::SameLine();
+        if (ImGuiMCP::Button("Save Current as Preset") && nameBuf[0] != '\0') {
+            queue.Push(CommandType::kSavePreset, std::string(nameBuf));
+            nameBuf[0] = '\0';
+        }
+        ImGuiMCP::Text("Console: SWFPreset lists presets, SWFPreset <name> switches.");
+    }
+
+    void MenuUI::RenderConfigField(std::size_t index) {
+        const auto& field = kConfigSchema[index];
+        if (field.label.empty()) return;
+
+        auto snapshot = ConfigManager::GetSingleton().GetSnapshot();
+        const auto& config = *snapshot;
+        auto& queue = CommandQueue::GetSingleton();
+        auto push = [&](float value) {
+            queue.Push(CommandType::kSetField, static_cast<std::uint32_t>(index), 0, value);
+        };
+
+        // Labels view string literals, so data() is NUL-terminated.
+        const char* label = field.label.data();
+
+        switch (field.type) {
+            case FieldType::kBool: {
+                bool value = field.Get<bool>(config);
+                if (ImGuiMCP::Checkbox(label, &value)) push(value ? 1.0f : 0.0f);
+                return;
+            }
+            case FieldType::kUInt: {
+                int value = static_cast<int>(field.Get<std::uint32_t>(config));
+                if (ImGuiMCP::SliderInt(label, &value, static_cast<int>(field.minValue),
+                                        static_cast<int>(field.maxValue))) {
+                    push(static_cast<float>(value));
+                }
+                break;
+            }
+            case FieldType::kFloat: {
+                float value = field.Get<float>(config);
+                if (ImGuiMCP::SliderFloat(label, &value, field.minValue, field.maxValue, "%.2f")) {
+                    push(value);
+                    if (livePreview.enabled && field.effect == FieldEffect::kMultiplier) {
+                        livePreview.pendingField = static_cast<std::int64_t>(index);
+                    }
+                }
+
+                // While dragging, preview at most once per interval; a value
+                // held still past the interval is still picked up.
+                auto now = std::chrono::steady_clock::now();
+                if (livePreview.pendingField == static_cast<std::int64_t>(index) && ImGuiMCP::IsItemActive() &&
+                    now - livePreview.lastRequest >= LivePreview::kInterval) {
+                    queue.Push(CommandType::kPreview, 0, 0, livePreview.forceWeather ? 1.0f : 0.0f);
+                    livePreview.lastRequest  = now;
+                    livePreview.pendingField = -1;
+                }
+                break;
+            }
+            default:
+                return;
+        }
+
+        // One full re-apply per drag, not per slider step; it also ends a
+        // live preview.
+        if (ImGuiMCP::IsItemDeactivatedAfterEdit()) {
+            queue.Push(CommandType::kRefresh);
+            livePreview.pendingField = -1;
+        }
+    }
+
+    void MenuUI::RenderConfigSection(std::string_view section) {
+        for (std::size_t i = 0; i < kConfigSchema.size(); ++i) {
+            if (kConfigSchema[i].section == section) RenderConfigField(i);
+        }
+    }
+
+    void MenuUI::RenderSeasonMultipliers(const char* label, int seasonIdx) {
         if (ImGuiMCP::CollapsingHeader(label)) {
             ImGuiMCP::PushItemWidth(200);
+            ImGuiMCP::PushID(label);
 
-            std::string id = std::string("##") + label;
-            ImGuiMCP::SliderFloat(("Pleasant" + id).c_str(), &mults.pleasantMult, 0.0f, 5.0f, "%.2f");
-            ImGuiMCP::SliderFloat(("Cloudy" + id).c_str(),   &mults.cloudyMult,   0.0f, 5.0f, "%.2f");
-            ImGuiMCP::SliderFloat(("Rainy" + id).c_str(),    &mults.rainyMult,    0.0f, 5.0f, "%.2f");
-            ImGuiMCP::SliderFloat(("Snow" + id).c_str(),     &mults.snowMult,     0.0f, 5.0f, "%.2f");
+            for (std::size_t i = 0; i < kConfigSchema.size(); ++i) {
+                const auto& field = kConfigSchema[i];
+                if (field.effect == FieldEffect::kMultiplier && field.season == static_cast<Season>(seasonIdx)) {
+                    RenderConfigField(i);
+                }
+            }
 
+            ImGuiMCP::PopID();
             ImGuiMCP::PopItemWidth();
         }
     }
 
-    void MenuUI::RenderWeatherList(const RegionWeatherInfo& info) {
-        if (ImGuiMCP::BeginTable("##weatherTable", 4,
+    void MenuUI::RenderMonthCurves() {
+        RenderConfigSection("MonthCurves");
+
+        // Curves are edited in the INI ([MonthCurves]); the plots show the
+        // baked per-month multipliers, re-baked only when the config changes.
+        static std::uint64_t lastVersion = ~0ull;
+        static std::array<std::array<float, kMonthsPerYear>, 4> plots{};
+        auto& configManager = ConfigManager::GetSingleton();
+        if (configManager.GetVersion() != lastVersion) {
+            lastVersion = configManager.GetVersion();
+            auto months = BakeMonthMultipliers(*configManager.GetSnapshot());
+            for (std::uint32_t m = 0; m < kMonthsPerYear; ++m) {
+                plots[0][m] = months[m].pleasantMult;
+                plots[1][m] = months[m].cloudyMult;
+                plots[2][m] = months[m].rainyMult;
+                plots[3][m] = months[m].snowMult;
+            }
+        }
+
+        if (ImGuiMCP::CollapsingHeader("Month Curve Preview")) {
+            ImGuiMCP::Text("Multiplier per month, Morning Star to Evening Star; empty curves follow the seasons.");
+            const char* names[] = { "Pleasant", "Cloudy", "Rainy", "Snow" };
+            for (std::size_t wc = 0; wc < plots.size(); ++wc) {
+                auto peak = *std::ranges::max_element(plots[wc]);
+                ImGuiMCP::PlotLines(names[wc], plots[wc].data(), static_cast<int>(kMonthsPerYear), 0, nullptr,
+                    0.0f, (std::max)(peak, 1.0f), ImGuiMCP::ImVec2{ 0.0f, 60.0f });
+            }
+        }
+    }
+
+    void MenuUI::RenderWeatherList(const MenuView& view, const MenuView::RegionRow& region) {
+        // Effective chance per class and season, after multipliers,
+        // globals and injection.
+        if (ImGuiMCP::BeginTable("##classShareTable", 1 + static_cast<int>(MenuView::kSeasonCount),
+            ImGuiMCP::ImGuiTableFlags_Borders | ImGuiMCP::ImGuiTableFlags_RowBg |
+            ImGuiMCP::ImGuiTableFlags_SizingStretchProp)) {
+            ImGuiMCP::TableSetupColumn("Class");
+            for (std::size_t s = 0; s < MenuView::kSeasonCount; ++s) {
+                ImGuiMCP::TableSetupColumn(SeasonToString(static_cast<Season>(s)));
+            }
+            ImGuiMCP::TableHeadersRow();
+
+            for (std::size_t c = 0; c < MenuView::kClassCount; ++c) {
+                ImGuiMCP::TableNextRow();
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::TextUnformatted(WeatherClassToString(static_cast<WeatherClass>(c)));
+                for (std::size_t s = 0; s < MenuView::kSeasonCount; ++s) {
+                    ImGuiMCP::TableNextColumn();
+                    ImGuiMCP::Text("%.1f%%", MenuView::ShareToPercent(region.classShare[s][c]));
+                }
+            }
+            ImGuiMCP::EndTable();
+        }
+        ImGuiMCP::Spacing();
+
+        if (ImGuiMCP::BeginTable("##weatherTable", 5 + static_cast<int>(MenuView::kSeasonCount),
             ImGuiMCP::ImGuiTableFlags_Borders | ImGuiMCP::ImGuiTableFlags_RowBg |
             ImGuiMCP::ImGuiTableFlags_SizingStretchProp)) {
             ImGuiMCP::TableSetupColumn("Weather");
             ImGuiMCP::TableSetupColumn("Type");
             ImGuiMCP::TableSetupColumn("Base Chance");
+            ImGuiMCP::TableSetupColumn(SeasonToString(view.season));
+            const char* shareHeaders[] = { "Spring %", "Summer %", "Fall %", "Winter %" };
+            static_assert(std::size(shareHeaders) == MenuView::kSeasonCount);
+            for (const char* header : shareHeaders) ImGuiMCP::TableSetupColumn(header);
             ImGuiMCP::TableSetupColumn("FormID");
             ImGuiMCP::TableHeadersRow();
 
-            for (const auto& entry : info.originalWeatherEntries) {
+            for (std::uint32_t i = 0; i < region.weatherCount; ++i) {
+                const auto& row = view.weathers[region.firstWeather + i];
+                const auto& label = view.weatherLabels[row.weather];
+
                 ImGuiMCP::TableNextRow();
                 ImGuiMCP::TableNextColumn();
-
-                auto name = RegionScanner::GetWeatherName(entry.weather);
-                ImGuiMCP::Text("%s", name.c_str());
+                ImGuiMCP::TextUnformatted(label.name.c_str());
 
                 ImGuiMCP::TableNextColumn();
-                ImGuiMCP::Text("%s", WeatherClassToString(entry.classification));
+                ImGuiMCP::TextUnformatted(label.classLabel);
 
                 ImGuiMCP::TableNextColumn();
-                ImGuiMCP::Text("%u", entry.baseChance);
+                ImGuiMCP::Text("%u", row.baseChance);
 
                 ImGuiMCP::TableNextColumn();
-                if (entry.weather) {
-                    ImGuiMCP::Text("%08X", entry.weather->GetFormID());
-                } else {
-                    ImGuiMCP::Text("N/A");
+                if (row.seasonWeight >= 0.0f)
+                    ImGuiMCP::Text("%.1f", row.seasonWeight);
+                else
+                    ImGuiMCP::TextUnformatted("-");
+
+                for (std::size_t s = 0; s < MenuView::kSeasonCount; ++s) {
+                    ImGuiMCP::TableNextColumn();
+                    ImGuiMCP::Text("%.1f", MenuView::ShareToPercent(row.share[s]));
                 }
+
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::TextUnformatted(row.formID.c_str());
             }
 
             ImGuiMCP::EndTable();
@@ -272,42 +562,163 @@ namespace SWF {
     }
 
     void __stdcall MenuUI::RenderRegionBrowser() {
-        auto& scanner = RegionScanner::GetSingleton();
-        auto& regionInfos = scanner.GetRegionWeatherInfos();
+        PerfScope perf(PerfTimer::kMenuRender);
+        auto& viewModel = MenuViewModel::GetSingleton();
+        viewModel.Refresh();
+        auto view = viewModel.Get();
 
         ImGuiMCP::SeparatorText("Loaded Regions with Weather Data");
+        if (!view) {
+            ImGuiMCP::Text("Building region list...");
+            return;
+        }
         ImGuiMCP::Text("Total: %d regions, %d unique weather forms",
-            (int)scanner.GetWeatherRegionCount(), (int)scanner.GetUniqueWeatherCount());
+            (int)view->regions.size(), (int)view->weatherLabels.size() - 1);
         ImGuiMCP::Separator();
 
-        for (const auto& info : regionInfos) {
-            std::string header = info.editorID;
-            if (info.worldSpace) {
-                auto editorID = info.worldSpace->GetFormEditorID();
-                if (editorID) {
-                    header += " [" + std::string(editorID) + "]";
+        // Search and filters. The query reruns only when the filter or the
+        // scan changes; the list below reads the cached result.
+        const auto& search = *view->search;
+        static char                       searchBuf[128] = {};
+        static RegionFilter               filter;
+        static RegionFilter               appliedFilter;
+        static std::uint64_t              appliedGeneration = ~0ull;
+        static std::vector<std::uint32_t> visible;
+        static double                     queryMs = 0.0;
+
+        // Facet indices are positions in the scan's label lists.
+        if (appliedGeneration != search.scanGeneration) {
+            filter.worldspace = -1;
+            filter.plugin     = -1;
+        }
+
+        if (ImGuiMCP::InputTextWithHint("##regionSearch", "Region or weather EditorID", searchBuf, sizeof(searchBuf))) {
+            filter.text = searchBuf;
+        }
+        FacetCombo("Worldspace", search.worldspaces, filter.worldspace);
+        FacetCombo("Plugin", search.plugins, filter.plugin);
+
+        ImGuiMCP::Text("Has weather:");
+        for (std::uint32_t c = 0; c <= static_cast<std::uint32_t>(WeatherClass::kUnknown); ++c) {
+            ImGuiMCP::SameLine();
+            ImGuiMCP::CheckboxFlags(WeatherClassToString(static_cast<WeatherClass>(c)), &filter.classMask, 1u << c);
+        }
+
+        int origin = static_cast<int>(filter.origin);
+        ImGuiMCP::RadioButton("All regions", &origin, static_cast<int>(RegionOrigin::kAny));
+        ImGuiMCP::SameLine();
+        ImGuiMCP::RadioButton("Original only", &origin, static_cast<int>(RegionOrigin::kOriginal));
+        ImGuiMCP::SameLine();
+        ImGuiMCP::RadioButton("With injected weathers", &origin, static_cast<int>(RegionOrigin::kInjected));
+        filter.origin = static_cast<RegionOrigin>(origin);
+
+        // Sorting by a class's effective share ("most Snow in Summer")
+        // surfaces regions whose weights produce the wrong weather.
+        static int sortClass  = -1;   // -1 sorts by name
+        static int sortSeason = static_cast<int>(Season::kSummer);
+        ImGuiMCP::PushItemWidth(150);
+        const char* sortPreview = sortClass < 0 ? "Name" : WeatherClassToString(static_cast<WeatherClass>(sortClass));
+        if (ImGuiMCP::BeginCombo("Sort by", sortPreview)) {
+            if (ImGuiMCP::Selectable("Name", sortClass < 0)) sortClass = -1;
+            for (int c = 0; c < static_cast<int>(MenuView::kClassCount); ++c) {
+                auto label = std::format("Most {}", WeatherClassToString(static_cast<WeatherClass>(c)));
+                if (ImGuiMCP::Selectable(label.c_str(), sortClass == c)) sortClass = c;
+            }
+            ImGuiMCP::EndCombo();
+        }
+        if (sortClass >= 0) {
+            ImGuiMCP::SameLine();
+            if (ImGuiMCP::BeginCombo("in", SeasonToString(static_cast<Season>(sortSeason)))) {
+                for (int s = 0; s < static_cast<int>(MenuView::kSeasonCount); ++s) {
+                    if (ImGuiMCP::Selectable(SeasonToString(static_cast<Season>(s)), sortSeason == s)) sortSeason = s;
                 }
+                ImGuiMCP::EndCombo();
             }
-            header += " (" + std::to_string(info.originalWeatherEntries.size()) + " weathers)";
+        }
+        ImGuiMCP::PopItemWidth();
+
+        static std::uint64_t queryCount = 0;
+        if (appliedGeneration != search.scanGeneration || !(filter == appliedFilter)) {
+            auto start = std::chrono::steady_clock::now();
+            search.Query(filter, visible);
+            queryMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            appliedFilter     = filter;
+            appliedGeneration = search.scanGeneration;
+            ++queryCount;
+        }
 
-            if (ImGuiMCP::CollapsingHeader(header.c_str())) {
-                ImGuiMCP::Text("Region FormID: %08X", info.region ? info.region->GetFormID() : 0);
-                ImGuiMCP::Text("Total Base Chance: %u", info.totalBaseChance);
-                ImGuiMCP::Spacing();
+        // Unfiltered, the list is one of the view's precomputed orders; a
+        // filtered one is walked in that order, keeping the query's matches.
+        // Either way nothing is sorted here.
+        const auto& order = sortClass < 0 ? view->regionOrder : view->shareOrder[sortSeason][sortClass];
+        static std::vector<std::uint32_t> sortedVisible;
+        static std::vector<std::uint8_t>  visibleMark;
+        static std::array<std::uint64_t, 7> sortedKey{};
+        std::array<std::uint64_t, 7> key{ queryCount, view->scanGeneration, view->configVersion, view->tableVersion,
+            static_cast<std::uint64_t>(view->season), static_cast<std::uint64_t>(sortClass),
+            static_cast<std::uint64_t>(sortSeason) };
+        if (sortClass >= 0 && !filter.IsEmpty() && key != sortedKey) {
+            visibleMark.assign(view->regions.size(), 0);
+            for (auto region : visible) visibleMark[region] = 1;
+            sortedVisible.clear();
+            for (auto region : order) {
+                if (visibleMark[region]) sortedVisible.push_back(region);
+            }
+            sortedKey = key;
+        }
+        const auto& rows = filter.IsEmpty() ? order : sortClass < 0 ? visible : sortedVisible;
+        ImGuiMCP::Text("Showing %d of %d regions (query %.3f ms)", (int)rows.size(), (int)view->regions.size(),
+            queryMs);
+
+        // Selection is by region FormID so it survives a rebuilt view.
+        static RE::FormID selectedForm = 0;
+
+        // One row per region, in name order, and only the visible rows are
+        // submitted, so the frame cost does not grow with the region count.
+        // The selected region's weathers are shown under the list.
+        auto rowCount = static_cast<int>(rows.size());
+        if (ImGuiMCP::BeginChild("##regionList", ImGuiMCP::ImVec2{ 0.0f, 320.0f }, ImGuiMCP::ImGuiChildFlags_Border)) {
+            auto* clipper = ImGuiMCP::ImGuiListClipperManager::Create();
+            ImGuiMCP::ImGuiListClipperManager::Begin(clipper, rowCount, -1.0f);
+            while (ImGuiMCP::ImGuiListClipperManager::Step(clipper)) {
+                for (int i = clipper->DisplayStart; i < clipper->DisplayEnd; ++i) {
+                    const auto& row = view->regions[rows[i]];
+                    ImGuiMCP::PushID(i);
+                    if (sortClass >= 0) {
+                        ImGuiMCP::Text("%5.1f%%", MenuView::ShareToPercent(row.classShare[sortSeason][sortClass]));
+                        ImGuiMCP::SameLine();
+                    }
+                    if (ImGuiMCP::Selectable(row.header.c_str(), row.form != 0 && row.form == selectedForm)) {
+                        selectedForm = row.form;
+                    }
+                    ImGuiMCP::PopID();
+                }
+            }
+            ImGuiMCP::ImGuiListClipperManager::End(clipper);
+            ImGuiMCP::ImGuiListClipperManager::Destroy(clipper);
+        }
+        ImGuiMCP::EndChild();
 
-                RenderWeatherList(info);
+        if (const auto* selected = view->FindRegion(selectedForm)) {
+            ImGuiMCP::Spacing();
+            ImGuiMCP::SeparatorText(selected->header.c_str());
+            ImGuiMCP::Text("Region FormID: %s", selected->formID.c_str());
+            ImGuiMCP::Text("Total Base Chance: %u", selected->totalBaseChance);
+            ImGuiMCP::Spacing();
 
-                ImGuiMCP::Spacing();
-            }
+            RenderWeatherList(*view, *selected);
+        } else {
+            ImGuiMCP::Text("Select a region to see its weather list.");
         }
     }
 
     void __stdcall MenuUI::RenderDebug() {
-        auto& config = ConfigManager::GetSingleton().GetConfig();
-
+        PerfScope perf(PerfTimer::kMenuRender);
         ImGuiMCP::SeparatorText("Debug");
 
-        ImGuiMCP::Checkbox("Debug Mode (verbose logging)", &config.debugMode);
+        constexpr int kDebugModeField = FindConfigField("General", "bDebugMode");
+        static_assert(kDebugModeField >= 0);
+        RenderConfigField(kDebugModeField);
         ImGuiMCP::Separator();
 
         // Calendar info
@@ -325,23 +736,15 @@ namespace SWF {
         // Sky info
         auto* sky = RE::Sky::GetSingleton();
         if (sky) {
-            if (sky->currentWeather) {
-                auto name = RegionScanner::GetWeatherName(sky->currentWeather);
-                auto wclass = RegionScanner::ClassifyWeather(sky->currentWeather);
-                ImGuiMCP::Text("Sky Current Weather: %s (%s)", name.c_str(), WeatherClassToString(wclass));
-            }
-            if (sky->lastWeather) {
-                auto name = RegionScanner::GetWeatherName(sky->lastWeather);
-                ImGuiMCP::Text("Sky Last Weather: %s", name.c_str());
-            }
-            if (sky->overrideWeather) {
-                auto name = RegionScanner::GetWeatherName(sky->overrideWeather);
-                ImGuiMCP::Text("Sky Override Weather: %s", name.c_str());
-            }
+            auto& viewModel = MenuViewModel::GetSingleton();
+            viewModel.Refresh();
+            auto view = viewModel.Get();
+
+            if (sky->currentWeather) WeatherLine(view.get(), "Sky Current Weather", sky->currentWeather, true);
+            if (sky->lastWeather) WeatherLine(view.get(), "Sky Last Weather", sky->lastWeather, false);
+            if (sky->overrideWeather) WeatherLine(view.get(), "Sky Override Weather", sky->overrideWeather, false);
             if (sky->defaultWeather) {
-                auto name = RegionScanner::GetWeatherName(sky->defaultWeather);
-                auto wclass = RegionScanner::ClassifyWeather(sky->defaultWeather);
-                ImGuiMCP::Text("Next Queued Weather: %s (%s)", name.c_str(), WeatherClassToString(wclass));
+                WeatherLine(view.get(), "Next Queued Weather", sky->defaultWeather, true);
             } else {
                 ImGuiMCP::Text("Next Queued Weather: None");
             }
@@ -369,5 +772,133 @@ namespace SWF {
 
         // Weather manager status
         ImGuiMCP::Text("Status: %s", WeatherManager::GetSingleton().GetStatusString().c_str());
+
+        RenderPerformance();
+    }
+
+    void MenuUI::RenderPerformance() {
+        auto& stats = PerfStats::GetSingleton();
+
+        ImGuiMCP::Spacing();
+        ImGuiMCP::SeparatorText("Performance");
+
+        if (ImGuiMCP::BeginTable("##perfTimers", 6,
+            ImGuiMCP::ImGuiTableFlags_Borders | ImGuiMCP::ImGuiTableFlags_RowBg |
+            ImGuiMCP::ImGuiTableFlags_SizingStretchProp)) {
+            ImGuiMCP::TableSetupColumn("Timer");
+            ImGuiMCP::TableSetupColumn("Count");
+            ImGuiMCP::TableSetupColumn("Mean (us)");
+            ImGuiMCP::TableSetupColumn("p50 (us)");
+            ImGuiMCP::TableSetupColumn("p99 (us)");
+            ImGuiMCP::TableSetupColumn("Max (us)");
+            ImGuiMCP::TableHeadersRow();
+
+            for (std::uint32_t t = 0; t < static_cast<std::uint32_t>(PerfTimer::kTotal); ++t) {
+                auto timer = static_cast<PerfTimer>(t);
+                auto summary = stats.Summarize(timer);
+                ImGuiMCP::TableNextRow();
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::TextUnformatted(PerfTimerToString(timer));
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::Text("%llu", static_cast<unsigned long long>(summary.count));
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::Text("%.1f", summary.meanMicros);
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::Text("%.1f", summary.p50Micros);
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::Text("%.1f", summary.p99Micros);
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::Text("%.1f", summary.maxMicros);
+            }
+            ImGuiMCP::EndTable();
+        }
+
+        // Last apply durations, oldest on the left.
+        std::array<float, PerfStats::kApplyHistory> applies{};
+        auto applyCount = stats.GetApplyHistory(applies);
+        if (applyCount > 0) {
+            auto peak = *std::max_element(applies.begin(), applies.begin() + applyCount);
+            auto overlay = std::format("last {} applies, peak {:.3f} ms", applyCount, peak);
+            ImGuiMCP::PlotLines("Apply (ms)", applies.data(), static_cast<int>(applyCount), 0, overlay.c_str(),
+                0.0f, (std::max)(peak, 0.001f), ImGuiMCP::ImVec2{ 0.0f, 60.0f });
+        }
+
+        // Event rates over the last whole second.
+        using Clock = std::chrono::steady_clock;
+        constexpr auto kEventCount = static_cast<std::size_t>(PerfEvent::kTotal);
+        static std::array<std::uint64_t, kEventCount> lastCounts{};
+        static std::array<double, kEventCount>        rates{};
+        static Clock::time_point                      lastSample = Clock::now();
+        auto now = Clock::now();
+        auto elapsed = std::chrono::duration<double>(now - lastSample).count();
+        if (elapsed >= 1.0) {
+            for (std::size_t e = 0; e < kEventCount; ++e) {
+                auto count = stats.GetEventCount(static_cast<PerfEvent>(e));
+                rates[e] = count >= lastCounts[e] ? (count - lastCounts[e]) / elapsed : 0.0;
+                lastCounts[e] = count;
+            }
+            lastSample = now;
+        }
+
+        if (ImGuiMCP::BeginTable("##perfEvents", 3,
+            ImGuiMCP::ImGuiTableFlags_Borders | ImGuiMCP::ImGuiTableFlags_RowBg |
+            ImGuiMCP::ImGuiTableFlags_SizingStretchProp)) {
+            ImGuiMCP::TableSetupColumn("Event source");
+            ImGuiMCP::TableSetupColumn("Total");
+            ImGuiMCP::TableSetupColumn("Per second");
+            ImGuiMCP::TableHeadersRow();
+
+            for (std::size_t e = 0; e < kEventCount; ++e) {
+                auto event = static_cast<PerfEvent>(e);
+                ImGuiMCP::TableNextRow();
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::TextUnformatted(PerfEventToString(event));
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::Text("%llu", static_cast<unsigned long long>(stats.GetEventCount(event)));
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::Text("%.1f", rates[e]);
+            }
+            ImGuiMCP::EndTable();
+        }
+
+        if (ImGuiMCP::BeginTable("##perfMemory", 4,
+            ImGuiMCP::ImGuiTableFlags_Borders | ImGuiMCP::ImGuiTableFlags_RowBg |
+            ImGuiMCP::ImGuiTableFlags_SizingStretchProp)) {
+            ImGuiMCP::TableSetupColumn("Structure");
+            ImGuiMCP::TableSetupColumn("Builds");
+            ImGuiMCP::TableSetupColumn("Live (KiB)");
+            ImGuiMCP::TableSetupColumn("Allocated (KiB)");
+            ImGuiMCP::TableHeadersRow();
+
+            for (std::uint32_t m = 0; m < static_cast<std::uint32_t>(PerfMemory::kTotal); ++m) {
+                auto memory = static_cast<PerfMemory>(m);
+                auto summary = stats.GetMemory(memory);
+                ImGuiMCP::TableNextRow();
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::TextUnformatted(PerfMemoryToString(memory));
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::Text("%llu", static_cast<unsigned long long>(summary.builds));
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::Text("%.1f", summary.liveBytes / 1024.0);
+                ImGuiMCP::TableNextColumn();
+                ImGuiMCP::Text("%.1f", summary.totalBytes / 1024.0);
+            }
+            ImGuiMCP::EndTable();
+        }
+
+        // Worker pool lanes keep their own counters.
+        for (std::uint32_t lane = 0; lane < static_cast<std::uint32_t>(TaskPriority::kTotal); ++lane) {
+            auto priority = static_cast<TaskPriority>(lane);
+            auto lanes = WorkerPool::GetSingleton().GetLaneStats(priority);
+            ImGuiMCP::Text("Worker %s lane: %llu done, %llu rejected, max run %.3f ms, max wait %.3f ms",
+                TaskPriorityToString(priority), static_cast<unsigned long long>(lanes.completed),
+                static_cast<unsigned long long>(lanes.rejected), lanes.maxMicros / 1000.0,
+                lanes.maxWaitMicros / 1000.0);
+        }
+
+        if (ImGuiMCP::Button("Reset Statistics")) {
+            stats.Reset();
+            lastCounts.fill(0);
+        }
     }
 }
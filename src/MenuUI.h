@@ -1,6 +1,7 @@
 #pragma once
 
 #include "pch.h"
+#include "MenuViewModel.h"
 
 namespace SWF {
 
@@ -31,7 +32,12 @@ namespace SWF {
         static void __stdcall RenderDebug();
 
         // Helpers
+        static void RenderConfigField(std::size_t schemaIndex);   // widget from kConfigSchema
+        static void RenderConfigSection(std::string_view section);
         static void RenderSeasonMultipliers(const char* label, int seasonIdx);
-        static void RenderWeatherList(const struct RegionWeatherInfo& info);
+        static void RenderMonthCurves();
+        static void RenderPresets();
+        static void RenderPerformance();
+        static void RenderWeatherList(const MenuView& view, const MenuView::RegionRow& region);
     };
 }
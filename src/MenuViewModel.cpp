@@ -0,0 +1,210 @@
+#include "MenuViewModel.h"
+#include "ChanceTable.h"
+#include "Config.h"
+#include "PerfStats.h"
+#include "RegionScanner.h"
+#include "WeatherManager.h"
+#include "WorkerPool.h"
+
+#include <chrono>
+#include <cmath>
+#include <functional>
+
+namespace SWF {
+
+    namespace {
+        std::string FormatFormID(const RE::TESForm* form) {
+            return form ? std::format("{:08X}", form->GetFormID()) : std::string("N/A");
+        }
+
+        // The chance WeatherManager::ApplyPartition writes for entry `i` of a
+        // region in `season`: the table weight times the entry's TESGlobal
+        // (`globalValue`, as of the scan), truncated, for managed regions;
+        // the base chance otherwise.
+        std::uint32_t EffectiveChance(const ChanceTable* table, const ChanceTable::RegionSlot* slot, Season season,
+                                      const RegionWeatherEntry& entry, float globalValue, std::size_t i) {
+            if (!table || !slot || !slot->managed || i >= slot->entryCount) return entry.baseChance;
+
+            float adjusted = table->GetSeasonWeights(season)[slot->firstEntry + i];
+            if (entry.global) adjusted *= globalValue;
+            return static_cast<std::uint32_t>((std::max)(adjusted, 0.0f));
+        }
+
+        std::uint16_t ToShare(double part, double total) {
+            if (total <= 0.0) return 0;
+            return static_cast<std::uint16_t>(std::lround(part / total * MenuView::kShareScale));
+        }
+    }
+
+    std::size_t MenuView::GetMemoryBytes() const {
+        auto bytes = regions.capacity() * sizeof(RegionRow) + regionOrder.capacity() * sizeof(std::uint32_t) +
+                     weathers.capacity() * sizeof(WeatherRow) + weatherLabels.capacity() * sizeof(WeatherLabel);
+        for (const auto& orders : shareOrder) {
+            for (const auto& order : orders) bytes += order.capacity() * sizeof(std::uint32_t);
+        }
+        for (const auto& row : regions) bytes += row.name.capacity() + row.header.capacity() + row.formID.capacity();
+        for (const auto& row : weathers) bytes += row.formID.capacity();
+        for (const auto& label : weatherLabels) bytes += label.name.capacity();
+        return bytes;
+    }
+
+    const MenuView::RegionRow* MenuView::FindRegion(RE::FormID formID) const {
+        auto& scanner = RegionScanner::GetSingleton();
+        if (scanner.GetGeneration() != scanGeneration) return nullptr;
+
+        auto index = scanner.GetRegionIndex(formID);
+        return index < regions.size() ? &regions[index] : nullptr;
+    }
+
+    void MenuViewModel::Refresh() {
+        // The build reads this snapshot, not the scanner, so a rescan during
+        // it cannot change the infos under it.
+        auto scan = RegionScanner::GetSingleton().GetSnapshot();
+        if (!scan) return;
+
+        auto scanGeneration = scan->generation;
+        auto configVersion  = ConfigManager::GetSingleton().GetVersion();
+        auto season         = WeatherManager::GetSingleton().GetCurrentSeason();
+
+        // Tables are rebuilt on a worker after a config change, so the one
+        // a view was built from can go stale while the versions still match.
+        auto table = WeatherManager::GetSingleton().GetChanceTable();
+        auto tableVersion = table && table->scanGeneration == scanGeneration ? table->configVersion : ~0ull;
+
+        auto view = Get();
+        if (view && view->scanGeneration == scanGeneration && view->configVersion == configVersion &&
+            view->season == season && view->tableVersion == tableVersion) {
+            return;
+        }
+
+        // One build at a time; a change that lands mid-build is picked up
+        // by the first Refresh() after it finishes.
+        if (building_.exchange(true, std::memory_order_acq_rel)) return;
+
+        bool debugMode = ConfigManager::GetSingleton().GetSnapshot()->debugMode;
+        bool submitted = WorkerPool::GetSingleton().Submit(TaskPriority::kNormal, "Build menu view",
+            [this, scan = std::move(scan), configVersion, season, table = std::move(table), debugMode]() {
+                view_.store(Build(scan, configVersion, season, table, debugMode), std::memory_order_release);
+                building_.store(false, std::memory_order_release);
+            });
+        if (!submitted) building_.store(false, std::memory_order_release);
+    }
+
+    std::shared_ptr<const MenuView> MenuViewModel::Build(std::shared_ptr<const RegionScanSnapshot> scan,
+                                                         std::uint64_t configVersion, Season season,
+                                                         std::shared_ptr<const ChanceTable> table, bool debugMode) {
+        auto start = std::chrono::steady_clock::now();
+        auto scanGeneration = scan->generation;
+        const auto& regionInfos    = scan->infos;
+        const auto& uniqueWeathers = scan->uniqueWeathers;
+
+        auto view = std::make_shared<MenuView>();
+        view->scanGeneration = scanGeneration;
+        view->configVersion  = configVersion;
+        view->season         = season;
+
+        // Weather labels: one per unique weather, then the "missing" slot.
+        view->weatherLabels.reserve(uniqueWeathers.size() + 1);
+        view->weatherByForm.Reserve(uniqueWeathers.size());
+        for (auto* weather : uniqueWeathers) {
+            view->weatherByForm.Insert(weather ? weather->GetFormID() : 0,
+                static_cast<std::uint32_t>(view->weatherLabels.size()));
+            view->weatherLabels.push_back({ RegionScanner::GetWeatherName(weather),
+                WeatherClassToString(RegionScanner::ClassifyWeather(weather)) });
+        }
+        auto missingWeather = static_cast<std::uint32_t>(view->weatherLabels.size());
+        view->weatherLabels.push_back({ "None", WeatherClassToString(WeatherClass::kUnknown) });
+
+        // The table only lines up with the scan it was built from.
+        if (table && table->scanGeneration != scanGeneration) table.reset();
+        view->tableVersion = table ? table->configVersion : ~0ull;
+        const float* seasonWeights = table ? table->GetSeasonWeights(season) : nullptr;
+
+        std::size_t totalEntries = 0;
+        for (const auto& info : regionInfos) totalEntries += info.originalWeatherEntries.size();
+        view->regions.reserve(regionInfos.size());
+        view->weathers.reserve(totalEntries);
+
+        std::size_t firstGlobal = 0;   // into scan->globalValues
+        for (std::size_t r = 0; r < regionInfos.size(); ++r) {
+            const auto& info = regionInfos[r];
+            const float* globals = scan->globalValues.data() + firstGlobal;
+            firstGlobal += info.originalWeatherEntries.size();
+            auto& row = view->regions.emplace_back();
+            row.name            = info.editorID;
+            row.formID          = FormatFormID(info.region);
+            row.form            = info.region ? info.region->GetFormID() : 0;
+            row.totalBaseChance = info.totalBaseChance;
+            row.firstWeather    = static_cast<std::uint32_t>(view->weathers.size());
+            row.weatherCount    = static_cast<std::uint32_t>(info.originalWeatherEntries.size());
+            if (info.worldSpaceEditorID.empty()) {
+                row.header = std::format("{} ({} weathers)", info.editorID, row.weatherCount);
+            } else {
+                row.header = std::format("{} [{}] ({} weathers)", info.editorID, info.worldSpaceEditorID,
+                    row.weatherCount);
+            }
+
+            const ChanceTable::RegionSlot* slot = seasonWeights && r < table->regions.size() ? &table->regions[r]
+                                                                                               : nullptr;
+            for (std::size_t i = 0; i < info.originalWeatherEntries.size(); ++i) {
+                const auto& entry = info.originalWeatherEntries[i];
+                auto& weather = view->weathers.emplace_back();
+                weather.weather    = entry.weatherIndex < uniqueWeathers.size() ? entry.weatherIndex : missingWeather;
+                weather.formID     = FormatFormID(entry.weather);
+                weather.baseChance = entry.baseChance;
+                if (slot && slot->managed && i < slot->entryCount) {
+                    weather.seasonWeight = seasonWeights[slot->firstEntry + i];
+                }
+            }
+
+            // Effective probabilities: each entry's applied chance over the
+            // region's total for that season, as the game normalizes them.
+            for (std::size_t s = 0; s < MenuView::kSeasonCount; ++s) {
+                std::uint64_t total = 0;
+                std::array<std::uint64_t, MenuView::kClassCount> classTotals{};
+                for (std::size_t i = 0; i < row.weatherCount; ++i) {
+                    const auto& entry = info.originalWeatherEntries[i];
+                    auto chance = EffectiveChance(table.get(), slot, static_cast<Season>(s), entry, globals[i], i);
+                    total += chance;
+                    classTotals[(std::min)(static_cast<std::size_t>(entry.classification), MenuView::kClassCount - 1)]
+                        += chance;
+                }
+                for (std::size_t i = 0; i < row.weatherCount; ++i) {
+                    const auto& entry = info.originalWeatherEntries[i];
+                    auto chance = EffectiveChance(table.get(), slot, static_cast<Season>(s), entry, globals[i], i);
+                    view->weathers[row.firstWeather + i].share[s] =
+                        ToShare(static_cast<double>(chance), static_cast<double>(total));
+                }
+                for (std::size_t c = 0; c < MenuView::kClassCount; ++c) {
+                    row.classShare[s][c] = ToShare(static_cast<double>(classTotals[c]), static_cast<double>(total));
+                }
+            }
+
+            auto first = view->weathers.begin() + row.firstWeather;
+            std::ranges::stable_sort(first, first + row.weatherCount, std::greater{}, &MenuView::WeatherRow::baseChance);
+        }
+
+        // The search index is per scan, so config and season rebuilds reuse it.
+        view->search      = RegionSearch::GetSingleton().Ensure(regionInfos, scanGeneration);
+        view->regionOrder = view->search->nameOrder;
+
+        // Starting from name order keeps ties alphabetical.
+        for (std::size_t s = 0; s < MenuView::kSeasonCount; ++s) {
+            for (std::size_t c = 0; c < MenuView::kClassCount; ++c) {
+                auto& order = view->shareOrder[s][c];
+                order = view->regionOrder;
+                std::ranges::stable_sort(order, std::greater{}, [&](std::uint32_t region) {
+                    return view->regions[region].classShare[s][c];
+                });
+            }
+        }
+
+        if (debugMode) {
+            auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            logs::info("MenuViewModel: Built view for {} regions, {} weather rows in {:.3f} ms",
+                view->regions.size(), view->weathers.size(), ms);
+        }
+        PerfStats::GetSingleton().NoteBuild(PerfMemory::kMenuView, view->GetMemoryBytes());
+        return view;
+    }
+}
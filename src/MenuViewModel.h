@@ -0,0 +1,127 @@
+#pragma once
+
+#include "pch.h"
+#include "FlatFormMap.h"
+#include "RegionSearch.h"
+#include "Season.h"
+
+#include <array>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace SWF {
+
+    struct ChanceTable;
+    struct RegionScanSnapshot;
+
+    // Everything the menu tabs print that derives from the scan, the config
+    // or the season, preformatted on a worker. Render callbacks only index
+    // into it; nothing here is formatted per frame.
+    struct MenuView {
+        static constexpr std::size_t kSeasonCount = static_cast<std::size_t>(Season::kTotal);
+        static constexpr std::size_t kClassCount  = static_cast<std::size_t>(WeatherClass::kUnknown) + 1;
+
+        // Effective probabilities are stored in fixed point; kShareScale is 100%.
+        static constexpr std::uint32_t kShareScale = 0xFFFF;
+        using SeasonShares = std::array<std::uint16_t, kSeasonCount>;
+        using ClassShares  = std::array<std::array<std::uint16_t, kClassCount>, kSeasonCount>;
+
+        static float ShareToPercent(std::uint16_t share) {
+            return static_cast<float>(share) * 100.0f / static_cast<float>(kShareScale);
+        }
+
+        struct WeatherLabel {
+            std::string name;
+            const char* classLabel = "";
+        };
+
+        struct WeatherRow {
+            std::uint32_t weather      = 0;       // index into `weatherLabels`
+            std::string   formID;                 // "0001234A", or "N/A"
+            std::uint32_t baseChance   = 0;
+            float         seasonWeight = -1.0f;   // current season's table weight; < 0 if unmanaged
+            SeasonShares  share{};                // chance of being picked within the region, per season
+        };
+
+        struct RegionRow {
+            std::string   name;                   // region EditorID
+            std::string   header;                 // "EditorID [Worldspace] (N weathers)"
+            std::string   formID;
+            RE::FormID    form            = 0;
+            std::uint32_t totalBaseChance = 0;
+            std::uint32_t firstWeather    = 0;    // into `weathers`, highest base chance first
+            std::uint32_t weatherCount    = 0;
+            ClassShares   classShare{};           // per season, each class's summed `share`
+        };
+
+        std::vector<RegionRow>     regions;        // parallel to GetRegionWeatherInfos()
+        std::vector<std::uint32_t> regionOrder;    // indices into `regions`, by name (case-insensitive)
+        std::shared_ptr<const CompiledRegionSearch> search;   // same scan as `regions`
+        std::vector<WeatherRow>    weathers;
+
+        // One label per unique scanned weather, plus a slot for entries
+        // whose weather is missing.
+        std::vector<WeatherLabel>  weatherLabels;
+        FlatFormMap<std::uint32_t> weatherByForm;   // weather FormID -> index into `weatherLabels`
+
+        // Per season and class, regions by that class's share, highest first
+        // (ties in name order), e.g. shareOrder[kSummer][kSnow] lists the
+        // regions most likely to snow in summer.
+        std::array<std::array<std::vector<std::uint32_t>, kClassCount>, kSeasonCount> shareOrder;
+
+        std::uint64_t scanGeneration = ~0ull;
+        std::uint64_t configVersion  = ~0ull;
+        std::uint64_t tableVersion   = ~0ull;   // config version of the chance table used, ~0 if none
+        Season        season         = Season::kWinter;
+
+        // Null for a weather or region that was not part of the scan.
+        const WeatherLabel* FindWeather(const RE::TESWeather* weather) const {
+            const auto* index = weather ? weatherByForm.Find(weather->GetFormID()) : nullptr;
+            return index ? &weatherLabels[*index] : nullptr;
+        }
+        std::size_t GetMemoryBytes() const;
+
+        // Regions go through the scanner's region index, which `regions`
+        // shares while the scan generation matches.
+        const RegionRow* FindRegion(RE::FormID formID) const;
+        const RegionRow* FindRegion(const RE::TESRegion* region) const {
+            return region ? FindRegion(region->GetFormID()) : nullptr;
+        }
+    };
+
+    class MenuViewModel {
+    public:
+        static MenuViewModel& GetSingleton() {
+            static MenuViewModel instance;
+            return instance;
+        }
+
+        // Render thread, every frame: schedules a rebuild on the worker pool
+        // if the scan generation, config version or season moved since the
+        // current view was built, or a newer chance table was installed.
+        // Never blocks; until the new view is ready the old one keeps being
+        // shown.
+        void Refresh();
+
+        // Null until the first build has finished.
+        std::shared_ptr<const MenuView> Get() const {
+            return view_.load(std::memory_order_acquire);
+        }
+
+    private:
+        MenuViewModel() = default;
+        ~MenuViewModel() = default;
+        MenuViewModel(const MenuViewModel&) = delete;
+        MenuViewModel& operator=(const MenuViewModel&) = delete;
+
+        // Reads only its arguments, never the scanner's or the config's live
+        // state; `debugMode` is captured by Refresh().
+        static std::shared_ptr<const MenuView> Build(std::shared_ptr<const RegionScanSnapshot> scan,
+                                                     std::uint64_t configVersion, Season season,
+                                                     std::shared_ptr<const ChanceTable> table, bool debugMode);
+
+        std::atomic<std::shared_ptr<const MenuView>> view_;
+        std::atomic<bool>                            building_ = false;
+    };
+}
@@ -0,0 +1,94 @@
+#include "MonthCurves.h"
+#include "IniParser.h"
+
+#include <cmath>
+
+namespace SWF {
+
+    namespace {
+        constexpr float kMaxMultiplier = 10.0f;
+        constexpr float kYear          = static_cast<float>(kMonthsPerYear);
+
+        float& ClassMultiplier(SeasonWeatherMultipliers& mults, std::size_t wc) {
+            switch (static_cast<WeatherClass>(wc)) {
+                case WeatherClass::kPleasant: return mults.pleasantMult;
+                case WeatherClass::kCloudy:   return mults.cloudyMult;
+                case WeatherClass::kRainy:    return mults.rainyMult;
+                default:                      return mults.snowMult;
+            }
+        }
+    }
+
+    bool ParseMonthCurve(std::string_view text, MonthCurve& out) {
+        MonthCurve curve;
+        bool ok = true;
+        ForEachCSVToken(text, [&](std::string_view item) {
+            if (!ok) return;
+
+            auto colon = item.find(':');
+            MonthCurve::Keyframe key;
+            if (colon == std::string_view::npos ||
+                !ParseIniFloat(TrimView(item.substr(0, colon)), key.month) ||
+                !ParseIniFloat(TrimView(item.substr(colon + 1)), key.value) ||
+                key.month < 0.0f || key.month >= kYear) {
+                ok = false;
+                return;
+            }
+
+            key.value = std::clamp(key.value, 0.0f, kMaxMultiplier);
+            auto it = std::ranges::find(curve.keyframes, key.month, &MonthCurve::Keyframe::month);
+            if (it != curve.keyframes.end())
+                it->value = key.value;
+            else
+                curve.keyframes.push_back(key);
+        });
+
+        if (!ok) return false;
+        std::ranges::sort(curve.keyframes, {}, &MonthCurve::Keyframe::month);
+        out = std::move(curve);
+        return true;
+    }
+
+    void FormatMonthCurve(const MonthCurve& curve, std::string& out) {
+        bool first = true;
+        for (const auto& key : curve.keyframes) {
+            std::format_to(std::back_inserter(out), "{}{:g}:{:.2f}", first ? "" : ", ", key.month, key.value);
+            first = false;
+        }
+    }
+
+    float SampleMonthCurve(const MonthCurve& curve, float month, float fallback) {
+        const auto& keys = curve.keyframes;
+        if (keys.empty()) return fallback;
+        if (keys.size() == 1) return keys.front().value;
+
+        month = std::fmod(month, kYear);
+        if (month < 0.0f) month += kYear;
+
+        // Bracketing keyframes; before the first or after the last one the
+        // segment runs across the year boundary.
+        auto next = std::ranges::upper_bound(keys, month, {}, &MonthCurve::Keyframe::month);
+        const auto& b = next == keys.end() ? keys.front() : *next;
+        const auto& a = next == keys.begin() ? keys.back() : *(next - 1);
+
+        float span = b.month - a.month;
+        float pos  = month - a.month;
+        if (span <= 0.0f) span += kYear;
+        if (pos < 0.0f) pos += kYear;
+        return a.value + (b.value - a.value) * (pos / span);
+    }
+
+    std::array<SeasonWeatherMultipliers, kMonthsPerYear> BakeMonthMultipliers(const Config& config) {
+        std::array<SeasonWeatherMultipliers, kMonthsPerYear> months;
+        for (std::uint32_t m = 0; m < kMonthsPerYear; ++m) {
+            const auto& seasonMults = config.GetMultipliers(config.GetSeasonForMonth(m));
+            auto& mults = months[m];
+            mults = seasonMults;
+            for (std::size_t wc = 0; wc < config.monthCurves.size(); ++wc) {
+                auto& value = ClassMultiplier(mults, wc);
+                value = SampleMonthCurve(config.monthCurves[wc], static_cast<float>(m), value);
+            }
+        }
+        return months;
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "pch.h"
+#include "Config.h"
+
+#include <array>
+#include <string_view>
+
+namespace SWF {
+
+    // "0:0.3, 6:1.6, 9:0.8" -> keyframes sorted by month. Months are in
+    // [0, 12), values are clamped to [0, 10]; a repeated month keeps the
+    // last value. An empty string gives an empty curve. Returns false
+    // (leaving `out` untouched) on any malformed item.
+    bool ParseMonthCurve(std::string_view text, MonthCurve& out);
+
+    // Inverse of ParseMonthCurve().
+    void FormatMonthCurve(const MonthCurve& curve, std::string& out);
+
+    // Linear interpolation at `month` (fractional, wraps around the year).
+    // `fallback` for an empty curve.
+    float SampleMonthCurve(const MonthCurve& curve, float month, float fallback);
+
+    // One multiplier set per month: each class samples its curve at the
+    // month, or takes that month's season multiplier if its curve is empty.
+    // Computed when a table is built, never per frame.
+    std::array<SeasonWeatherMultipliers, kMonthsPerYear> BakeMonthMultipliers(const Config& config);
+}
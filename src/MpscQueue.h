@@ -0,0 +1,105 @@
+#pragma once
+
+#include "pch.h"
+
+#include <array>
+#include <deque>
+#include <mutex>
+
+namespace SWF {
+
+    // Multi-producer / single-consumer FIFO. Producers claim a cell of a
+    // preallocated ring with one CAS. If the ring is ever full, pushes spill
+    // into a locked overflow list, and every push after that queues behind
+    // the spilled ones until the consumer has emptied the list, so nothing
+    // is dropped or reordered.
+    //
+    // The ring is a Vyukov bounded MPMC ring used with a single consumer: a
+    // cell is free for position p when its sequence is p, and holds a value
+    // for p when its sequence is p + 1.
+    template <class T, std::size_t Capacity>
+    class MpscQueue {
+        static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+    public:
+        MpscQueue() {
+            for (std::size_t i = 0; i < Capacity; ++i) cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+
+        // Any thread.
+        void Push(T value) {
+            if (!overflowing_.load(std::memory_order_acquire) && TryPushRing(value)) return;
+
+            // The ring was full or values are spilled. Under the lock the
+            // flag is exact: with nothing spilled, space the consumer freed
+            // in the meantime is taken; otherwise the value queues behind.
+            std::lock_guard<std::mutex> lock(overflowMutex_);
+            if (!overflowing_.load(std::memory_order_relaxed) && TryPushRing(value)) return;
+            overflow_.push_back(std::move(value));
+            overflowing_.store(true, std::memory_order_release);
+        }
+
+        // Consumer only. False when nothing is ready, including when a
+        // producer has claimed the next cell but not filled it yet; that
+        // producer has not returned from Push(), so it can arrange for the
+        // consumer to look again.
+        bool Pop(T& out) {
+            auto& cell = cells_[dequeuePos_ & (Capacity - 1)];
+            if (cell.sequence.load(std::memory_order_acquire) == dequeuePos_ + 1) {
+                out = std::move(cell.value);
+                cell.sequence.store(dequeuePos_ + Capacity, std::memory_order_release);
+                ++dequeuePos_;
+                return true;
+            }
+
+            // Spilled values were pushed after everything claimed in the
+            // ring, so they wait until the ring is really empty.
+            if (!overflowing_.load(std::memory_order_acquire)) return false;
+            if (enqueuePos_.load(std::memory_order_acquire) != dequeuePos_) return false;
+
+            std::lock_guard<std::mutex> lock(overflowMutex_);
+            if (overflow_.empty()) {
+                // Pushes from here on may use the ring again.
+                overflowing_.store(false, std::memory_order_release);
+                return false;
+            }
+            out = std::move(overflow_.front());
+            overflow_.pop_front();
+            return true;
+        }
+
+    private:
+        struct Cell {
+            std::atomic<std::uint64_t> sequence = 0;
+            T                          value;
+        };
+
+        bool TryPushRing(T& value) {
+            auto pos = enqueuePos_.load(std::memory_order_relaxed);
+            for (;;) {
+                auto& cell = cells_[pos & (Capacity - 1)];
+                auto seq  = cell.sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::int64_t>(seq - pos);
+                if (diff == 0) {
+                    if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_acq_rel)) {
+                        cell.value = std::move(value);
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                } else if (diff < 0) {
+                    return false;   // full: the consumer has not freed this cell yet
+                } else {
+                    pos = enqueuePos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        std::array<Cell, Capacity>             cells_;
+        alignas(64) std::atomic<std::uint64_t> enqueuePos_ = 0;
+        alignas(64) std::uint64_t              dequeuePos_ = 0;   // consumer only
+
+        std::mutex        overflowMutex_;
+        std::deque<T>     overflow_;
+        std::atomic<bool> overflowing_ = false;
+    };
+}
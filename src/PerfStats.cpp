@@ -0,0 +1,121 @@
+#include "PerfStats.h"
+
+#include <bit>
+#include <cmath>
+
+namespace SWF {
+
+    namespace {
+        void UpdateMax(std::atomic<std::uint64_t>& slot, std::uint64_t value) {
+            auto current = slot.load(std::memory_order_relaxed);
+            while (value > current && !slot.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+        }
+
+        // Bucket 0 holds everything under 1 us; bucket 1 + 4*o + s holds
+        // [2^o * (1 + s/4), 2^o * (1 + (s+1)/4)) microseconds.
+        std::size_t BucketOf(std::uint64_t nanos) {
+            auto micros = nanos / 1000;
+            if (micros == 0) return 0;
+
+            auto octave = static_cast<std::size_t>(std::bit_width(micros) - 1);
+            auto sub = octave >= 2 ? (micros >> (octave - 2)) & 3 : (micros << (2 - octave)) & 3;
+            return (std::min)(1 + octave * PerfStats::kBucketsPerOctave + static_cast<std::size_t>(sub),
+                              PerfStats::kBucketCount - 1);
+        }
+
+        double BucketUpperMicros(std::size_t bucket) {
+            if (bucket == 0) return 1.0;
+            auto octave = (bucket - 1) / PerfStats::kBucketsPerOctave;
+            auto sub    = (bucket - 1) % PerfStats::kBucketsPerOctave;
+            return std::ldexp(1.0 + static_cast<double>(sub + 1) / PerfStats::kBucketsPerOctave,
+                              static_cast<int>(octave));
+        }
+    }
+
+    void PerfStats::Record(PerfTimer timer, std::uint64_t nanos) {
+        auto& stats = timers_[static_cast<std::size_t>(timer)];
+        stats.buckets[BucketOf(nanos)].fetch_add(1, std::memory_order_relaxed);
+        stats.count.fetch_add(1, std::memory_order_relaxed);
+        stats.totalNanos.fetch_add(nanos, std::memory_order_relaxed);
+        UpdateMax(stats.maxNanos, nanos);
+
+        if (timer == PerfTimer::kApply) {
+            auto slot = applyCount_.fetch_add(1, std::memory_order_relaxed) % kApplyHistory;
+            applyHistory_[slot].store(static_cast<float>(nanos / 1.0e6), std::memory_order_relaxed);
+        }
+    }
+
+    void PerfStats::NoteBuild(PerfMemory memory, std::size_t bytes) {
+        auto& stats = memory_[static_cast<std::size_t>(memory)];
+        stats.liveBytes.store(bytes, std::memory_order_relaxed);
+        stats.totalBytes.fetch_add(bytes, std::memory_order_relaxed);
+        stats.builds.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    PerfStats::TimerSummary PerfStats::Summarize(PerfTimer timer) const {
+        const auto& stats = timers_[static_cast<std::size_t>(timer)];
+
+        // Buckets are read without a snapshot; a concurrent record can skew
+        // one percentile by a sample, which is fine for a live panel.
+        std::array<std::uint32_t, kBucketCount> buckets;
+        std::uint64_t count = 0;
+        for (std::size_t b = 0; b < kBucketCount; ++b) {
+            buckets[b] = stats.buckets[b].load(std::memory_order_relaxed);
+            count += buckets[b];
+        }
+
+        TimerSummary summary;
+        summary.count     = count;
+        summary.maxMicros = stats.maxNanos.load(std::memory_order_relaxed) / 1000.0;
+        if (count == 0) return summary;
+        summary.meanMicros = stats.totalNanos.load(std::memory_order_relaxed) / 1000.0 /
+                             static_cast<double>(stats.count.load(std::memory_order_relaxed));
+
+        auto percentile = [&](double p) {
+            auto rank = static_cast<std::uint64_t>(std::ceil(p * static_cast<double>(count)));
+            std::uint64_t seen = 0;
+            for (std::size_t b = 0; b < kBucketCount; ++b) {
+                seen += buckets[b];
+                if (seen >= rank) return (std::min)(BucketUpperMicros(b), summary.maxMicros);
+            }
+            return summary.maxMicros;
+        };
+        summary.p50Micros = percentile(0.50);
+        summary.p99Micros = percentile(0.99);
+        return summary;
+    }
+
+    PerfStats::MemorySummary PerfStats::GetMemory(PerfMemory memory) const {
+        const auto& stats = memory_[static_cast<std::size_t>(memory)];
+        MemorySummary summary;
+        summary.liveBytes  = stats.liveBytes.load(std::memory_order_relaxed);
+        summary.totalBytes = stats.totalBytes.load(std::memory_order_relaxed);
+        summary.builds     = stats.builds.load(std::memory_order_relaxed);
+        return summary;
+    }
+
+    std::size_t PerfStats::GetApplyHistory(std::array<float, kApplyHistory>& out) const {
+        auto total = applyCount_.load(std::memory_order_relaxed);
+        auto count = static_cast<std::size_t>((std::min<std::uint64_t>)(total, kApplyHistory));
+        auto first = total - count;
+        for (std::size_t i = 0; i < count; ++i) {
+            out[i] = applyHistory_[(first + i) % kApplyHistory].load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    void PerfStats::Reset() {
+        for (auto& stats : timers_) {
+            for (auto& bucket : stats.buckets) bucket.store(0, std::memory_order_relaxed);
+            stats.count.store(0, std::memory_order_relaxed);
+            stats.totalNanos.store(0, std::memory_order_relaxed);
+            stats.maxNanos.store(0, std::memory_order_relaxed);
+        }
+        for (auto& event : events_) event.store(0, std::memory_order_relaxed);
+        for (auto& stats : memory_) {
+            stats.totalBytes.store(0, std::memory_order_relaxed);
+            stats.builds.store(0, std::memory_order_relaxed);
+        }
+        applyCount_.store(0, std::memory_order_relaxed);
+    }
+}
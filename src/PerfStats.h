@@ -0,0 +1,172 @@
+#pragma once
+
+#include "pch.h"
+
+#include <array>
+#include <chrono>
+
+namespace SWF {
+
+    // Timed hot paths.
+    enum class PerfTimer : std::uint32_t {
+        kScan       = 0,  // RegionScanner::ScanAllRegions
+        kInject     = 1,  // RegionScanner::InjectMissingWeathers
+        kTableBuild = 2,  // ChanceTable::Build / WithUpdatedClasses
+        kApply      = 3,  // WeatherManager::ApplyPartition
+        kUpdate     = 4,  // WeatherManager::Update
+        kMenuRender = 5,  // one menu tab callback
+
+        kTotal      = 6
+    };
+
+    inline const char* PerfTimerToString(PerfTimer timer) {
+        switch (timer) {
+            case PerfTimer::kScan:       return "Scan";
+            case PerfTimer::kInject:     return "Inject";
+            case PerfTimer::kTableBuild: return "Table build";
+            case PerfTimer::kApply:      return "Apply";
+            case PerfTimer::kUpdate:     return "Update";
+            case PerfTimer::kMenuRender: return "Menu render";
+            default:                     return "Unknown";
+        }
+    }
+
+    // Counted event sources.
+    enum class PerfEvent : std::uint32_t {
+        kPlayerUpdate  = 0,  // PlayerCharacter::Update hook
+        kRegionSample  = 1,  // RegionTracker samples
+        kRegionChange  = 2,  // RegionTracker change events
+        kMenuOpenClose = 3,  // MenuOpenCloseEvent sink
+        kSkseMessage   = 4,  // SKSE messaging listener
+        kConfigReload  = 5,  // ConfigWatcher reloads
+        kCommand       = 6,  // CommandQueue commands drained
+
+        kTotal         = 7
+    };
+
+    inline const char* PerfEventToString(PerfEvent event) {
+        switch (event) {
+            case PerfEvent::kPlayerUpdate:  return "Player update hook";
+            case PerfEvent::kRegionSample:  return "Region samples";
+            case PerfEvent::kRegionChange:  return "Region changes";
+            case PerfEvent::kMenuOpenClose: return "MenuOpenCloseEvent";
+            case PerfEvent::kSkseMessage:   return "SKSE messages";
+            case PerfEvent::kConfigReload:  return "Config reloads";
+            case PerfEvent::kCommand:       return "Menu commands";
+            default:                        return "Unknown";
+        }
+    }
+
+    // Structures whose builds allocate in bulk.
+    enum class PerfMemory : std::uint32_t {
+        kChanceTable  = 0,
+        kRegionSearch = 1,
+        kMenuView     = 2,
+
+        kTotal        = 3
+    };
+
+    inline const char* PerfMemoryToString(PerfMemory memory) {
+        switch (memory) {
+            case PerfMemory::kChanceTable:  return "Chance tables";
+            case PerfMemory::kRegionSearch: return "Region search index";
+            case PerfMemory::kMenuView:     return "Menu view";
+            default:                        return "Unknown";
+        }
+    }
+
+    // Always-on, lock-free counters for the Debug tab. Recording is a few
+    // relaxed atomic adds, so it is safe on the game thread every frame.
+    // Durations land in log-spaced buckets (four per octave from 1 us), which
+    // is what the percentiles are read from, so they are accurate to ~19%.
+    class PerfStats {
+    public:
+        static PerfStats& GetSingleton() {
+            static PerfStats instance;
+            return instance;
+        }
+
+        static constexpr std::size_t kBucketsPerOctave = 4;
+        static constexpr std::size_t kBucketCount      = 26 * kBucketsPerOctave;   // 1 us .. ~67 s
+        static constexpr std::size_t kApplyHistory     = 64;
+
+        void Record(PerfTimer timer, std::uint64_t nanos);
+        void Count(PerfEvent event, std::uint64_t n = 1) {
+            events_[static_cast<std::size_t>(event)].fetch_add(n, std::memory_order_relaxed);
+        }
+        // A finished build of `memory` that allocated `bytes`; replaces the live size.
+        void NoteBuild(PerfMemory memory, std::size_t bytes);
+
+        struct TimerSummary {
+            std::uint64_t count     = 0;
+            double        meanMicros = 0.0;
+            double        p50Micros  = 0.0;
+            double        p99Micros  = 0.0;
+            double        maxMicros  = 0.0;
+        };
+        TimerSummary Summarize(PerfTimer timer) const;
+
+        std::uint64_t GetEventCount(PerfEvent event) const {
+            return events_[static_cast<std::size_t>(event)].load(std::memory_order_relaxed);
+        }
+
+        struct MemorySummary {
+            std::uint64_t liveBytes  = 0;   // last build
+            std::uint64_t totalBytes = 0;   // every build since start or reset
+            std::uint64_t builds     = 0;
+        };
+        MemorySummary GetMemory(PerfMemory memory) const;
+
+        // Apply durations in milliseconds, oldest first. Returns the count.
+        std::size_t GetApplyHistory(std::array<float, kApplyHistory>& out) const;
+
+        // Clears timers, events and allocation totals (live sizes are kept).
+        void Reset();
+
+    private:
+        PerfStats() = default;
+        ~PerfStats() = default;
+        PerfStats(const PerfStats&) = delete;
+        PerfStats& operator=(const PerfStats&) = delete;
+
+        struct TimerStats {
+            std::array<std::atomic<std::uint32_t>, kBucketCount> buckets{};
+            std::atomic<std::uint64_t> count      = 0;
+            std::atomic<std::uint64_t> totalNanos = 0;
+            std::atomic<std::uint64_t> maxNanos   = 0;
+        };
+
+        struct MemoryStats {
+            std::atomic<std::uint64_t> liveBytes  = 0;
+            std::atomic<std::uint64_t> totalBytes = 0;
+            std::atomic<std::uint64_t> builds     = 0;
+        };
+
+        std::array<TimerStats, std::size_t(PerfTimer::kTotal)>                  timers_;
+        std::array<std::atomic<std::uint64_t>, std::size_t(PerfEvent::kTotal)>  events_{};
+        std::array<MemoryStats, std::size_t(PerfMemory::kTotal)>                memory_;
+
+        std::array<std::atomic<float>, kApplyHistory> applyHistory_{};
+        std::atomic<std::uint64_t>                    applyCount_ = 0;
+    };
+
+    // Records the lifetime of the scope under `timer`.
+    class PerfScope {
+    public:
+        explicit PerfScope(PerfTimer timer) : timer_(timer), start_(Clock::now()) {}
+
+        ~PerfScope() {
+            auto nanos = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start_).count();
+            PerfStats::GetSingleton().Record(timer_, static_cast<std::uint64_t>(nanos));
+        }
+
+        PerfScope(const PerfScope&) = delete;
+        PerfScope& operator=(const PerfScope&) = delete;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        PerfTimer         timer_;
+        Clock::time_point start_;
+    };
+}
@@ -0,0 +1,564 @@
+#include "PresetStore.h"
+#include "ConfigSchema.h"
+#include "ConfigWatcher.h"
+#include "EntryOverrides.h"
+#include "IniParser.h"
+#include "MonthCurves.h"
+#include "RegionScanner.h"
+#include "WeatherManager.h"
+#include "WorkerPool.h"
+
+#include <chrono>
+#include <cstring>
+
+namespace SWF {
+
+    namespace {
+        constexpr std::uint64_t kFnvOffset = 14695981039346656037ull;
+        constexpr std::uint64_t kFnvPrime  = 1099511628211ull;
+
+        std::uint64_t Fnv1a64(std::string_view bytes, std::uint64_t hash = kFnvOffset) {
+            for (char c : bytes) {
+                hash ^= static_cast<std::uint8_t>(c);
+                hash *= kFnvPrime;
+            }
+            return hash;
+        }
+
+        template <class T>
+        void HashValue(std::uint64_t& hash, const T& value) {
+            hash = Fnv1a64({ reinterpret_cast<const char*>(&value), sizeof(T) }, hash);
+        }
+
+        // Type tag stored with every config record so unknown records can be skipped.
+        enum class RecordType : std::uint8_t {
+            kBool       = 0,
+            kUInt       = 1,
+            kFloat      = 2,
+            kStringList = 3,
+            kIniSection = 4,   // u32 length + "key = value" lines of a dynamic section
+            kCurve      = 5    // u32 count + (month, value) float pairs
+        };
+
+        class ByteWriter {
+        public:
+            template <class T>
+            void Put(T value) {
+                static_assert(std::is_trivially_copyable_v<T>);
+                bytes.append(reinterpret_cast<const char*>(&value), sizeof(T));
+            }
+
+            void PutString(std::string_view str) {
+                Put(static_cast<std::uint16_t>(str.size()));
+                bytes.append(str.data(), str.size());
+            }
+
+            void PutText(std::string_view str) {
+                Put(static_cast<std::uint32_t>(str.size()));
+                bytes.append(str.data(), str.size());
+            }
+
+            void PutFloats(const std::vector<float>& values) {
+                Put(static_cast<std::uint32_t>(values.size()));
+                bytes.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(float));
+            }
+
+            std::string bytes;
+        };
+
+        // Bounds-checked reader; once a read fails every later read fails too.
+        class ByteReader {
+        public:
+            explicit ByteReader(std::string_view data) : data_(data) {}
+
+            template <class T>
+            bool Get(T& value) {
+                if (!ok_ || data_.size() < sizeof(T)) return ok_ = false;
+                std::memcpy(&value, data_.data(), sizeof(T));
+                data_.remove_prefix(sizeof(T));
+                return true;
+            }
+
+            bool GetString(std::string& out) {
+                std::uint16_t size = 0;
+                if (!Get(size) || data_.size() < size) return ok_ = false;
+                out.assign(data_.data(), size);
+                data_.remove_prefix(size);
+                return true;
+            }
+
+            bool GetText(std::string& out) {
+                std::uint32_t size = 0;
+                if (!Get(size) || data_.size() < size) return ok_ = false;
+                out.assign(data_.data(), size);
+                data_.remove_prefix(size);
+                return true;
+            }
+
+            bool GetFloats(std::vector<float>& out) {
+                std::uint32_t count = 0;
+                if (!Get(count) || data_.size() / sizeof(float) < count) return ok_ = false;
+                out.resize(count);
+                std::memcpy(out.data(), data_.data(), count * sizeof(float));
+                data_.remove_prefix(count * sizeof(float));
+                return true;
+            }
+
+            void Fail() { ok_ = false; }
+            bool Ok() const { return ok_; }
+            std::size_t Remaining() const { return data_.size(); }
+            std::string_view Rest() const { return data_; }
+
+        private:
+            std::string_view data_;
+            bool             ok_ = true;
+        };
+
+        // No default: a new FieldType must pick its record type here.
+        RecordType GetRecordType(FieldType type) {
+            switch (type) {
+                case FieldType::kBool:             return RecordType::kBool;
+                case FieldType::kUInt:             return RecordType::kUInt;
+                case FieldType::kFloat:            return RecordType::kFloat;
+                case FieldType::kCurve:            return RecordType::kCurve;
+                case FieldType::kWorldspaceList:   return RecordType::kStringList;
+                case FieldType::kWorldspaceToggle: return RecordType::kStringList;   // not saved; edits the list
+            }
+            return RecordType::kStringList;
+        }
+
+        std::string SanitizePresetName(std::string_view name) {
+            std::string result;
+            for (char c : TrimView(name)) {
+                bool allowed = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                               c == ' ' || c == '-' || c == '_';
+                if (allowed) result += c;
+            }
+            return result;
+        }
+    }
+
+    std::filesystem::path PresetStore::GetPresetDirectory() const {
+        return ConfigManager::GetDropInDirectory(ConfigManager::GetSingleton().GetConfigPath()) / "Presets";
+    }
+
+    std::uint64_t PresetStore::GetFingerprint() const {
+        std::call_once(fingerprintOnce_, [this]() { fingerprint_ = ComputeLoadOrderFingerprint(); });
+        return fingerprint_;
+    }
+
+    std::uint64_t PresetStore::ComputeLoadOrderFingerprint() {
+        std::uint64_t hash = kFnvOffset;
+        auto* dataHandler = RE::TESDataHandler::GetSingleton();
+        if (!dataHandler) return hash;
+
+        // Full and light plugins in load order; their order decides every FormID.
+        for (auto* file : dataHandler->compiledFileCollection.files) {
+            if (file) hash = Fnv1a64(file->GetFilename(), hash);
+            HashValue(hash, std::uint8_t{ 0 });
+        }
+        HashValue(hash, std::uint8_t{ 1 });
+        for (auto* file : dataHandler->compiledFileCollection.smallFiles) {
+            if (file) hash = Fnv1a64(file->GetFilename(), hash);
+            HashValue(hash, std::uint8_t{ 0 });
+        }
+        return hash;
+    }
+
+    std::uint64_t PresetStore::ComputeLayoutHash(const std::vector<RegionWeatherInfo>& regionInfos) {
+        // ChanceTable slots are positional, so the region order and each
+        // region's entry list (injected ones included) must match exactly.
+        std::uint64_t hash = kFnvOffset;
+        for (const auto& info : regionInfos) {
+            HashValue(hash, info.region ? info.region->GetFormID() : RE::FormID{ 0 });
+            HashValue(hash, static_cast<std::uint32_t>(info.originalWeatherEntries.size()));
+            for (const auto& entry : info.originalWeatherEntries) {
+                HashValue(hash, entry.weather ? entry.weather->GetFormID() : RE::FormID{ 0 });
+            }
+        }
+        return hash;
+    }
+
+    std::string PresetStore::Encode(const Config& config, const ChanceTable& table,
+                                    std::uint64_t fingerprint, std::uint64_t layoutHash) {
+        ByteWriter payload;
+
+        auto savedFields = static_cast<std::uint32_t>(std::ranges::count_if(kConfigSchema,
+            [](const FieldDesc& f) { return f.IsSaved(); }));
+        auto dynamicSections = GetDynamicSections();
+        payload.Put(static_cast<std::uint32_t>(savedFields + dynamicSections.size()));
+
+        for (const auto& field : kConfigSchema) {
+            if (!field.IsSaved()) continue;
+
+            auto type = GetRecordType(field.type);
+            payload.Put(HashIniKey(0, field.section, field.key));
+            payload.Put(type);
+
+            switch (type) {
+                case RecordType::kBool:
+                    payload.Put(static_cast<std::uint32_t>(field.Get<bool>(config) ? 1 : 0));
+                    break;
+                case RecordType::kUInt:
+                    payload.Put(field.Get<std::uint32_t>(config));
+                    break;
+                case RecordType::kFloat:
+                    payload.Put(field.Get<float>(config));
+                    break;
+                case RecordType::kStringList: {
+                    // Sorted so identical configs produce identical files.
+                    std::vector<std::string_view> names(config.enabledWorldspaces.begin(),
+                                                        config.enabledWorldspaces.end());
+                    std::ranges::sort(names);
+                    payload.Put(static_cast<std::uint32_t>(names.size()));
+                    for (auto name : names) payload.PutString(name);
+                    break;
+                }
+                case RecordType::kCurve: {
+                    std::vector<float> flat;
+                    for (const auto& key : field.Get<MonthCurve>(config).keyframes) {
+                        flat.push_back(key.month);
+                        flat.push_back(key.value);
+                    }
+                    payload.PutFloats(flat);
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+
+        for (const auto& section : dynamicSections) {
+            std::string text;
+            section.write(config, text, false);
+            payload.Put(HashIniKey(0, section.section, ""));
+            payload.Put(RecordType::kIniSection);
+            payload.PutText(text);
+        }
+
+        payload.Put(static_cast<std::uint32_t>(table.regions.size()));
+        for (const auto& slot : table.regions) {
+            payload.Put(slot.firstEntry);
+            payload.Put(slot.entryCount);
+            payload.Put(static_cast<std::uint8_t>(slot.managed ? 1 : 0));
+        }
+        for (const auto& weights : table.weights) {
+            payload.PutFloats(weights);
+        }
+
+        // Month slots (version 3+): 0 when the table was built without month curves.
+        payload.Put(static_cast<std::uint8_t>(table.HasMonthWeights() ? kMonthsPerYear : 0));
+        if (table.HasMonthWeights()) {
+            for (const auto& weights : table.monthWeights) payload.PutFloats(weights);
+        }
+
+        ByteWriter file;
+        file.Put(kMagic);
+        file.Put(kVersion);
+        file.Put(std::uint16_t{ 0 });
+        file.Put(static_cast<std::uint32_t>(payload.bytes.size()));
+        file.Put(Fnv1a64(payload.bytes));
+        file.Put(fingerprint);
+        file.Put(layoutHash);
+        file.bytes += payload.bytes;
+        return std::move(file.bytes);
+    }
+
+    std::shared_ptr<Preset> PresetStore::Decode(const std::filesystem::path& path, std::string_view bytes,
+                                                std::uint64_t currentLayout) const {
+        auto fileName = path.filename().string();
+        ByteReader reader(bytes);
+
+        std::uint32_t magic = 0, payloadSize = 0;
+        std::uint16_t version = 0, reserved = 0;
+        std::uint64_t checksum = 0, fingerprint = 0, layoutHash = 0;
+        reader.Get(magic);
+        reader.Get(version);
+        reader.Get(reserved);
+        reader.Get(payloadSize);
+        reader.Get(checksum);
+        reader.Get(fingerprint);
+        reader.Get(layoutHash);
+
+        if (!reader.Ok() || magic != kMagic) {
+            logs::warn("PresetStore: {} is not a preset file, ignored", fileName);
+            return nullptr;
+        }
+        if (version < kMinVersion || version > kVersion) {
+            logs::warn("PresetStore: {} has format version {} (expected {}-{}), ignored", fileName, version,
+                kMinVersion, kVersion);
+            return nullptr;
+        }
+        if (reader.Remaining() != payloadSize || Fnv1a64(reader.Rest()) != checksum) {
+            logs::warn("PresetStore: {} failed its checksum (truncated or corrupted), ignored", fileName);
+            return nullptr;
+        }
+
+        // Fields missing from the file keep their defaults.
+        auto config = std::make_shared<Config>();
+
+        std::uint32_t recordCount = 0;
+        reader.Get(recordCount);
+        for (std::uint32_t r = 0; r < recordCount && reader.Ok(); ++r) {
+            std::uint32_t keyHash = 0;
+            RecordType type{};
+            reader.Get(keyHash);
+            reader.Get(type);
+
+            const FieldDesc* field = nullptr;
+            for (const auto& f : kConfigSchema) {
+                if (f.IsSaved() && GetRecordType(f.type) == type && HashIniKey(0, f.section, f.key) == keyHash) {
+                    field = &f;
+                    break;
+                }
+            }
+
+            switch (type) {
+                case RecordType::kBool:
+                case RecordType::kUInt: {
+                    std::uint32_t value = 0;
+                    reader.Get(value);
+                    if (field) SetConfigField(*config, *field, static_cast<float>(value));
+                    break;
+                }
+                case RecordType::kFloat: {
+                    float value = 0.0f;
+                    reader.Get(value);
+                    if (field) SetConfigField(*config, *field, value);
+                    break;
+                }
+                case RecordType::kStringList: {
+                    std::uint32_t count = 0;
+                    reader.Get(count);
+                    if (field) config->enabledWorldspaces.clear();
+                    std::string name;
+                    for (std::uint32_t i = 0; i < count && reader.GetString(name); ++i) {
+                        if (field) config->enabledWorldspaces.insert(name);
+                    }
+                    break;
+                }
+                case RecordType::kCurve: {
+                    std::vector<float> flat;
+                    reader.GetFloats(flat);
+                    if (!field || flat.size() % 2 != 0) break;
+
+                    // Re-parse so the file gets the same validation as the INI.
+                    std::string text;
+                    for (std::size_t i = 0; i < flat.size(); i += 2) {
+                        std::format_to(std::back_inserter(text), "{}{}:{}", i ? "," : "", flat[i], flat[i + 1]);
+                    }
+                    ParseMonthCurve(text, field->Get<MonthCurve>(*config));
+                    break;
+                }
+                case RecordType::kIniSection: {
+                    std::string text;
+                    reader.GetText(text);
+
+                    const DynamicSectionDesc* section = nullptr;
+                    for (const auto& s : GetDynamicSections()) {
+                        if (HashIniKey(0, s.section, "") == keyHash) section = &s;
+                    }
+                    if (!section) break;
+
+                    section->clear(*config);
+                    TokenizeIni(text,
+                        [&](const IniEntry& entry) {
+                            if (!entry.key.empty()) section->parse(*config, entry.key, entry.value, {});
+                        },
+                        [](std::string_view, std::uint32_t) {});
+                    break;
+                }
+                default:
+                    // Unknown record types cannot be skipped safely.
+                    logs::warn("PresetStore: {} has an unknown record type {}, ignored", fileName,
+                        static_cast<std::uint32_t>(type));
+                    return nullptr;
+            }
+        }
+
+        auto table = std::make_shared<ChanceTable>();
+        std::uint32_t regionCount = 0;
+        reader.Get(regionCount);
+        if (reader.Ok() && regionCount <= reader.Remaining() / 9) {
+            table->regions.resize(regionCount);
+            for (auto& slot : table->regions) {
+                std::uint8_t managed = 0;
+                reader.Get(slot.firstEntry);
+                reader.Get(slot.entryCount);
+                reader.Get(managed);
+                slot.managed = managed != 0;
+            }
+        } else {
+            reader.Fail();
+        }
+        for (auto& weights : table->weights) {
+            reader.GetFloats(weights);
+        }
+        if (version >= 3) {
+            std::uint8_t monthSlots = 0;
+            reader.Get(monthSlots);
+            if (monthSlots == kMonthsPerYear) {
+                for (auto& weights : table->monthWeights) reader.GetFloats(weights);
+                table->hasMonthWeights = true;
+            } else if (monthSlots != 0) {
+                reader.Fail();
+            }
+        }
+
+        if (!reader.Ok()) {
+            logs::warn("PresetStore: {} is malformed, ignored", fileName);
+            return nullptr;
+        }
+
+        // Slots must stay inside the weight arrays.
+        auto entryCount = table->weights[0].size();
+        bool consistent = std::ranges::all_of(table->weights, [&](const auto& w) { return w.size() == entryCount; }) &&
+                          (!table->HasMonthWeights() || std::ranges::all_of(table->monthWeights,
+                              [&](const auto& w) { return w.size() == entryCount; })) &&
+                          std::ranges::all_of(table->regions, [&](const ChanceTable::RegionSlot& s) {
+                              return std::size_t{ s.firstEntry } + s.entryCount <= entryCount;
+                          });
+        if (!consistent) {
+            logs::warn("PresetStore: {} has an inconsistent chance table, ignored", fileName);
+            return nullptr;
+        }
+
+        auto preset = std::make_shared<Preset>();
+        preset->name       = path.stem().string();
+        preset->path       = path;
+        preset->config     = std::move(config);
+        preset->layoutHash = layoutHash;
+        preset->fileBytes  = static_cast<std::uint32_t>(bytes.size());
+
+        // A table written under another load order or region layout would
+        // put weights on the wrong entries; keep only the config.
+        if (fingerprint != GetFingerprint() || layoutHash != currentLayout) {
+            preset->stale = true;
+            logs::info("PresetStore: {} was saved with a different load order or region layout; "
+                "its chance table will be recomputed on apply", fileName);
+        } else {
+            preset->table = std::move(table);
+        }
+
+        return preset;
+    }
+
+    void PresetStore::RequestRefresh() {
+        auto currentLayout = ComputeLayoutHash(RegionScanner::GetSingleton().GetRegionWeatherInfos());
+        if (!WorkerPool::GetSingleton().Submit(TaskPriority::kNormal, "Load presets",
+                [this, currentLayout]() { Refresh(currentLayout); })) {
+            Refresh(currentLayout);
+        }
+    }
+
+    void PresetStore::Refresh(std::uint64_t currentLayout) {
+        auto start = std::chrono::steady_clock::now();
+        auto dir = GetPresetDirectory();
+
+        auto list = std::make_shared<PresetList>();
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+            if (!entry.is_regular_file(ec) || entry.path().extension() != ".swfp") continue;
+
+            MappedFile file(entry.path());
+            if (!file.IsOpen()) continue;
+            if (auto preset = Decode(entry.path(), file.GetView(), currentLayout)) {
+                list->push_back(std::move(preset));
+            }
+        }
+
+        std::ranges::sort(*list, [](const auto& a, const auto& b) { return a->name < b->name; });
+
+        auto stale = std::ranges::count_if(*list, [](const auto& p) { return p->stale; });
+        auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        logs::info("PresetStore: Loaded {} presets ({} stale) from {} in {:.3f} ms",
+            list->size(), stale, dir.string(), ms);
+
+        presets_.store(std::move(list), std::memory_order_release);
+    }
+
+    bool PresetStore::Apply(std::string_view name) {
+        auto start = std::chrono::steady_clock::now();
+
+        auto list = GetPresets();
+        std::shared_ptr<const Preset> preset;
+        if (list) {
+            auto it = std::ranges::find_if(*list, [&](const auto& p) { return p->name == name; });
+            if (it != list->end()) preset = *it;
+        }
+        if (!preset) {
+            logs::warn("PresetStore: No preset named '{}'", name);
+            return false;
+        }
+
+        auto& configManager = ConfigManager::GetSingleton();
+        auto& scanner = RegionScanner::GetSingleton();
+        auto& wm = WeatherManager::GetSingleton();
+        auto& config = configManager.GetConfig();
+
+        bool worldspacesChanged = config.enabledWorldspaces != preset->config->enabledWorldspaces;
+        config = *preset->config;
+        configManager.BumpVersion();
+
+        if (worldspacesChanged) {
+            // Newly enabled worldspaces need pools and injected entries first.
+            scanner.BuildWorldspacePools();
+            scanner.InjectMissingWeathers();
+        }
+
+        // Injection can change the region layout; only swap in the stored
+        // table if it still lines up with the live records.
+        bool swapped = false;
+        if (preset->table && (!config.useMonthCurves || preset->table->HasMonthWeights()) &&
+            ComputeLayoutHash(scanner.GetRegionWeatherInfos()) == preset->layoutHash) {
+            auto table = std::make_shared<ChanceTable>(*preset->table);
+            ChanceTable::BuildPartitions(*table, scanner.GetRegionWeatherInfos(), config);
+            table->configVersion  = configManager.GetVersion();
+            table->scanGeneration = scanner.GetGeneration();
+            // The stored weights already carry the CSV values it was saved with.
+            if (auto entries = EntryOverrideIndex::GetSingleton().Get(table->scanGeneration)) {
+                table->entryImport = entries->importId;
+            }
+            wm.InstallChanceTable(std::move(table));
+            swapped = true;
+        }
+
+        ConfigWatcher::GetSingleton().Sync(config.hotReload);
+
+        wm.ForceRefresh();
+        wm.Update();
+
+        auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        logs::info("PresetStore: Applied preset '{}' in {:.3f} ms ({})", preset->name, ms,
+            swapped ? "stored chance table" : "chance table recomputed");
+        return true;
+    }
+
+    void PresetStore::SaveCurrent(std::string name) {
+        name = SanitizePresetName(name);
+        if (name.empty()) {
+            logs::warn("PresetStore: Preset name is empty after removing unsupported characters");
+            return;
+        }
+
+        auto config = std::make_shared<const Config>(ConfigManager::GetSingleton().GetConfig());
+        auto table = WeatherManager::GetSingleton().EnsureChanceTable();
+        auto layoutHash = ComputeLayoutHash(RegionScanner::GetSingleton().GetRegionWeatherInfos());
+        auto path = GetPresetDirectory() / (name + ".swfp");
+
+        auto write = [this, config, table, layoutHash, path]() {
+            std::error_code ec;
+            std::filesystem::create_directories(path.parent_path(), ec);
+
+            auto bytes = Encode(*config, *table, GetFingerprint(), layoutHash);
+            if (!WriteFileAtomic(path, bytes)) return;
+
+            logs::info("PresetStore: Saved preset {} ({} bytes)", path.filename().string(), bytes.size());
+            Refresh(layoutHash);
+        };
+
+        if (!WorkerPool::GetSingleton().Submit(TaskPriority::kLow, "Save preset", write)) {
+            write();
+        }
+    }
+}
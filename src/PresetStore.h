@@ -0,0 +1,99 @@
+#pragma once
+
+#include "pch.h"
+#include "ChanceTable.h"
+#include "Config.h"
+
+#include <memory>
+
+namespace SWF {
+
+    struct RegionWeatherInfo;
+
+    // A named weather profile: a full config plus the per-season chance
+    // table computed from it. The table is only usable if the preset was
+    // written with the same load order and region layout as this session.
+    struct Preset {
+        std::string                        name;
+        std::filesystem::path              path;
+        std::shared_ptr<const Config>      config;
+        std::shared_ptr<const ChanceTable> table;   // null if stale (rebuilt from config on apply)
+        std::uint64_t                      layoutHash = 0;
+        std::uint32_t                      fileBytes  = 0;
+        bool                               stale      = false;
+    };
+
+    using PresetList = std::vector<std::shared_ptr<const Preset>>;
+
+    // Binary presets in <plugin dir>/SeasonalWeatherFramework/Presets/*.swfp.
+    //
+    // File layout (little endian):
+    //   header  : magic "SWFP", u16 version, u16 reserved, u32 payload size,
+    //             u64 FNV-1a of the payload, u64 load-order fingerprint,
+    //             u64 region-layout hash
+    //   payload : config records keyed by HashIniKey(section, key), so
+    //             fields added later are skipped by older readers, then the
+    //             chance table (region slots, then weights per season).
+    //             Dynamic INI sections ([RegionOverrides]) are stored as
+    //             their INI text under HashIniKey(section, "") (version 2+).
+    //
+    // A bad magic, version, size or checksum rejects the file. A
+    // fingerprint or layout mismatch keeps the config but drops the table.
+    class PresetStore {
+    public:
+        static PresetStore& GetSingleton() {
+            static PresetStore instance;
+            return instance;
+        }
+
+        static constexpr std::uint32_t kMagic   = 0x50465753;  // "SWFP"
+        static constexpr std::uint16_t kVersion    = 3;
+        static constexpr std::uint16_t kMinVersion = 1;  // oldest version still read
+
+        // Hashes the live region layout, then re-reads every preset file
+        // on the worker pool. Game thread: the hash reads the region infos.
+        void RequestRefresh();
+
+        // Re-read every preset file, keeping stored tables whose layout hash
+        // is `currentLayout`. Any thread; touches no game data.
+        void Refresh(std::uint64_t currentLayout);
+
+        // Snapshot of the loaded presets, sorted by name. Safe from any thread.
+        std::shared_ptr<const PresetList> GetPresets() const {
+            return presets_.load(std::memory_order_acquire);
+        }
+
+        // Make the named preset the live config and chance table. With a
+        // valid table this is a pointer swap followed by a delta write.
+        // Game thread.
+        bool Apply(std::string_view name);
+
+        // Write the live config and chance table as a preset. The snapshot
+        // and layout hash are taken on the calling (game) thread; encoding
+        // and I/O run on the worker pool, followed by a Refresh().
+        void SaveCurrent(std::string name);
+
+        std::filesystem::path GetPresetDirectory() const;
+
+    private:
+        PresetStore() = default;
+        ~PresetStore() = default;
+        PresetStore(const PresetStore&) = delete;
+        PresetStore& operator=(const PresetStore&) = delete;
+
+        static std::uint64_t ComputeLoadOrderFingerprint();
+        static std::uint64_t ComputeLayoutHash(const std::vector<RegionWeatherInfo>& regionInfos);
+
+        static std::string Encode(const Config& config, const ChanceTable& table,
+                                  std::uint64_t fingerprint, std::uint64_t layoutHash);
+        std::shared_ptr<Preset> Decode(const std::filesystem::path& path, std::string_view bytes,
+                                       std::uint64_t currentLayout) const;
+
+        std::atomic<std::shared_ptr<const PresetList>> presets_;
+
+        // Fixed for the session once data is loaded.
+        std::uint64_t  GetFingerprint() const;
+        mutable std::uint64_t  fingerprint_ = 0;
+        mutable std::once_flag fingerprintOnce_;
+    };
+}
@@ -0,0 +1,359 @@
+#include "RegionOverrides.h"
+#include "IniParser.h"
+#include "RegionScanner.h"
+#include "WorkerPool.h"
+
+#include <chrono>
+#include <map>
+#include <optional>
+#include <regex>
+#include <unordered_map>
+
+namespace SWF {
+
+    namespace {
+        constexpr float kMaxMultiplier = 10.0f;
+
+        // Regions handed to one ParallelFor task during compilation.
+        constexpr std::size_t kRegionsPerTask = 512;
+
+        char ToLower(char c) {
+            return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+        }
+
+        std::string ToLower(std::string_view str) {
+            std::string result(str);
+            for (auto& c : result) c = ToLower(c);
+            return result;
+        }
+
+        bool EqualsIgnoreCase(std::string_view a, std::string_view b) {
+            return a.size() == b.size() &&
+                   std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) { return ToLower(x) == ToLower(y); });
+        }
+
+        // Bit per WeatherClass (kUnknown excluded); 0 for an unknown name.
+        std::uint32_t ParseClassMask(std::string_view name) {
+            if (name == "*") return (1u << MultiplierOverride::kClasses) - 1;
+            for (std::uint32_t c = 0; c < MultiplierOverride::kClasses; ++c) {
+                if (EqualsIgnoreCase(name, WeatherClassToString(static_cast<WeatherClass>(c)))) return 1u << c;
+            }
+            return 0;
+        }
+
+        enum class PatternKind { kRegionGlob, kRegionRegex, kWorldspaceGlob };
+
+        // A rule pattern prepared for matching. Globs are lowercased and
+        // carry their longest literal run, which is checked with a plain
+        // substring search before the glob itself runs.
+        struct CompiledPattern {
+            PatternKind               kind = PatternKind::kRegionGlob;
+            std::string               glob;
+            std::string               literal;
+            std::optional<std::regex> regex;
+        };
+
+        std::string LongestLiteral(std::string_view glob) {
+            std::string_view best;
+            while (!glob.empty()) {
+                auto wild = glob.find_first_of("*?");
+                auto run = glob.substr(0, wild);
+                if (run.size() > best.size()) best = run;
+                if (wild == std::string_view::npos) break;
+                glob.remove_prefix(wild + 1);
+            }
+            return std::string(best);
+        }
+
+        bool CompilePattern(std::string_view pattern, CompiledPattern& out) {
+            if (pattern.starts_with("re:")) {
+                try {
+                    out.kind = PatternKind::kRegionRegex;
+                    out.regex.emplace(std::string(pattern.substr(3)),
+                                      std::regex::ECMAScript | std::regex::icase | std::regex::optimize);
+                } catch (const std::regex_error&) {
+                    return false;
+                }
+                return true;
+            }
+
+            if (pattern.starts_with("ws:")) {
+                out.kind = PatternKind::kWorldspaceGlob;
+                pattern.remove_prefix(3);
+            } else {
+                out.kind = PatternKind::kRegionGlob;
+            }
+            if (pattern.empty()) return false;
+
+            out.glob    = ToLower(pattern);
+            out.literal = LongestLiteral(out.glob);
+            return true;
+        }
+
+        // '*' matches any run, '?' one character. Linear backtracking over
+        // the last '*' only, so no pattern can blow up.
+        bool GlobMatch(std::string_view pattern, std::string_view text) {
+            std::size_t p = 0, t = 0;
+            std::size_t star = std::string_view::npos, mark = 0;
+            while (t < text.size()) {
+                if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == text[t])) {
+                    ++p;
+                    ++t;
+                } else if (p < pattern.size() && pattern[p] == '*') {
+                    star = p++;
+                    mark = t;
+                } else if (star != std::string_view::npos) {
+                    p = star + 1;
+                    t = ++mark;
+                } else {
+                    return false;
+                }
+            }
+            while (p < pattern.size() && pattern[p] == '*') ++p;
+            return p == pattern.size();
+        }
+
+        bool Matches(const CompiledPattern& pattern, const RegionWeatherInfo& info,
+                     std::string_view lowerRegion, std::string_view lowerWorldspace) {
+            switch (pattern.kind) {
+                case PatternKind::kRegionRegex:
+                    return std::regex_search(info.editorID, *pattern.regex);
+                case PatternKind::kRegionGlob:
+                    return lowerRegion.find(pattern.literal) != std::string_view::npos &&
+                           GlobMatch(pattern.glob, lowerRegion);
+                case PatternKind::kWorldspaceGlob:
+                    return lowerWorldspace.find(pattern.literal) != std::string_view::npos &&
+                           GlobMatch(pattern.glob, lowerWorldspace);
+            }
+            return false;
+        }
+    }
+
+    std::uint32_t ParseSeasonMask(std::string_view name) {
+        if (name == "*") return (1u << static_cast<std::uint32_t>(Season::kTotal)) - 1;
+        if (EqualsIgnoreCase(name, "Autumn")) return 1u << static_cast<std::uint32_t>(Season::kFall);
+        for (std::uint32_t s = 0; s < static_cast<std::uint32_t>(Season::kTotal); ++s) {
+            if (EqualsIgnoreCase(name, SeasonToString(static_cast<Season>(s)))) return 1u << s;
+        }
+        return 0;
+    }
+
+    bool ParseMultiplierOverride(std::string_view text, MultiplierOverride& out) {
+        MultiplierOverride result;
+        bool ok = true;
+
+        ForEachCSVToken(text, [&](std::string_view item) {
+            if (!ok) return;
+
+            auto eq = item.find('=');
+            auto dot = item.find('.');
+            if (eq == std::string_view::npos || dot == std::string_view::npos || dot > eq) {
+                ok = false;
+                return;
+            }
+
+            auto seasons = ParseSeasonMask(TrimView(item.substr(0, dot)));
+            auto classes = ParseClassMask(TrimView(item.substr(dot + 1, eq - dot - 1)));
+            float value = 0.0f;
+            if (seasons == 0 || classes == 0 || !ParseIniFloat(TrimView(item.substr(eq + 1)), value)) {
+                ok = false;
+                return;
+            }
+
+            value = std::clamp(value, 0.0f, kMaxMultiplier);
+            for (std::uint32_t s = 0; s < static_cast<std::uint32_t>(Season::kTotal); ++s) {
+                if (!(seasons & (1u << s))) continue;
+                for (std::uint32_t c = 0; c < MultiplierOverride::kClasses; ++c) {
+                    if (classes & (1u << c)) result.Set(static_cast<Season>(s), static_cast<WeatherClass>(c), value);
+                }
+            }
+        });
+
+        if (!ok || result.mask == 0) return false;
+        out = result;
+        return true;
+    }
+
+    void FormatMultiplierOverride(const MultiplierOverride& multipliers, std::string& out) {
+        bool first = true;
+        for (std::uint32_t s = 0; s < static_cast<std::uint32_t>(Season::kTotal); ++s) {
+            for (std::uint32_t c = 0; c < MultiplierOverride::kClasses; ++c) {
+                auto season = static_cast<Season>(s);
+                auto wc = static_cast<WeatherClass>(c);
+                if (!multipliers.Has(season, wc)) continue;
+
+                std::format_to(std::back_inserter(out), "{}{}.{}={:.2f}", first ? "" : ", ",
+                    SeasonToString(season), WeatherClassToString(wc), multipliers.Get(season, wc, 0.0f));
+                first = false;
+            }
+        }
+    }
+
+    bool ParseRegionOverrideRule(std::string_view pattern, std::string_view value, RegionOverrideRule& out) {
+        CompiledPattern compiled;
+        MultiplierOverride multipliers;
+        if (!CompilePattern(pattern, compiled) || !ParseMultiplierOverride(value, multipliers)) return false;
+
+        out.pattern     = std::string(pattern);
+        out.multipliers = multipliers;
+        return true;
+    }
+
+    bool ParseWorldspaceSeasonRule(std::string_view worldspace, std::string_view value, WorldspaceSeasonRule& out) {
+        WorldspaceSeasonRule rule;
+        rule.worldspace = std::string(TrimView(worldspace));
+        if (rule.worldspace.empty()) return false;
+
+        // The offset item is pulled out; the rest is a multiplier list.
+        bool hasOffset = false;
+        bool ok = true;
+        std::string multipliers;
+        ForEachCSVToken(value, [&](std::string_view item) {
+            auto eq = item.find('=');
+            if (eq != std::string_view::npos && EqualsIgnoreCase(TrimView(item.substr(0, eq)), "offset")) {
+                auto number = TrimView(item.substr(eq + 1));
+                if (number.starts_with('+')) number.remove_prefix(1);
+                auto [ptr, ec] = std::from_chars(number.data(), number.data() + number.size(), rule.offsetDays);
+                ok = ok && !number.empty() && ec == std::errc{} && ptr == number.data() + number.size() &&
+                     std::abs(rule.offsetDays) < static_cast<std::int32_t>(kDaysPerYear);
+                hasOffset = true;
+                return;
+            }
+            if (!multipliers.empty()) multipliers += ',';
+            multipliers += item;
+        });
+
+        if (!ok || (!hasOffset && multipliers.empty())) return false;
+        if (!multipliers.empty() && !ParseMultiplierOverride(multipliers, rule.multipliers)) return false;
+
+        out = std::move(rule);
+        return true;
+    }
+
+    void FormatWorldspaceSeasonRule(const WorldspaceSeasonRule& rule, std::string& out) {
+        std::format_to(std::back_inserter(out), "{} = offset={}", rule.worldspace, rule.offsetDays);
+        if (rule.multipliers.mask != 0) {
+            out += ", ";
+            FormatMultiplierOverride(rule.multipliers, out);
+        }
+        out += '\n';
+    }
+
+    std::shared_ptr<const CompiledRegionOverrides> CompiledRegionOverrides::Compile(
+        const std::vector<RegionOverrideRule>& rules,
+        const std::vector<RegionWeatherInfo>& regionInfos,
+        std::uint64_t scanGeneration)
+    {
+        auto start = std::chrono::steady_clock::now();
+
+        auto compiled = std::make_shared<CompiledRegionOverrides>();
+        compiled->rules          = rules;
+        compiled->scanGeneration = scanGeneration;
+        compiled->regionSet.assign(regionInfos.size(), 0);
+        if (rules.empty() || regionInfos.empty()) return compiled;
+
+        // Rules that repeat a pattern share one test, and worldspace
+        // patterns are tested once per worldspace rather than per region.
+        // Rules were validated when parsed; one that still fails to
+        // compile simply never matches.
+        std::vector<CompiledPattern> patterns;
+        std::vector<bool> valid;
+        std::vector<std::uint32_t> rulePattern(rules.size());
+        {
+            std::unordered_map<std::string_view, std::uint32_t> patternIds;
+            for (std::size_t i = 0; i < rules.size(); ++i) {
+                auto [it, inserted] = patternIds.try_emplace(rules[i].pattern,
+                    static_cast<std::uint32_t>(patterns.size()));
+                if (inserted) {
+                    valid.push_back(CompilePattern(rules[i].pattern, patterns.emplace_back()));
+                }
+                rulePattern[i] = it->second;
+            }
+        }
+
+        std::unordered_map<std::string, std::vector<char>> worldspaceHits;
+        for (const auto& info : regionInfos) {
+            auto lowerWorldspace = ToLower(info.worldSpaceEditorID);
+            auto [it, inserted] = worldspaceHits.try_emplace(lowerWorldspace);
+            if (!inserted) continue;
+            it->second.assign(patterns.size(), 0);
+            for (std::size_t p = 0; p < patterns.size(); ++p) {
+                it->second[p] = valid[p] && patterns[p].kind == PatternKind::kWorldspaceGlob &&
+                                Matches(patterns[p], info, {}, lowerWorldspace);
+            }
+        }
+
+        // Matching rule indices per region, in rule order. Regions are
+        // independent, so they are split across the worker pool.
+        std::vector<std::vector<std::uint32_t>> matches(regionInfos.size());
+        auto tasks = (regionInfos.size() + kRegionsPerTask - 1) / kRegionsPerTask;
+        WorkerPool::GetSingleton().ParallelFor(TaskPriority::kHigh, "Compile region overrides", tasks,
+            [&](std::size_t task) {
+                std::vector<char> hits(patterns.size());
+                auto first = task * kRegionsPerTask;
+                auto last = std::min(first + kRegionsPerTask, regionInfos.size());
+                for (auto r = first; r < last; ++r) {
+                    const auto& info = regionInfos[r];
+                    auto lowerRegion = ToLower(info.editorID);
+                    const auto& wsHits = worldspaceHits.at(ToLower(info.worldSpaceEditorID));
+                    for (std::size_t p = 0; p < patterns.size(); ++p) {
+                        hits[p] = patterns[p].kind == PatternKind::kWorldspaceGlob
+                            ? wsHits[p]
+                            : valid[p] && Matches(patterns[p], info, lowerRegion, {});
+                    }
+                    for (std::size_t i = 0; i < rules.size(); ++i) {
+                        if (hits[rulePattern[i]]) matches[r].push_back(static_cast<std::uint32_t>(i));
+                    }
+                }
+            });
+
+        auto matched = std::chrono::steady_clock::now();
+
+        // Regions hit by the same rules share one merged set.
+        std::map<std::vector<std::uint32_t>, std::uint32_t> setIds;
+        std::size_t overridden = 0;
+        for (std::size_t r = 0; r < regionInfos.size(); ++r) {
+            if (matches[r].empty()) continue;
+            ++overridden;
+
+            auto [it, inserted] = setIds.try_emplace(std::move(matches[r]),
+                static_cast<std::uint32_t>(compiled->sets.size() + 1));
+            if (inserted) {
+                MultiplierOverride merged;
+                for (auto rule : it->first) merged.Merge(rules[rule].multipliers);
+                compiled->sets.push_back(merged);
+            }
+            compiled->regionSet[r] = it->second;
+        }
+
+        auto end = std::chrono::steady_clock::now();
+        auto tests = static_cast<double>(patterns.size()) * static_cast<double>(regionInfos.size());
+        auto matchNs = std::chrono::duration<double, std::nano>(matched - start).count();
+        logs::info("RegionOverrides: Compiled {} rules ({} patterns) x {} regions in {:.3f} ms (match {:.3f} ms, "
+            "{:.1f} ns per pattern test; dedupe {:.3f} ms) -> {} regions overridden, {} distinct sets",
+            rules.size(), patterns.size(), regionInfos.size(),
+            std::chrono::duration<double, std::milli>(end - start).count(),
+            matchNs / 1e6, matchNs / tests,
+            std::chrono::duration<double, std::milli>(end - matched).count(),
+            overridden, compiled->sets.size());
+
+        return compiled;
+    }
+
+    std::shared_ptr<const CompiledRegionOverrides> RegionOverrideIndex::Ensure(
+        const Config& config,
+        const std::vector<RegionWeatherInfo>& regionInfos,
+        std::uint64_t scanGeneration)
+    {
+        std::lock_guard<std::mutex> lock(compileMutex_);
+
+        auto current = compiled_.load(std::memory_order_acquire);
+        if (current && current->scanGeneration == scanGeneration && current->rules == config.regionOverrides) {
+            return current;
+        }
+
+        auto compiled = CompiledRegionOverrides::Compile(config.regionOverrides, regionInfos, scanGeneration);
+        compiled_.store(compiled, std::memory_order_release);
+        return compiled;
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "pch.h"
+#include "Config.h"
+
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace SWF {
+
+    struct RegionWeatherInfo;
+
+    // Bit per Season for "Spring".."Winter" (case-insensitive), "Autumn"
+    // or "*" (all); 0 for anything else.
+    std::uint32_t ParseSeasonMask(std::string_view name);
+
+    // "Spring.Snow=2, Winter.*=1.5, *.Rainy=0.5" -> sparse multipliers.
+    // Season and class names are case-insensitive; '*' means all of them.
+    // Values are clamped to [0, 10] like the global multipliers. Returns
+    // false (leaving `out` untouched) on any malformed item.
+    bool ParseMultiplierOverride(std::string_view text, MultiplierOverride& out);
+
+    // Inverse of ParseMultiplierOverride(), one "Season.Class=value" per set slot.
+    void FormatMultiplierOverride(const MultiplierOverride& multipliers, std::string& out);
+
+    // Validates the pattern (regexes must compile) and parses the value.
+    bool ParseRegionOverrideRule(std::string_view pattern, std::string_view value, RegionOverrideRule& out);
+
+    // Worldspace EditorID key and "offset=-30, Winter.Snow=3" value. The
+    // offset (days, within one year either way) and the multipliers are
+    // each optional, but not both.
+    bool ParseWorldspaceSeasonRule(std::string_view worldspace, std::string_view value, WorldspaceSeasonRule& out);
+
+    // "key = value\n" line for one rule, inverse of ParseWorldspaceSeasonRule().
+    void FormatWorldspaceSeasonRule(const WorldspaceSeasonRule& rule, std::string& out);
+
+    // Region override rules resolved against one region scan. Every region
+    // points at one deduplicated multiplier set (the ordered merge of all
+    // rules that matched it), so applying a season never looks at patterns.
+    struct CompiledRegionOverrides {
+        // Parallel to RegionScanner::GetRegionWeatherInfos(); 0 = no rule
+        // matched, otherwise 1 + index into `sets`.
+        std::vector<std::uint32_t>      regionSet;
+        std::vector<MultiplierOverride> sets;
+
+        std::vector<RegionOverrideRule> rules;           // what this was compiled from
+        std::uint64_t                   scanGeneration = 0;
+
+        const MultiplierOverride* ForRegion(std::size_t region) const {
+            if (region >= regionSet.size() || regionSet[region] == 0) return nullptr;
+            return &sets[regionSet[region] - 1];
+        }
+
+        static std::shared_ptr<const CompiledRegionOverrides> Compile(
+            const std::vector<RegionOverrideRule>& rules,
+            const std::vector<RegionWeatherInfo>& regionInfos,
+            std::uint64_t scanGeneration);
+    };
+
+    class RegionOverrideIndex {
+    public:
+        static RegionOverrideIndex& GetSingleton() {
+            static RegionOverrideIndex instance;
+            return instance;
+        }
+
+        // Returns the compiled index for `config`'s rules and the current
+        // scan, recompiling only if either changed since the last call.
+        // Any thread; compiles are serialized.
+        std::shared_ptr<const CompiledRegionOverrides> Ensure(
+            const Config& config,
+            const std::vector<RegionWeatherInfo>& regionInfos,
+            std::uint64_t scanGeneration);
+
+        std::shared_ptr<const CompiledRegionOverrides> Get() const {
+            return compiled_.load(std::memory_order_acquire);
+        }
+
+    private:
+        RegionOverrideIndex() = default;
+        ~RegionOverrideIndex() = default;
+        RegionOverrideIndex(const RegionOverrideIndex&) = delete;
+        RegionOverrideIndex& operator=(const RegionOverrideIndex&) = delete;
+
+        std::atomic<std::shared_ptr<const CompiledRegionOverrides>> compiled_;
+        std::mutex                                                  compileMutex_;
+    };
+}
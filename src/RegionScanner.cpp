@@ -1,5 +1,6 @@
 #include "RegionScanner.h"
 #include "Config.h"
+#include "PerfStats.h"
 
 #include <unordered_map>
 #include <unordered_set>
@@ -49,10 +50,13 @@ namespace SWF {
     }
 
     void RegionScanner::ScanAllRegions() {
+        PerfScope perf(PerfTimer::kScan);
         std::lock_guard<std::mutex> lock(mutex_);
 
         regionInfos_.clear();
         uniqueWeathers_.clear();
+        weatherIndices_.Clear();
+        regionIndices_.Clear();
 
         auto* dataHandler = RE::TESDataHandler::GetSingleton();
         if (!dataHandler) {
@@ -61,7 +65,8 @@ namespace SWF {
         }
 
         auto& regions = dataHandler->GetFormArray<RE::TESRegion>();
-        std::unordered_set<RE::FormID> seenWeathers;
+        weatherIndices_.Reserve(dataHandler->GetFormArray<RE::TESWeather>().size());
+        regionIndices_.Reserve(regions.size());
 
         logs::info("RegionScanner: Scanning {} total region records...", regions.size());
 
@@ -87,6 +92,10 @@ namespace SWF {
             info.worldSpace  = region->worldSpace;
             info.editorID    = GetRegionName(region);
             info.totalBaseChance = 0;
+            if (info.worldSpace) {
+                auto wsID = info.worldSpace->GetFormEditorID();
+                if (wsID) info.worldSpaceEditorID = wsID;
+            }
 
             // Iterate weather types in this region
             for (auto& wt : weatherData->weatherTypes) {
@@ -96,24 +105,31 @@ namespace SWF {
                 entry.weather        = wt->weather;
                 entry.baseChance     = wt->chance;
                 entry.global         = wt->global;
-                entry.classification = ClassifyWeather(wt->weather);
-
-                info.totalBaseChance += entry.baseChance;
-                info.originalWeatherEntries.push_back(entry);
+                // classification is filled in by ClassifyWeathers()
 
                 // Track unique weathers
-                if (wt->weather && seenWeathers.find(wt->weather->GetFormID()) == seenWeathers.end()) {
-                    seenWeathers.insert(wt->weather->GetFormID());
-                    uniqueWeathers_.push_back(wt->weather);
+                if (wt->weather) {
+                    entry.weatherIndex = GetWeatherIndex(wt->weather->GetFormID());
+                    if (entry.weatherIndex == kNoWeatherIndex) {
+                        entry.weatherIndex = static_cast<std::uint32_t>(uniqueWeathers_.size());
+                        weatherIndices_.Insert(wt->weather->GetFormID(), entry.weatherIndex);
+                        uniqueWeathers_.push_back(wt->weather);
+                    }
                 }
+
+                info.totalBaseChance += entry.baseChance;
+                info.originalWeatherEntries.push_back(entry);
             }
 
+            info.originalEntryCount = info.originalWeatherEntries.size();
+
             if (!info.originalWeatherEntries.empty()) {
                 logs::info("  Region '{}' [{}]: {} weather entries, worldspace={}",
                     info.editorID,
                     fmt::format("{:08X}", region->GetFormID()),
                     info.originalWeatherEntries.size(),
-                    info.worldSpace ? info.worldSpace->GetFormEditorID() : "none");
+                    info.worldSpaceEditorID.empty() ? "none" : info.worldSpaceEditorID);
+                regionIndices_.Insert(region->GetFormID(), static_cast<std::uint32_t>(regionInfos_.size()));
                 regionInfos_.push_back(std::move(info));
             }
         }
@@ -121,6 +137,20 @@ namespace SWF {
         logs::info("RegionScanner: Found {} regions with weather data, {} unique weather forms",
             regionInfos_.size(), uniqueWeathers_.size());
 
+        worldspacePools_.clear();
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+        PublishSnapshot();
+    }
+
+    void RegionScanner::ClassifyWeathers() {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        for (auto& info : regionInfos_) {
+            for (auto& entry : info.originalWeatherEntries) {
+                entry.classification = ClassifyWeather(entry.weather);
+            }
+        }
+
         // Log weather
         std::uint32_t pleasant = 0, cloudy = 0, rainy = 0, snow = 0, unknown = 0;
         for (auto* w : uniqueWeathers_) {
@@ -134,44 +164,60 @@ namespace SWF {
         }
         logs::info("  Weather classification: {} pleasant, {} cloudy, {} rainy, {} snow, {} unknown",
             pleasant, cloudy, rainy, snow, unknown);
+
+        PublishSnapshot();
     }
 
-    void RegionScanner::InjectMissingWeathers() {
+    void RegionScanner::BuildWorldspacePools() {
         std::lock_guard<std::mutex> lock(mutex_);
 
         auto& config = ConfigManager::GetSingleton().GetConfig();
 
-        // Step 1: Build a per-worldspace pool of all weathers found in any region.
-        // Key = worldspace FormID, Value = map of weather FormID → weather pointer.
-        std::unordered_map<RE::FormID, std::unordered_map<RE::FormID, RE::TESWeather*>> wsWeatherPools;
+        // Per-worldspace pool of all weathers found in any of its regions.
+        // Key = worldspace FormID, Value = weathers in first-seen order.
+        worldspacePools_.clear();
+        std::unordered_map<RE::FormID, std::unordered_set<RE::FormID>> seen;
 
         for (const auto& info : regionInfos_) {
             if (!info.worldSpace) continue;
-            auto wsID = info.worldSpace->GetFormEditorID();
-            if (!wsID || !config.IsWorldspaceEnabled(wsID)) continue;
+            if (info.worldSpaceEditorID.empty() || !config.IsWorldspaceEnabled(info.worldSpaceEditorID)) continue;
 
             auto wsFormID = info.worldSpace->GetFormID();
-            auto& pool = wsWeatherPools[wsFormID];
+            auto& pool = worldspacePools_[wsFormID];
+            auto& poolSeen = seen[wsFormID];
 
             for (const auto& entry : info.originalWeatherEntries) {
-                if (entry.weather) {
-                    pool[entry.weather->GetFormID()] = entry.weather;
+                if (entry.weather && poolSeen.insert(entry.weather->GetFormID()).second) {
+                    pool.push_back(entry.weather);
                 }
             }
         }
 
-        // Step 2: For each region in an enabled worldspace, inject weathers
+        logs::info("RegionScanner: Built weather pools for {} worldspaces", worldspacePools_.size());
+    }
+
+    void RegionScanner::InjectMissingWeathers() {
+        PerfScope perf(PerfTimer::kInject);
+        if (worldspacePools_.empty()) {
+            BuildWorldspacePools();
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto& config = ConfigManager::GetSingleton().GetConfig();
+
+        // For each region in an enabled worldspace, inject weathers
         // that exist in the pool but not in this region's list.
         std::uint32_t totalInjected = 0;
 
         for (auto& info : regionInfos_) {
             if (!info.worldSpace || !info.weatherData) continue;
-            auto wsID = info.worldSpace->GetFormEditorID();
-            if (!wsID || !config.IsWorldspaceEnabled(wsID)) continue;
+            if (info.hasInjectedWeathers) continue;  // already done on an earlier pass
+            if (info.worldSpaceEditorID.empty() || !config.IsWorldspaceEnabled(info.worldSpaceEditorID)) continue;
 
             auto wsFormID = info.worldSpace->GetFormID();
-            auto poolIt = wsWeatherPools.find(wsFormID);
-            if (poolIt == wsWeatherPools.end()) continue;
+            auto poolIt = worldspacePools_.find(wsFormID);
+            if (poolIt == worldspacePools_.end()) continue;
 
             // Record original entry count before injection
             info.originalEntryCount = info.originalWeatherEntries.size();
@@ -187,7 +233,8 @@ namespace SWF {
             // quest / scripted weathers (e.g. DA02) that should never play
             // from region tables.
             std::uint32_t injectedCount = 0;
-            for (const auto& [weatherFormID, weather] : poolIt->second) {
+            for (auto* weather : poolIt->second) {
+                auto weatherFormID = weather->GetFormID();
                 if (existing.count(weatherFormID)) continue;
 
                 auto wclass = ClassifyWeather(weather);
@@ -218,6 +265,7 @@ namespace SWF {
                 trackEntry.baseChance     = 0;
                 trackEntry.global         = nullptr;
                 trackEntry.classification = ClassifyWeather(weather);
+                trackEntry.weatherIndex   = GetWeatherIndex(weatherFormID);
                 info.originalWeatherEntries.push_back(trackEntry);
 
                 ++injectedCount;
@@ -232,6 +280,25 @@ namespace SWF {
         }
 
         logs::info("RegionScanner: Injected {} total weather entries across all regions", totalInjected);
+
+        // Called on every re-apply; a pass that found nothing new must not
+        // invalidate everything keyed on the scan generation.
+        if (totalInjected == 0) return;
+        generation_.fetch_add(1, std::memory_order_acq_rel);
+        PublishSnapshot();
+    }
+
+    void RegionScanner::PublishSnapshot() {
+        auto snapshot = std::make_shared<RegionScanSnapshot>();
+        snapshot->infos          = regionInfos_;
+        snapshot->uniqueWeathers = uniqueWeathers_;
+        for (const auto& info : regionInfos_) {
+            for (const auto& entry : info.originalWeatherEntries) {
+                snapshot->globalValues.push_back(entry.global ? entry.global->value : 1.0f);
+            }
+        }
+        snapshot->generation = generation_.load(std::memory_order_acquire);
+        snapshot_.store(std::move(snapshot), std::memory_order_release);
     }
 
     void RegionScanner::RemoveInjectedWeathers() {
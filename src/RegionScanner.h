@@ -1,19 +1,28 @@
 #pragma once
 
 #include "pch.h"
+#include "FlatFormMap.h"
 #include "Season.h"
 
+#include <memory>
 #include <unordered_map>
 #include <vector>
 #include <mutex>
 
 namespace SWF {
 
+    // Marks an entry whose weather is not in the unique weather list.
+    inline constexpr std::uint32_t kNoWeatherIndex = 0xFFFFFFFF;
+
+    // Marks a region that has no scanned weather data.
+    inline constexpr std::uint32_t kNoRegionIndex = 0xFFFFFFFF;
+
     struct RegionWeatherEntry {
         RE::TESWeather*   weather  = nullptr;
         std::uint32_t     baseChance = 0;     // original chance from the region record
         RE::TESGlobal*    global   = nullptr;  // optional global override
         WeatherClass      classification = WeatherClass::kUnknown;
+        std::uint32_t     weatherIndex = kNoWeatherIndex;  // index into GetUniqueWeathers()
     };
 
     struct RegionWeatherInfo {
@@ -21,12 +30,23 @@ namespace SWF {
         RE::TESRegionDataWeather*       weatherData = nullptr;
         RE::TESWorldSpace*              worldSpace = nullptr;
         std::string                     editorID;
+        std::string                     worldSpaceEditorID;      // cached at scan time, empty if none
         std::vector<RegionWeatherEntry> originalWeatherEntries;  // snapshot of original weather list
         std::uint32_t                   totalBaseChance = 0;
         std::size_t                     originalEntryCount = 0;  // how many entries existed before injection
         bool                            hasInjectedWeathers = false;
     };
 
+    // Immutable copy of the scan results for readers off the game thread.
+    // A new one replaces it whenever the scan, classification or injection
+    // changes the region infos; holders keep theirs for as long as they need.
+    struct RegionScanSnapshot {
+        std::vector<RegionWeatherInfo> infos;
+        std::vector<RE::TESWeather*>   uniqueWeathers;
+        std::vector<float>             globalValues;   // per entry, regions in order; 1 if it has no global
+        std::uint64_t                  generation = 0;
+    };
+
     class RegionScanner {
     public:
         static RegionScanner& GetSingleton() {
@@ -34,8 +54,17 @@ namespace SWF {
             return instance;
         }
 
+        // Startup runs these in order. Scan and inject touch live records and
+        // must run on the game thread; classify and pool building only read
+        // the snapshot taken by the scan and may run on a worker.
         void ScanAllRegions();
 
+        // Classify every scanned weather entry by its weather flags.
+        void ClassifyWeathers();
+
+        // Build the per-worldspace pool of weathers used by injection.
+        void BuildWorldspacePools();
+
         // Inject missing weathers from the worldspace pool into each region
         // so every weather type has a chance to play regardless of region.
         void InjectMissingWeathers();
@@ -51,6 +80,35 @@ namespace SWF {
 
         const std::vector<RE::TESWeather*>& GetUniqueWeathers() const { return uniqueWeathers_; }
 
+        // Dense index of a weather in GetUniqueWeathers(), or kNoWeatherIndex.
+        std::uint32_t GetWeatherIndex(RE::FormID formID) const {
+            auto* index = weatherIndices_.Find(formID);
+            return index ? *index : kNoWeatherIndex;
+        }
+
+        // Position of a region in GetRegionWeatherInfos(), which is also its
+        // ChanceTable slot, or kNoRegionIndex. Rebuilt by every scan.
+        std::uint32_t GetRegionIndex(RE::FormID formID) const {
+            auto* index = regionIndices_.Find(formID);
+            return index ? *index : kNoRegionIndex;
+        }
+
+        // Scan record of `region`, or null if it has no weather data.
+        const RegionWeatherInfo* FindRegionInfo(const RE::TESRegion* region) const {
+            auto index = region ? GetRegionIndex(region->GetFormID()) : kNoRegionIndex;
+            return index != kNoRegionIndex ? &regionInfos_[index] : nullptr;
+        }
+
+        // Incremented whenever the region table changes shape (scan, inject),
+        // so tables derived from it can detect that they are stale.
+        std::uint64_t GetGeneration() const { return generation_.load(std::memory_order_acquire); }
+
+        // Latest snapshot of the region infos; null before the first scan.
+        // Any thread.
+        std::shared_ptr<const RegionScanSnapshot> GetSnapshot() const {
+            return snapshot_.load(std::memory_order_acquire);
+        }
+
         static WeatherClass ClassifyWeather(RE::TESWeather* weather);
 
         static std::string GetWeatherName(RE::TESWeather* weather);
@@ -63,8 +121,21 @@ namespace SWF {
         RegionScanner(const RegionScanner&) = delete;
         RegionScanner& operator=(const RegionScanner&) = delete;
 
+        // Copies regionInfos_ into a new snapshot. mutex_ held.
+        void PublishSnapshot();
+
         std::vector<RegionWeatherInfo> regionInfos_;
         std::vector<RE::TESWeather*>   uniqueWeathers_;
+        FlatFormMap<std::uint32_t>     weatherIndices_;  // FormID -> uniqueWeathers_ index
+        FlatFormMap<std::uint32_t>     regionIndices_;   // FormID -> regionInfos_ index
+
+        // Worldspace FormID -> every weather seen in that worldspace's
+        // enabled regions, in first-seen order.
+        std::unordered_map<RE::FormID, std::vector<RE::TESWeather*>> worldspacePools_;
+
+        std::atomic<std::uint64_t>     generation_ = 0;
         mutable std::mutex             mutex_;
+
+        std::atomic<std::shared_ptr<const RegionScanSnapshot>> snapshot_;
     };
 }
@@ -0,0 +1,309 @@
+#include "RegionSearch.h"
+#include "IniParser.h"
+#include "PerfStats.h"
+#include "RegionScanner.h"
+
+#include <chrono>
+
+namespace SWF {
+
+    namespace {
+        std::string ToLower(std::string_view str) {
+            std::string out(str);
+            for (auto& c : out) {
+                if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+            }
+            return out;
+        }
+
+        // Gram of 1-3 bytes at `pos`; the length sits above the bytes so
+        // grams of different lengths never share a key.
+        std::uint32_t Gram(std::string_view str, std::size_t pos, std::size_t length) {
+            std::uint32_t key = static_cast<std::uint32_t>(length) << 24;
+            for (std::size_t i = 0; i < length; ++i) {
+                key |= static_cast<std::uint32_t>(static_cast<unsigned char>(str[pos + i])) << (8 * (length - 1 - i));
+            }
+            return key;
+        }
+
+        // Sorted, de-duplicated labels; facets store positions in it.
+        std::uint16_t LabelIndex(const std::vector<std::string>& labels, std::string_view label) {
+            auto it = std::ranges::lower_bound(labels, label, std::less<>{});
+            return static_cast<std::uint16_t>(it - labels.begin());
+        }
+
+        std::string_view WorldspaceLabel(const RegionWeatherInfo& info) {
+            return info.worldSpaceEditorID.empty() ? std::string_view("(no worldspace)") : info.worldSpaceEditorID;
+        }
+
+        std::string_view PluginLabel(const RegionWeatherInfo& info) {
+            const auto* file = info.region ? info.region->GetFile(0) : nullptr;
+            return file ? file->GetFilename() : std::string_view("(no plugin)");
+        }
+    }
+
+    void TrigramIndex::Build(const std::vector<std::string_view>& names) {
+        text_.clear();
+        starts_.clear();
+        starts_.reserve(names.size() + 1);
+        for (auto name : names) {
+            starts_.push_back(static_cast<std::uint32_t>(text_.size()));
+            text_ += ToLower(name);
+        }
+        starts_.push_back(static_cast<std::uint32_t>(text_.size()));
+
+        // (gram << 32 | id), generated in id order. Two stable 13-bit radix
+        // passes over the 26-bit gram group each gram's ids and keep them
+        // ascending, without a comparison sort.
+        std::vector<std::uint64_t> pairs;
+        pairs.reserve(text_.size() * 3);
+        for (std::uint32_t id = 0; id < names.size(); ++id) {
+            auto name = GetName(id);
+            for (std::size_t pos = 0; pos < name.size(); ++pos) {
+                for (std::size_t length = 1; length <= 3 && pos + length <= name.size(); ++length) {
+                    pairs.push_back((static_cast<std::uint64_t>(Gram(name, pos, length)) << 32) | id);
+                }
+            }
+        }
+        std::vector<std::uint64_t> scratch(pairs.size());
+        for (int shift = 32; shift < 58; shift += 13) {
+            std::vector<std::uint32_t> counts(8193, 0);
+            for (auto pair : pairs) ++counts[((pair >> shift) & 0x1FFF) + 1];
+            for (std::size_t b = 1; b < counts.size(); ++b) counts[b] += counts[b - 1];
+            for (auto pair : pairs) scratch[counts[(pair >> shift) & 0x1FFF]++] = pair;
+            pairs.swap(scratch);
+        }
+        pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+        keys_.clear();
+        offsets_.clear();
+        postings_.resize(pairs.size());
+        for (std::size_t i = 0; i < pairs.size(); ++i) {
+            auto key = static_cast<std::uint32_t>(pairs[i] >> 32);
+            if (keys_.empty() || keys_.back() != key) {
+                keys_.push_back(key);
+                offsets_.push_back(static_cast<std::uint32_t>(i));
+            }
+            postings_[i] = static_cast<std::uint32_t>(pairs[i]);
+        }
+        offsets_.push_back(static_cast<std::uint32_t>(postings_.size()));
+    }
+
+    std::size_t TrigramIndex::GetMemoryBytes() const {
+        return text_.capacity() +
+               (starts_.capacity() + keys_.capacity() + offsets_.capacity() + postings_.capacity()) *
+                   sizeof(std::uint32_t);
+    }
+
+    void TrigramIndex::Find(std::string_view needle, std::vector<std::uint32_t>& out) const {
+        if (needle.empty()) return;
+
+        struct List {
+            const std::uint32_t* first;
+            const std::uint32_t* last;
+        };
+        auto lookup = [&](std::uint32_t gram, List& list) {
+            auto it = std::ranges::lower_bound(keys_, gram);
+            if (it == keys_.end() || *it != gram) return false;
+            auto k = static_cast<std::size_t>(it - keys_.begin());
+            list = { postings_.data() + offsets_[k], postings_.data() + offsets_[k + 1] };
+            return true;
+        };
+
+        // Up to three bytes the needle is a gram itself: its list is the answer.
+        if (needle.size() <= 3) {
+            List list;
+            if (lookup(Gram(needle, 0, needle.size()), list)) out.insert(out.end(), list.first, list.last);
+            return;
+        }
+
+        std::vector<std::uint32_t> grams;
+        grams.reserve(needle.size() - 2);
+        for (std::size_t pos = 0; pos + 3 <= needle.size(); ++pos) grams.push_back(Gram(needle, pos, 3));
+        std::ranges::sort(grams);
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+
+        std::vector<List> lists(grams.size());
+        for (std::size_t g = 0; g < grams.size(); ++g) {
+            if (!lookup(grams[g], lists[g])) return;   // a trigram no name has
+        }
+
+        // Start from the shortest list, so the cost follows the rarest
+        // trigram. Lists much longer than the candidates are probed with a
+        // moving lower_bound; comparable ones are merged linearly.
+        std::ranges::sort(lists, {}, [](const List& list) { return list.last - list.first; });
+        std::vector<std::uint32_t> candidates(lists.front().first, lists.front().last);
+        for (std::size_t l = 1; l < lists.size() && !candidates.empty(); ++l) {
+            auto* first = lists[l].first;
+            auto* last  = lists[l].last;
+            bool  probe = static_cast<std::size_t>(last - first) > candidates.size() * 16;
+            std::size_t kept = 0;
+            for (auto id : candidates) {
+                if (probe) {
+                    first = std::lower_bound(first, last, id);
+                } else {
+                    while (first != last && *first < id) ++first;
+                }
+                if (first == last) break;
+                if (*first == id) candidates[kept++] = id;
+            }
+            candidates.resize(kept);
+        }
+
+        // Shared trigrams do not imply adjacency; confirm the substring.
+        for (auto id : candidates) {
+            if (GetName(id).find(needle) != std::string_view::npos) out.push_back(id);
+        }
+    }
+
+    std::size_t CompiledRegionSearch::GetMemoryBytes() const {
+        auto bytes = regionIndex.GetMemoryBytes() + weatherIndex.GetMemoryBytes() +
+                     (regionWeatherOffsets.capacity() + regionWeathers.capacity() + nameOrder.capacity() +
+                      nameRank.capacity()) * sizeof(std::uint32_t) +
+                     facets.capacity() * sizeof(Facets);
+        for (const auto* labels : { &worldspaces, &plugins }) {
+            for (const auto& label : *labels) bytes += sizeof(std::string) + label.capacity();
+        }
+        return bytes;
+    }
+
+    void CompiledRegionSearch::Query(const RegionFilter& filter, std::vector<std::uint32_t>& out) const {
+        out.clear();
+
+        auto passes = [&](std::uint32_t region) {
+            const auto& f = facets[region];
+            if (filter.worldspace >= 0 && f.worldspace != filter.worldspace) return false;
+            if (filter.plugin >= 0 && f.plugin != filter.plugin) return false;
+            if (filter.classMask != 0 && (f.classMask & filter.classMask) == 0) return false;
+            if (filter.origin == RegionOrigin::kOriginal && f.injected) return false;
+            if (filter.origin == RegionOrigin::kInjected && !f.injected) return false;
+            return true;
+        };
+
+        auto needle = ToLower(TrimView(filter.text));
+        if (needle.empty()) {
+            for (auto r : nameOrder) {
+                if (passes(r)) out.push_back(r);
+            }
+            return;
+        }
+
+        std::vector<std::uint32_t> regions;
+        std::vector<std::uint32_t> weathers;
+        regionIndex.Find(needle, regions);
+        weatherIndex.Find(needle, weathers);
+
+        // Name matches only: few enough to order by rank directly.
+        if (weathers.empty()) {
+            for (auto r : regions) {
+                if (passes(r)) out.push_back(r);
+            }
+            std::ranges::sort(out, {}, [&](std::uint32_t r) { return nameRank[r]; });
+            return;
+        }
+
+        // Otherwise mark in scan order, where the weather lists are read
+        // sequentially, and only the final pass follows name order. The
+        // loops avoid data-dependent branches: with broad needles about half
+        // the regions match and a branch per region mispredicts constantly.
+        std::vector<std::uint8_t> weatherMatched(weatherIndex.GetNameCount(), 0);
+        for (auto w : weathers) weatherMatched[w] = 1;
+        std::vector<std::uint8_t> matched(facets.size(), 0);
+        for (auto r : regions) matched[r] = 1;
+
+        const auto* offsets = regionWeatherOffsets.data();
+        const auto* regionWeather = regionWeathers.data();
+        const auto* weatherHit = weatherMatched.data();
+        for (std::size_t r = 0; r < matched.size(); ++r) {
+            std::uint8_t hit = matched[r];
+            for (auto i = offsets[r], last = offsets[r + 1]; i < last; ++i) hit |= weatherHit[regionWeather[i]];
+            matched[r] = hit;
+        }
+
+        out.resize(nameOrder.size());
+        std::size_t count = 0;
+        for (auto r : nameOrder) {
+            out[count] = r;
+            count += matched[r];
+        }
+        out.resize(count);
+        if (!filter.IsTextOnly()) std::erase_if(out, [&](std::uint32_t r) { return !passes(r); });
+    }
+
+    std::shared_ptr<const CompiledRegionSearch> RegionSearch::Build(
+        const std::vector<RegionWeatherInfo>& regionInfos, std::uint64_t scanGeneration)
+    {
+        auto start = std::chrono::steady_clock::now();
+        const auto& uniqueWeathers = RegionScanner::GetSingleton().GetUniqueWeathers();
+
+        auto search = std::make_shared<CompiledRegionSearch>();
+        search->scanGeneration = scanGeneration;
+
+        std::vector<std::string> weatherNames;
+        weatherNames.reserve(uniqueWeathers.size());
+        for (auto* weather : uniqueWeathers) weatherNames.push_back(RegionScanner::GetWeatherName(weather));
+        search->weatherIndex.Build({ weatherNames.begin(), weatherNames.end() });
+
+        std::vector<std::string_view> regionNames;
+        regionNames.reserve(regionInfos.size());
+        for (const auto& info : regionInfos) {
+            regionNames.push_back(info.editorID);
+            search->worldspaces.emplace_back(WorldspaceLabel(info));
+            search->plugins.emplace_back(PluginLabel(info));
+        }
+        search->regionIndex.Build(regionNames);
+        for (auto* labels : { &search->worldspaces, &search->plugins }) {
+            std::ranges::sort(*labels);
+            labels->erase(std::unique(labels->begin(), labels->end()), labels->end());
+        }
+
+        // Facets, and each region's distinct weathers.
+        std::vector<std::uint32_t> lastRegion(uniqueWeathers.size(), 0xFFFFFFFF);
+        search->facets.resize(regionInfos.size());
+        search->regionWeatherOffsets.reserve(regionInfos.size() + 1);
+        for (std::uint32_t r = 0; r < regionInfos.size(); ++r) {
+            const auto& info = regionInfos[r];
+            auto& facets = search->facets[r];
+            facets.worldspace = LabelIndex(search->worldspaces, WorldspaceLabel(info));
+            facets.plugin     = LabelIndex(search->plugins, PluginLabel(info));
+            facets.injected   = info.hasInjectedWeathers;
+
+            search->regionWeatherOffsets.push_back(static_cast<std::uint32_t>(search->regionWeathers.size()));
+            for (const auto& entry : info.originalWeatherEntries) {
+                facets.classMask |= static_cast<std::uint8_t>(1u << static_cast<std::uint32_t>(entry.classification));
+                if (entry.weatherIndex >= uniqueWeathers.size() || lastRegion[entry.weatherIndex] == r) continue;
+                lastRegion[entry.weatherIndex] = r;
+                search->regionWeathers.push_back(entry.weatherIndex);
+            }
+        }
+        search->regionWeatherOffsets.push_back(static_cast<std::uint32_t>(search->regionWeathers.size()));
+
+        search->nameOrder.resize(regionInfos.size());
+        for (std::uint32_t r = 0; r < regionInfos.size(); ++r) search->nameOrder[r] = r;
+        std::ranges::stable_sort(search->nameOrder, {}, [&](std::uint32_t r) {
+            return search->regionIndex.GetName(r);
+        });
+        search->nameRank.resize(regionInfos.size());
+        for (std::uint32_t i = 0; i < regionInfos.size(); ++i) search->nameRank[search->nameOrder[i]] = i;
+
+        auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        logs::info("RegionSearch: Indexed {} regions and {} weathers ({} + {} grams) in {:.3f} ms",
+            regionInfos.size(), uniqueWeathers.size(), search->regionIndex.GetGramCount(),
+            search->weatherIndex.GetGramCount(), ms);
+        PerfStats::GetSingleton().NoteBuild(PerfMemory::kRegionSearch, search->GetMemoryBytes());
+        return search;
+    }
+
+    std::shared_ptr<const CompiledRegionSearch> RegionSearch::Ensure(
+        const std::vector<RegionWeatherInfo>& regionInfos, std::uint64_t scanGeneration)
+    {
+        std::lock_guard<std::mutex> lock(buildMutex_);
+
+        auto current = compiled_.load(std::memory_order_acquire);
+        if (current && current->scanGeneration == scanGeneration) return current;
+
+        auto compiled = Build(regionInfos, scanGeneration);
+        compiled_.store(compiled, std::memory_order_release);
+        return compiled;
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "pch.h"
+#include "Season.h"
+
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace SWF {
+
+    struct RegionWeatherInfo;
+
+    // Substring index over lowercased names: every window of one to three
+    // bytes maps to the ascending list of names that contain it. A needle of
+    // up to three bytes is answered by its own list; a longer one intersects
+    // the lists of its trigrams and confirms the survivors with find(), so
+    // only names sharing every trigram with the needle are ever compared.
+    class TrigramIndex {
+    public:
+        // Names are lowercased and copied into one buffer; ids are positions
+        // in `names`.
+        void Build(const std::vector<std::string_view>& names);
+
+        // Appends the ids of names containing `needle` (already lowercase),
+        // ascending.
+        void Find(std::string_view needle, std::vector<std::uint32_t>& out) const;
+
+        std::string_view GetName(std::uint32_t id) const {
+            return std::string_view(text_).substr(starts_[id], starts_[id + 1] - starts_[id]);
+        }
+
+        std::size_t GetNameCount() const { return starts_.empty() ? 0 : starts_.size() - 1; }
+        std::size_t GetGramCount() const { return keys_.size(); }
+        std::size_t GetMemoryBytes() const;
+
+    private:
+        std::string                text_;       // every name, lowercased, back to back
+        std::vector<std::uint32_t> starts_;     // name count + 1 offsets into text_
+        std::vector<std::uint32_t> keys_;       // distinct grams, sorted
+        std::vector<std::uint32_t> offsets_;    // keys_.size() + 1 offsets into postings_
+        std::vector<std::uint32_t> postings_;   // name ids, ascending per gram
+    };
+
+    enum class RegionOrigin : std::uint8_t {
+        kAny,
+        kOriginal,   // regions with no injected weathers
+        kInjected    // regions that received injected weathers
+    };
+
+    struct RegionFilter {
+        std::string   text;                       // substring of a region or weather EditorID
+        std::int32_t  worldspace = -1;            // index into CompiledRegionSearch::worldspaces, -1 = any
+        std::int32_t  plugin     = -1;            // index into CompiledRegionSearch::plugins, -1 = any
+        std::uint32_t classMask  = 0;             // bit per WeatherClass; region needs one of them, 0 = any
+        RegionOrigin  origin     = RegionOrigin::kAny;
+
+        bool IsEmpty() const { return text.empty() && IsTextOnly(); }
+
+        bool IsTextOnly() const {
+            return worldspace < 0 && plugin < 0 && classMask == 0 && origin == RegionOrigin::kAny;
+        }
+
+        bool operator==(const RegionFilter&) const = default;
+    };
+
+    // Search data for one region scan. Regions are numbered as in
+    // GetRegionWeatherInfos() and weathers as in GetUniqueWeathers().
+    struct CompiledRegionSearch {
+        struct Facets {
+            std::uint16_t worldspace = 0;
+            std::uint16_t plugin     = 0;
+            std::uint8_t  classMask  = 0;       // bit per WeatherClass among the region's entries
+            bool          injected   = false;
+        };
+
+        TrigramIndex               regionIndex;           // region EditorIDs
+        TrigramIndex               weatherIndex;          // weather EditorIDs
+        std::vector<std::uint32_t> regionWeatherOffsets;  // region count + 1 offsets into regionWeathers
+        std::vector<std::uint32_t> regionWeathers;        // each region's distinct weathers
+
+        std::vector<std::uint32_t> nameOrder;             // regions by lowercased EditorID
+        std::vector<std::uint32_t> nameRank;              // per region, its position in nameOrder
+        std::vector<Facets>        facets;                // per region
+        std::vector<std::string>   worldspaces;           // sorted facet labels
+        std::vector<std::string>   plugins;               // sorted facet labels
+
+        std::uint64_t scanGeneration = 0;
+
+        std::size_t GetMemoryBytes() const;
+
+        // Regions matching `filter`, in name order. The text matches a region
+        // if it is part of the region's EditorID or of any of its weathers'.
+        void Query(const RegionFilter& filter, std::vector<std::uint32_t>& out) const;
+    };
+
+    class RegionSearch {
+    public:
+        static RegionSearch& GetSingleton() {
+            static RegionSearch instance;
+            return instance;
+        }
+
+        // Rebuilds the index if the scan generation changed since the last
+        // call; otherwise returns the cached one.
+        std::shared_ptr<const CompiledRegionSearch> Ensure(const std::vector<RegionWeatherInfo>& regionInfos,
+                                                           std::uint64_t scanGeneration);
+
+        std::shared_ptr<const CompiledRegionSearch> Get() const {
+            return compiled_.load(std::memory_order_acquire);
+        }
+
+    private:
+        RegionSearch() = default;
+        ~RegionSearch() = default;
+        RegionSearch(const RegionSearch&) = delete;
+        RegionSearch& operator=(const RegionSearch&) = delete;
+
+        static std::shared_ptr<const CompiledRegionSearch> Build(const std::vector<RegionWeatherInfo>& regionInfos,
+                                                                 std::uint64_t scanGeneration);
+
+        std::atomic<std::shared_ptr<const CompiledRegionSearch>> compiled_;
+        std::mutex                                               buildMutex_;
+    };
+}
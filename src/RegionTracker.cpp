@@ -0,0 +1,90 @@
+#include "RegionTracker.h"
+#include "Config.h"
+#include "PerfStats.h"
+#include "RegionScanner.h"
+#include "WeatherManager.h"
+#include "WeatherResetPolicy.h"
+
+namespace SWF {
+
+    void RegionTracker::Sample() {
+        PerfStats::GetSingleton().Count(PerfEvent::kRegionSample);
+
+        auto* sky = RE::Sky::GetSingleton();
+        auto* region = sky ? sky->region : nullptr;
+        auto* weather = sky ? sky->currentWeather : nullptr;
+        auto* player = RE::PlayerCharacter::GetSingleton();
+        auto* cell = player ? player->GetParentCell() : nullptr;
+
+        auto* oldRegion = region_.load(std::memory_order_relaxed);
+        auto* oldWorldSpace = worldSpace_.load(std::memory_order_relaxed);
+        if (region == oldRegion && cell == cell_ && weather == weather_) {
+            if (CheckDayChanged()) WeatherManager::GetSingleton().Update();
+            return;
+        }
+
+        // A pending deferred reset resolves on the next natural transition.
+        if (weather != weather_) {
+            weather_ = weather;
+            WeatherResetPolicy::GetSingleton().Poll();
+        }
+
+        // The worldspace can only change along with the cell.
+        auto* worldSpace = oldWorldSpace;
+        if (cell != cell_) {
+            cell_ = cell;
+            worldSpace = WeatherManager::GetPlayerWorldSpace();
+        }
+
+        if (region == oldRegion && worldSpace == oldWorldSpace) {
+            // Update() re-applies only when the month/day slot moved.
+            if (CheckDayChanged()) WeatherManager::GetSingleton().Update();
+            return;
+        }
+        CheckDayChanged();
+
+        region_.store(region, std::memory_order_release);
+        worldSpace_.store(worldSpace, std::memory_order_release);
+        changeCount_.fetch_add(1, std::memory_order_relaxed);
+        PerfStats::GetSingleton().Count(PerfEvent::kRegionChange);
+
+        OnChanged(oldRegion, oldWorldSpace);
+    }
+
+    bool RegionTracker::CheckDayChanged() {
+        auto* calendar = RE::Calendar::GetSingleton();
+        if (!calendar) return false;
+
+        auto day = static_cast<std::uint32_t>(calendar->GetDaysPassed());
+        if (day == gameDay_) return false;
+
+        bool first = gameDay_ == 0xFFFFFFFF;
+        gameDay_ = day;
+        return !first && ConfigManager::GetSingleton().GetConfig().enabled;
+    }
+
+    void RegionTracker::OnChanged(RE::TESRegion* oldRegion, RE::TESWorldSpace* oldWorldSpace) {
+        const auto& config = ConfigManager::GetSingleton().GetConfig();
+        if (!config.enabled) return;
+
+        auto* region = region_.load(std::memory_order_relaxed);
+        auto* worldSpace = worldSpace_.load(std::memory_order_relaxed);
+
+        if (config.debugMode) {
+            auto wsName = [](RE::TESWorldSpace* ws) -> std::string {
+                if (!ws) return "none";
+                auto editorID = ws->GetFormEditorID();
+                return editorID ? editorID : "unknown";
+            };
+            logs::info("RegionTracker: region {} -> {}, worldspace {} -> {}",
+                oldRegion ? RegionScanner::GetRegionName(oldRegion) : "none",
+                region ? RegionScanner::GetRegionName(region) : "none",
+                wsName(oldWorldSpace), wsName(worldSpace));
+        }
+
+        // Moving somewhere that matters may change the active worldspace or
+        // the season (after a long fast travel); Update() only re-applies
+        // when something actually changed.
+        WeatherManager::GetSingleton().Update();
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "pch.h"
+
+namespace SWF {
+
+    // Watches Sky::region and the player's worldspace and raises a change
+    // event only when either pointer actually changes. Driven from the
+    // player update hook; between samples a frame costs one counter
+    // increment, and a sample where nothing moved costs three pointer
+    // compares (region, parent cell, current weather) and a day check.
+    // The worldspace is only looked up when the cell changes, and the
+    // reset policy only polled when the weather does. A new game day also
+    // triggers one weather update (month curves move daily).
+    class RegionTracker {
+    public:
+        static RegionTracker& GetSingleton() {
+            static RegionTracker instance;
+            return instance;
+        }
+
+        // Frames between samples (~4 samples per second at 60 fps).
+        static constexpr std::uint32_t kSampleInterval = 15;
+
+        // Game thread, once per frame.
+        void Tick() {
+            if (++frame_ < kSampleInterval) return;
+            frame_ = 0;
+            Sample();
+        }
+
+        // Last observed values. Safe to read from the menu.
+        RE::TESRegion* GetCurrentRegion() const { return region_.load(std::memory_order_acquire); }
+        RE::TESWorldSpace* GetCurrentWorldSpace() const { return worldSpace_.load(std::memory_order_acquire); }
+
+        std::uint64_t GetChangeCount() const { return changeCount_.load(std::memory_order_relaxed); }
+
+    private:
+        RegionTracker() = default;
+        ~RegionTracker() = default;
+        RegionTracker(const RegionTracker&) = delete;
+        RegionTracker& operator=(const RegionTracker&) = delete;
+
+        void Sample();
+        void OnChanged(RE::TESRegion* oldRegion, RE::TESWorldSpace* oldWorldSpace);
+        bool CheckDayChanged();
+
+        std::uint32_t                     frame_ = 0;
+        RE::TESObjectCELL*                cell_ = nullptr;      // last sampled parent cell
+        RE::TESWeather*                   weather_ = nullptr;   // last sampled sky weather
+        std::atomic<RE::TESRegion*>       region_ = nullptr;
+        std::atomic<RE::TESWorldSpace*>   worldSpace_ = nullptr;
+        std::atomic<std::uint64_t>        changeCount_ = 0;
+        std::uint32_t                     gameDay_ = 0xFFFFFFFF;   // whole days passed; none yet
+    };
+}
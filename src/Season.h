@@ -55,6 +55,43 @@ namespace SWF {
         return calendar->GetMonth();
     }
 
+    inline constexpr std::uint32_t kMonthsPerYear = 12;
+
+    // Tamriel months have the Gregorian lengths (no leap years).
+    inline constexpr std::uint32_t GetDaysInMonth(std::uint32_t month) {
+        constexpr std::uint32_t kDays[kMonthsPerYear] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+        return month < kMonthsPerYear ? kDays[month] : 30;
+    }
+
+    inline constexpr std::uint32_t kDaysPerYear = 365;
+
+    // 0-based day of the year (0 = 1st of Morning Star) for a 0-based
+    // month and a 1-based day of that month.
+    inline constexpr std::uint32_t GetDayOfYear(std::uint32_t month, std::uint32_t dayOfMonth) {
+        std::uint32_t day = 0;
+        for (std::uint32_t m = 0; m < month && m < kMonthsPerYear; ++m) day += GetDaysInMonth(m);
+        return (day + (dayOfMonth > 0 ? dayOfMonth - 1 : 0)) % kDaysPerYear;
+    }
+
+    // Inverse of GetDayOfYear(): 0-based month, and the 1-based day of it.
+    inline constexpr std::uint32_t GetMonthOfDay(std::uint32_t dayOfYear, std::uint32_t* dayOfMonth = nullptr) {
+        dayOfYear %= kDaysPerYear;
+        std::uint32_t month = 0;
+        while (month + 1 < kMonthsPerYear && dayOfYear >= GetDaysInMonth(month)) {
+            dayOfYear -= GetDaysInMonth(month);
+            ++month;
+        }
+        if (dayOfMonth) *dayOfMonth = dayOfYear + 1;
+        return month;
+    }
+
+    // 1-based day of the current month.
+    inline std::uint32_t GetCurrentDayOfMonth() {
+        auto* calendar = RE::Calendar::GetSingleton();
+        if (!calendar) return 1;
+        return std::max(static_cast<std::uint32_t>(calendar->GetDay()), 1u);
+    }
+
     enum class WeatherClass : std::uint32_t {
         kPleasant = 0,
         kCloudy   = 1,
@@ -0,0 +1,73 @@
+#include "SeasonCalendar.h"
+
+namespace SWF {
+
+    CompiledSeasonCalendar CompiledSeasonCalendar::Build(const std::array<std::uint32_t, 4>& startDays,
+                                                         std::uint32_t transitionDays) {
+        CompiledSeasonCalendar calendar;
+        calendar.startDays      = startDays;
+        calendar.transitionDays = transitionDays;
+
+        // Seasons in the order they start during the year; the start days
+        // may come in any order, and two seasons may share one.
+        std::array<Season, 4> order{ Season::kSpring, Season::kSummer, Season::kFall, Season::kWinter };
+        auto startOf = [&](Season s) { return startDays[static_cast<std::size_t>(s)] % kDaysPerYear; };
+        std::ranges::stable_sort(order, {}, startOf);
+
+        // Days until the next season starts (0 for a season sharing its start day).
+        auto lengthOf = [&](std::size_t i) {
+            auto next = startOf(order[(i + 1) % order.size()]);
+            auto start = startOf(order[i]);
+            if (i + 1 == order.size()) next += kDaysPerYear;
+            return next - start;
+        };
+
+        // Plain seasons first: each day belongs to the last season started on or before it.
+        for (std::uint32_t d = 0; d < kDaysPerYear; ++d) {
+            auto season = order.back();
+            for (auto s : order) {
+                if (startOf(s) <= d) season = s;
+            }
+            calendar.days[d] = { season, season, season, 0.0f };
+        }
+
+        // Then the windows, clamped so a short season is never blended past
+        // its middle from either side.
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            auto prev = (i + order.size() - 1) % order.size();
+            auto window = std::min({ transitionDays, lengthOf(prev), lengthOf(i) });
+            if (window == 0) continue;
+
+            auto first = startOf(order[i]) + kDaysPerYear - window / 2;
+            for (std::uint32_t o = 0; o < window; ++o) {
+                auto& day = calendar.days[(first + o) % kDaysPerYear];
+                day.season = o < window / 2 ? order[prev] : order[i];
+                day.from   = order[prev];
+                day.to     = order[i];
+                day.t      = (static_cast<float>(o) + 0.5f) / static_cast<float>(window);
+            }
+        }
+
+        return calendar;
+    }
+
+    std::shared_ptr<const CompiledSeasonCalendar> SeasonCalendar::Ensure(const Config& config) {
+        auto current = compiled_.load(std::memory_order_acquire);
+        if (current && current->startDays == config.seasonStartDays &&
+            current->transitionDays == config.transitionDays) {
+            return current;
+        }
+
+        auto compiled = std::make_shared<CompiledSeasonCalendar>(
+            CompiledSeasonCalendar::Build(config.seasonStartDays, config.transitionDays));
+        compiled->generation = current ? current->generation + 1 : 1;
+        compiled_.store(compiled, std::memory_order_release);
+
+        if (config.debugMode) {
+            logs::info("SeasonCalendar: Rebuilt day table (starts {}/{}/{}/{}, {}-day transitions)",
+                config.seasonStartDays[0], config.seasonStartDays[1], config.seasonStartDays[2],
+                config.seasonStartDays[3], config.transitionDays);
+        }
+        return compiled;
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "pch.h"
+#include "Config.h"
+
+#include <array>
+#include <memory>
+
+namespace SWF {
+
+    // Season weights for one day: from + (to - from) * t, where `from` and
+    // `to` are season slots of the chance table. Outside a transition
+    // window from == to and t == 0.
+    struct SeasonBlend {
+        Season season = Season::kWinter;   // the season the day belongs to
+        Season from   = Season::kWinter;
+        Season to     = Season::kWinter;
+        float  t      = 0.0f;
+
+        bool IsBlending() const { return from != to && t > 0.0f; }
+    };
+
+    // Season per day of the year from configurable start days, with a
+    // transition window centred on each start day. The whole year is
+    // precomputed into a day-of-year table when the settings change, so
+    // resolving a day is one index.
+    struct CompiledSeasonCalendar {
+        std::array<SeasonBlend, kDaysPerYear> days{};
+
+        std::array<std::uint32_t, 4> startDays{};
+        std::uint32_t                transitionDays = 0;
+        std::uint32_t                generation     = 0;   // bumped per rebuild
+
+        const SeasonBlend& Resolve(std::uint32_t dayOfYear) const { return days[dayOfYear % kDaysPerYear]; }
+
+        static CompiledSeasonCalendar Build(const std::array<std::uint32_t, 4>& startDays,
+                                            std::uint32_t transitionDays);
+    };
+
+    class SeasonCalendar {
+    public:
+        static SeasonCalendar& GetSingleton() {
+            static SeasonCalendar instance;
+            return instance;
+        }
+
+        // Rebuilds the table if the start days or window length changed.
+        // Game thread.
+        std::shared_ptr<const CompiledSeasonCalendar> Ensure(const Config& config);
+
+        // Last built table (may be null before the first Ensure). Any thread.
+        std::shared_ptr<const CompiledSeasonCalendar> Get() const {
+            return compiled_.load(std::memory_order_acquire);
+        }
+
+    private:
+        SeasonCalendar() = default;
+        ~SeasonCalendar() = default;
+        SeasonCalendar(const SeasonCalendar&) = delete;
+        SeasonCalendar& operator=(const SeasonCalendar&) = delete;
+
+        std::atomic<std::shared_ptr<const CompiledSeasonCalendar>> compiled_;
+    };
+}
@@ -0,0 +1,132 @@
+#include "StartupPipeline.h"
+#include "Config.h"
+#include "ConfigWatcher.h"
+#include "EntryOverrides.h"
+#include "PresetStore.h"
+#include "RegionOverrides.h"
+#include "RegionScanner.h"
+#include "RegionSearch.h"
+#include "WeatherManager.h"
+#include "WeatherOverrides.h"
+#include "UpdateHook.h"
+
+#include <chrono>
+
+namespace SWF {
+
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        // Logs how long one pipeline stage took and which thread ran it.
+        class StageTimer {
+        public:
+            explicit StageTimer(const char* name) : name_(name), start_(Clock::now()) {}
+
+            ~StageTimer() {
+                auto ms = std::chrono::duration<double, std::milli>(Clock::now() - start_).count();
+                logs::info("StartupPipeline: '{}' took {:.2f} ms on the {} thread", name_, ms,
+                    StartupPipeline::GetSingleton().IsGameThread() ? "game" : "worker");
+            }
+
+            StageTimer(const StageTimer&) = delete;
+            StageTimer& operator=(const StageTimer&) = delete;
+
+        private:
+            const char*       name_;
+            Clock::time_point start_;
+        };
+    }
+
+    void StartupPipeline::Start() {
+        if (started_.exchange(true)) return;
+
+        gameThread_ = std::this_thread::get_id();
+        Run();
+    }
+
+    FireAndForget StartupPipeline::Run() {
+        auto& scanner = RegionScanner::GetSingleton();
+        auto total = Clock::now();
+
+        // Config parsing is file I/O only.
+        co_await ResumeOnWorker{ TaskPriority::kHigh, "Startup: load config" };
+        {
+            StageTimer timer("Load config");
+            ConfigManager::GetSingleton().Load();
+        }
+
+        // Walking the region form array reads live records.
+        co_await ResumeOnGameThread{};
+        {
+            StageTimer timer("Scan regions");
+            scanner.ScanAllRegions();
+        }
+
+        co_await ResumeOnWorker{ TaskPriority::kHigh, "Startup: classify and pool" };
+        {
+            StageTimer timer("Classify weathers");
+            scanner.ClassifyWeathers();
+        }
+        {
+            StageTimer timer("Build worldspace pools");
+            scanner.BuildWorldspacePools();
+        }
+
+        // Injection mutates the regions' weather lists.
+        co_await ResumeOnGameThread{};
+        {
+            StageTimer timer("Inject missing weathers");
+            scanner.InjectMissingWeathers();
+        }
+
+        co_await ResumeOnWorker{ TaskPriority::kHigh, "Startup: chance tables" };
+        {
+            // Patterns and FormIDs are resolved once per scan; the table
+            // build below reuses the compiled indices.
+            StageTimer timer("Compile region overrides");
+            RegionOverrideIndex::GetSingleton().Ensure(ConfigManager::GetSingleton().GetConfig(),
+                scanner.GetRegionWeatherInfos(), scanner.GetGeneration());
+        }
+        {
+            StageTimer timer("Resolve weather overrides");
+            WeatherOverrideIndex::GetSingleton().Ensure(ConfigManager::GetSingleton().GetConfig(),
+                scanner.GetGeneration());
+        }
+        {
+            StageTimer timer("Import climate CSV");
+            if (auto scan = scanner.GetSnapshot()) EntryOverrideIndex::GetSingleton().Refresh(*scan);
+        }
+        {
+            StageTimer timer("Precompute chance tables");
+            WeatherManager::GetSingleton().RebuildChanceTable();
+        }
+
+        // Event sinks and the initial apply write to live records.
+        co_await ResumeOnGameThread{};
+        {
+            StageTimer timer("Install update hook");
+            UpdateHook::GetSingleton().Install();
+        }
+
+        complete_.store(true, std::memory_order_release);
+
+        if (ConfigManager::GetSingleton().GetConfig().hotReload) {
+            ConfigWatcher::GetSingleton().Start();
+        }
+
+        // Presets validate their tables against the final region layout.
+        PresetStore::GetSingleton().RequestRefresh();
+
+        // Only the menu searches regions; index the final layout off the
+        // startup path.
+        // Workers read the published snapshot, never the scanner's live infos.
+        WorkerPool::GetSingleton().Submit(TaskPriority::kNormal, "Build region search", []() {
+            if (auto scan = RegionScanner::GetSingleton().GetSnapshot()) {
+                RegionSearch::GetSingleton().Ensure(scan->infos, scan->generation);
+            }
+        });
+
+        auto ms = std::chrono::duration<double, std::milli>(Clock::now() - total).count();
+        logs::info("=== Seasonal Weather Framework: Initialization Complete ({:.2f} ms wall time) ===", ms);
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "pch.h"
+#include "Async.h"
+
+#include <thread>
+
+namespace SWF {
+
+    // Staged initialization run after kDataLoaded. Pure-compute stages
+    // (config parsing, weather classification, pool building, chance table
+    // precomputation) run on the worker pool; only the stages that touch
+    // live game records are resumed on the game thread. kDataLoaded itself
+    // returns immediately, so the loading screen no longer waits on us.
+    class StartupPipeline {
+    public:
+        static StartupPipeline& GetSingleton() {
+            static StartupPipeline instance;
+            return instance;
+        }
+
+        // Game thread only. Subsequent calls are ignored.
+        void Start();
+
+        bool IsComplete() const { return complete_.load(std::memory_order_acquire); }
+
+        bool IsGameThread() const { return std::this_thread::get_id() == gameThread_; }
+
+    private:
+        StartupPipeline() = default;
+        ~StartupPipeline() = default;
+        StartupPipeline(const StartupPipeline&) = delete;
+        StartupPipeline& operator=(const StartupPipeline&) = delete;
+
+        FireAndForget Run();
+
+        std::atomic<bool> started_  = false;
+        std::atomic<bool> complete_ = false;
+        std::thread::id   gameThread_;
+    };
+}
@@ -1,6 +1,11 @@
 #include "UpdateHook.h"
 #include "WeatherManager.h"
 #include "Config.h"
+#include "ConfigWatcher.h"
+#include "PerfStats.h"
+#include "WeatherResetPolicy.h"
+#include "RegionTracker.h"
+#include "WorkerPool.h"
 
 namespace SWF {
 
@@ -9,14 +14,21 @@ namespace SWF {
         RE::BSTEventSource<RE::MenuOpenCloseEvent>*) 
     {
         if (!a_event) return RE::BSEventNotifyControl::kContinue;
+        PerfStats::GetSingleton().Count(PerfEvent::kMenuOpenClose);
+        CheckQuit();
 
         auto& config = ConfigManager::GetSingleton().GetConfig();
         if (!config.enabled) return RE::BSEventNotifyControl::kContinue;
 
+        std::string_view menuName(a_event->menuName);
+
+        // A loading screen hides a weather reload; run any deferred reset now.
+        if (a_event->opening && menuName == RE::LoadingMenu::MENU_NAME) {
+            WeatherResetPolicy::GetSingleton().OnLoadingScreen();
+        }
+
         // Only trigger on close of menus that can advance game time
         if (!a_event->opening) {
-            std::string_view menuName(a_event->menuName);
-
             if (menuName == RE::SleepWaitMenu::MENU_NAME ||
                 menuName == RE::MapMenu::MENU_NAME) {
 
@@ -33,23 +45,21 @@ namespace SWF {
         return RE::BSEventNotifyControl::kContinue;
     }
 
-    RE::BSEventNotifyControl UpdateHook::CellChangeEventSink::ProcessEvent(
-        const RE::TESCellAttachDetachEvent* a_event,
-        RE::BSTEventSource<RE::TESCellAttachDetachEvent>*)
-    {
-        if (!a_event) return RE::BSEventNotifyControl::kContinue;
+    void UpdateHook::CheckQuit() {
+        auto* main = RE::Main::GetSingleton();
+        if (!main || !main->quitGame || quitHandled_.exchange(true)) return;
 
-        auto& config = ConfigManager::GetSingleton().GetConfig();
-        if (!config.enabled) return RE::BSEventNotifyControl::kContinue;
-
-        if (a_event->attached) {
-            // Cell changes can mean entering a different region.
-            // Only do a lightweight check — no ForceRefresh, just Update
-            // which will only re-apply if the season actually changed.
-            WeatherManager::GetSingleton().Update();
-        }
+        // The watcher first: a reload it finishes hands work to the pool.
+        logs::info("UpdateHook: Game is quitting, stopping config watcher and worker pool");
+        ConfigWatcher::GetSingleton().Stop();
+        WorkerPool::GetSingleton().Shutdown();
+    }
 
-        return RE::BSEventNotifyControl::kContinue;
+    void UpdateHook::PlayerUpdate::thunk(RE::PlayerCharacter* a_this, float a_delta) {
+        func(a_this, a_delta);
+        CheckQuit();
+        PerfStats::GetSingleton().Count(PerfEvent::kPlayerUpdate);
+        RegionTracker::GetSingleton().Tick();
     }
 
     void UpdateHook::Install() {
@@ -62,13 +72,11 @@ namespace SWF {
             logs::info("UpdateHook: Registered MenuOpenCloseEvent sink");
         }
 
-        // Register for cell attach/detach events
-        auto* eventSourceHolder = RE::ScriptEventSourceHolder::GetSingleton();
-        if (eventSourceHolder) {
-            eventSourceHolder->AddEventSink<RE::TESCellAttachDetachEvent>(
-                &CellChangeEventSink::GetSingleton());
-            logs::info("UpdateHook: Registered TESCellAttachDetachEvent sink");
-        }
+        // Hook the player update so RegionTracker can watch for region and
+        // worldspace changes at a fixed cadence.
+        REL::Relocation<std::uintptr_t> vtbl{ RE::VTABLE_PlayerCharacter[0] };
+        PlayerUpdate::func = vtbl.write_vfunc(PlayerUpdate::idx, PlayerUpdate::thunk);
+        logs::info("UpdateHook: Hooked PlayerCharacter::Update");
 
         // Do an initial weather update
         WeatherManager::GetSingleton().Update();
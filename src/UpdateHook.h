@@ -21,7 +21,13 @@ namespace SWF {
         UpdateHook(const UpdateHook&) = delete;
         UpdateHook& operator=(const UpdateHook&) = delete;
 
+        // Quit hook: once the game has been told to quit, stop the worker
+        // pool while the process is still running normally, rather than
+        // leaving it to static destruction under the loader lock.
+        static void CheckQuit();
+
         bool installed_ = false;
+        static inline std::atomic<bool> quitHandled_ = false;
 
         class MenuEventSink : public RE::BSTEventSink<RE::MenuOpenCloseEvent> {
         public:
@@ -35,16 +41,12 @@ namespace SWF {
                 RE::BSTEventSource<RE::MenuOpenCloseEvent>* a_eventSource) override;
         };
 
-        class CellChangeEventSink : public RE::BSTEventSink<RE::TESCellAttachDetachEvent> {
-        public:
-            static CellChangeEventSink& GetSingleton() {
-                static CellChangeEventSink instance;
-                return instance;
-            }
-
-            RE::BSEventNotifyControl ProcessEvent(
-                const RE::TESCellAttachDetachEvent* a_event,
-                RE::BSTEventSource<RE::TESCellAttachDetachEvent>* a_eventSource) override;
+        // PlayerCharacter::Update (vtable slot 0xAD) — drives RegionTracker,
+        // which replaces cell attach events as the movement trigger.
+        struct PlayerUpdate {
+            static void thunk(RE::PlayerCharacter* a_this, float a_delta);
+            static inline REL::Relocation<decltype(thunk)> func;
+            static constexpr std::size_t idx = 0xAD;
         };
     };
 }
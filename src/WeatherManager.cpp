@@ -1,6 +1,15 @@
 #include "WeatherManager.h"
 #include "Config.h"
+#include "EntryOverrides.h"
+#include "PerfStats.h"
+#include "RegionOverrides.h"
 #include "RegionScanner.h"
+#include "SeasonCalendar.h"
+#include "WeatherOverrides.h"
+#include "WeatherResetPolicy.h"
+#include "WorkerPool.h"
+
+#include <chrono>
 
 namespace SWF {
 
@@ -33,7 +42,7 @@ namespace SWF {
         return status;
     }
 
-    RE::TESWorldSpace* WeatherManager::GetPlayerWorldSpace() const {
+    RE::TESWorldSpace* WeatherManager::GetPlayerWorldSpace() {
         auto* player = RE::PlayerCharacter::GetSingleton();
         if (!player) return nullptr;
 
@@ -54,76 +63,317 @@ namespace SWF {
         return ConfigManager::GetSingleton().GetConfig().IsWorldspaceEnabled(editorID);
     }
 
-    void WeatherManager::ApplySeasonToRegions(Season season) {
-        auto& config = ConfigManager::GetSingleton().GetConfig();
-        const auto& mults = config.GetMultipliers(season);
+    void WeatherManager::RebuildChanceTable() {
+        auto& configManager = ConfigManager::GetSingleton();
+        auto& scanner = RegionScanner::GetSingleton();
+
+        const auto& config = configManager.GetConfig();
+        auto regionOverrides = RegionOverrideIndex::GetSingleton().Ensure(
+            config, scanner.GetRegionWeatherInfos(), scanner.GetGeneration());
+        auto weatherOverrides = WeatherOverrideIndex::GetSingleton().Ensure(config, scanner.GetGeneration());
+
+        // CSV values are imported on a worker. After a new scan the table is
+        // built without them until that import lands and re-applies.
+        auto& entryIndex = EntryOverrideIndex::GetSingleton();
+        auto entryOverrides = entryIndex.Get(scanner.GetGeneration());
+        if (!entryOverrides) entryIndex.RequestRefresh();
+
+        auto table = ChanceTable::Build(
+            scanner.GetRegionWeatherInfos(),
+            config,
+            { regionOverrides.get(), weatherOverrides.get(), entryOverrides.get() },
+            configManager.GetVersion(),
+            scanner.GetGeneration());
+
+        chanceTable_.store(std::move(table), std::memory_order_release);
+    }
+
+    std::shared_ptr<const ChanceTable> WeatherManager::EnsureChanceTable() {
+        // A previewed table trails the config only by multiplier edits the
+        // next patch (or the refresh that ends the preview) will cover.
+        auto table = chanceTable_.load(std::memory_order_acquire);
+        bool previewed = previewActive_ && table && table->configVersion >= previewStartVersion_;
+        auto generation = RegionScanner::GetSingleton().GetGeneration();
+        auto entries    = EntryOverrideIndex::GetSingleton().Get(generation);
+        if (!table ||
+            (table->configVersion != ConfigManager::GetSingleton().GetVersion() && !previewed) ||
+            table->scanGeneration != generation ||
+            table->entryImport != (entries ? entries->importId : 0)) {
+            RebuildChanceTable();
+            table = chanceTable_.load(std::memory_order_acquire);
+        }
+        return table;
+    }
+
+    void WeatherManager::ApplyConfigDiff(const ConfigDiff& diff, std::uint64_t previousVersion) {
+        auto start = std::chrono::steady_clock::now();
+        auto& configManager = ConfigManager::GetSingleton();
+        auto& scanner = RegionScanner::GetSingleton();
+        const auto& config = configManager.GetConfig();
+
+        if (diff.worldspaces) {
+            // Region membership changed: newly enabled worldspaces need their
+            // pools and injected entries. The config version bump (and the
+            // generation bump, if anything was injected) makes the next
+            // apply rebuild the whole table.
+            scanner.BuildWorldspacePools();
+            scanner.InjectMissingWeathers();
+            ForceRefresh();
+        } else if (diff.tables || (config.useMonthCurves && diff.HasMultiplierChanges())) {
+            // Override rules or month curves changed: the compiled indices
+            // and month slots are refreshed by the rebuild the version bump
+            // already forces. Season multipliers feed empty curves, so with
+            // curves on they take this path too.
+            ForceRefresh();
+        } else if (diff.HasMultiplierChanges()) {
+            // Patch only the entries of the classes whose multiplier moved.
+            // If the current table is not the one the diff was taken against,
+            // leave it stale and let the next apply rebuild it.
+            auto base = chanceTable_.load(std::memory_order_acquire);
+            if (base && base->configVersion == previousVersion &&
+                base->scanGeneration == scanner.GetGeneration()) {
+                auto regionOverrides = RegionOverrideIndex::GetSingleton().Ensure(
+                    config, scanner.GetRegionWeatherInfos(), scanner.GetGeneration());
+                auto weatherOverrides = WeatherOverrideIndex::GetSingleton().Ensure(config, scanner.GetGeneration());
+                auto entryOverrides = EntryOverrideIndex::GetSingleton().Get(scanner.GetGeneration());
+                chanceTable_.store(ChanceTable::WithUpdatedClasses(*base, scanner.GetRegionWeatherInfos(),
+                    config, { regionOverrides.get(), weatherOverrides.get(), entryOverrides.get() },
+                    configManager.GetVersion(),
+                    diff.multiplierClasses),
+                    std::memory_order_release);
+            }
+
+            // Other seasons' weights only reach the records when they become
+            // active; worldspace calendars may be showing any season.
+            if (diff.multiplierClasses[static_cast<std::size_t>(GetCurrentSeason())] != 0 ||
+                !config.worldspaceSeasons.empty()) {
+                ForceRefresh();
+            }
+        }
+
+        // Enabled and month changes are picked up by Update() itself: it
+        // restores base chances or re-applies only if the season moved.
+        Update();
+
+        auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        logs::info("WeatherManager: Hot reload applied in {:.3f} ms (enabled={}, months={}, worldspaces={}, "
+            "multipliers={}, tables={}, other={})", ms, diff.enabled, diff.months, diff.worldspaces,
+            diff.HasMultiplierChanges(), diff.tables, diff.other);
+    }
+
+    void WeatherManager::NoteMultiplierEdits(const SeasonClassMasks& classes, std::uint64_t previousVersion) {
+        if (!previewTracking_) {
+            previewTracking_     = true;
+            previewStartVersion_ = previousVersion;
+            previewFromVersion_  = previousVersion;
+            previewClasses_      = {};
+        }
+        for (std::size_t s = 0; s < classes.size(); ++s) previewClasses_[s] |= classes[s];
+    }
+
+    void WeatherManager::RequestPreview(bool forceWeather) {
+        if (!previewTracking_) return;
+        previewActive_ = true;
+        previewForce_ |= forceWeather;
+        if (!previewInFlight_) LaunchPreview();
+    }
+
+    void WeatherManager::EndPreview() {
+        previewTracking_ = false;
+        previewActive_   = false;
+        previewForce_    = false;
+        previewClasses_  = {};
+    }
+
+    void WeatherManager::LaunchPreview() {
+        if (std::ranges::all_of(previewClasses_, [](std::uint8_t m) { return m == 0; })) return;
+
+        auto& configManager = ConfigManager::GetSingleton();
+        auto& scanner = RegionScanner::GetSingleton();
+        auto base = chanceTable_.load(std::memory_order_acquire);
+
+        // The worker reads this snapshot, never the scanner's live infos.
+        auto scan = scanner.GetSnapshot();
 
+        // Patching is only exact on top of the table the noted edits started
+        // from. Month weights are never patched, so curves rebuild instead.
+        if (!base || base->configVersion != previewFromVersion_ || base->scanGeneration != scanner.GetGeneration() ||
+            !scan || scan->generation != base->scanGeneration ||
+            configManager.GetConfig().useMonthCurves || !SKSE::GetTaskInterface()) {
+            EndPreview();
+            ForceRefresh();
+            Update();
+            return;
+        }
+
+        auto classes      = previewClasses_;
+        auto forceWeather = previewForce_;
+        auto version      = configManager.GetVersion();
+        auto config       = configManager.GetSnapshot();
+        previewClasses_     = {};
+        previewForce_       = false;
+        previewFromVersion_ = version;
+        previewInFlight_    = true;
+
+        bool submitted = WorkerPool::GetSingleton().Submit(TaskPriority::kHigh, "Preview chance table",
+            [base, scan = std::move(scan), config, classes, forceWeather, version]() {
+                auto regionOverrides = RegionOverrideIndex::GetSingleton().Ensure(
+                    *config, scan->infos, scan->generation);
+                auto weatherOverrides = WeatherOverrideIndex::GetSingleton().Ensure(*config, scan->generation);
+                auto entryOverrides = EntryOverrideIndex::GetSingleton().Get(scan->generation);
+                std::shared_ptr<const ChanceTable> table = ChanceTable::WithUpdatedClasses(*base,
+                    scan->infos, *config,
+                    { regionOverrides.get(), weatherOverrides.get(), entryOverrides.get() }, version, classes);
+
+                SKSE::GetTaskInterface()->AddTask([base, table = std::move(table), classes, forceWeather]() mutable {
+                    WeatherManager::GetSingleton().FinishPreview(base, std::move(table), classes, forceWeather);
+                });
+            });
+        if (!submitted) {
+            previewInFlight_ = false;
+            EndPreview();
+            ForceRefresh();
+            Update();
+        }
+    }
+
+    void WeatherManager::FinishPreview(const std::shared_ptr<const ChanceTable>& base,
+                                       std::shared_ptr<const ChanceTable> table,
+                                       const SeasonClassMasks& classes, bool forceWeather) {
+        previewInFlight_ = false;
+
+        // Anything installed meanwhile (a full rebuild, a preset, an undo)
+        // wins over the patch, an ended preview drops it, and so does a
+        // rescan, whose entries the patch no longer lines up with.
+        if (previewActive_ && chanceTable_.load(std::memory_order_acquire) == base &&
+            table->scanGeneration == RegionScanner::GetSingleton().GetGeneration()) {
+            chanceTable_.store(table, std::memory_order_release);
+            Update();
+
+            auto season = GetCurrentSeason();
+            auto seasonClasses = classes[static_cast<std::size_t>(season)];
+            if (forceWeather && seasonClasses != 0) ForcePreviewWeather(*table, seasonClasses);
+        }
+
+        // Edits that arrived while the patch ran.
+        if (previewActive_) LaunchPreview();
+    }
+
+    void WeatherManager::ForcePreviewWeather(const ChanceTable& table, std::uint8_t classes) {
+        auto* sky = RE::Sky::GetSingleton();
+        if (!sky || !sky->region) return;
+
+        const auto* info = RegionScanner::GetSingleton().FindRegionInfo(sky->region);
+        const auto* slot = table.FindSlot(sky->region);
+        if (!info || !slot || !slot->managed) return;
+
+        // The heaviest entry of the edited classes in the season now applied.
+        const float*    weights = table.GetSeasonWeights(GetCurrentSeason());
+        RE::TESWeather* best    = nullptr;
+        float           bestWeight = 0.0f;
+        for (std::uint32_t i = 0; i < slot->entryCount && i < info->originalWeatherEntries.size(); ++i) {
+            const auto& entry = info->originalWeatherEntries[i];
+            if (!entry.weather || !(classes & (1u << static_cast<std::uint32_t>(entry.classification)))) continue;
+            if (weights[slot->firstEntry + i] > bestWeight) {
+                best       = entry.weather;
+                bestWeight = weights[slot->firstEntry + i];
+            }
+        }
+
+        if (best && best != sky->currentWeather) {
+            sky->ForceWeather(best, false);
+            logs::info("WeatherManager: Preview forced {} in {}", RegionScanner::GetWeatherName(best),
+                info->editorID);
+        }
+    }
+
+    WeatherManager::SlotSelection WeatherManager::SelectSlot(const Config& config, const ChanceTable& table,
+                                                             std::uint32_t dayOfYear) const {
+        SlotSelection selection;
+        if (hasSeasonOverride_) {
+            selection.season = seasonOverride_;
+            selection.key    = static_cast<std::uint32_t>(seasonOverride_);
+            selection.a      = table.GetSeasonWeights(seasonOverride_);
+            return selection;
+        }
+
+        std::uint32_t dayOfMonth = 1;
+        auto month = GetMonthOfDay(dayOfYear, &dayOfMonth);
+        selection.season = config.GetSeasonForMonth(month);
+
+        if (config.useMonthCurves && table.HasMonthWeights()) {
+            // The month slot, blended toward the next month's when
+            // interpolating days.
+            auto day = config.interpolateDays ? dayOfMonth : 0u;
+            selection.key  = (1ull << 48) | (month << 8) | day;
+            selection.mode = "month";
+            selection.a    = table.GetMonthWeights(month);
+            if (day > 1) {
+                selection.b = table.GetMonthWeights(month + 1);
+                selection.t = static_cast<float>(day - 1) / static_cast<float>(GetDaysInMonth(month));
+            }
+        } else if (config.useDayCalendar) {
+            // The calendar table is rebuilt only when its settings change;
+            // its generation is part of the key so a rebuild re-applies.
+            auto calendar = SeasonCalendar::GetSingleton().Ensure(config);
+            const auto& blend = calendar->Resolve(dayOfYear);
+            selection.season = blend.season;
+            selection.key    = (2ull << 48) | (static_cast<std::uint64_t>(calendar->generation) << 16) | dayOfYear;
+            selection.mode   = "calendar";
+            selection.a      = table.GetSeasonWeights(blend.from);
+            if (blend.IsBlending()) {
+                selection.b = table.GetSeasonWeights(blend.to);
+                selection.t = blend.t;
+            }
+        } else {
+            selection.key = static_cast<std::uint32_t>(selection.season);
+            selection.a   = table.GetSeasonWeights(selection.season);
+        }
+        return selection;
+    }
+
+    void WeatherManager::ApplyPartition(const ChanceTable& table, std::size_t partition,
+                                        const SlotSelection& selection) {
+        PerfScope perf(PerfTimer::kApply);
+        auto& config = ConfigManager::GetSingleton().GetConfig();
         auto& regionInfos = RegionScanner::GetSingleton().GetRegionWeatherInfos();
-        std::uint32_t regionsModified = 0;
+        const float* a = selection.a;
+        const float* b = selection.b;
+        float        t = selection.t;
 
-        for (const auto& info : regionInfos) {
-            // Only touch regions that belong to an enabled worldspace.
-            // Regions with no associated worldspace pointer are skipped — we
-            // can't determine where they apply, so it's safer to leave them alone.
-            if (!info.worldSpace) continue;
-            auto wsID = info.worldSpace->GetFormEditorID();
-            if (!wsID || !config.IsWorldspaceEnabled(wsID)) continue;
+        std::uint32_t regionsModified = 0;
+        std::uint32_t entriesWritten  = 0;
 
-            if (!info.weatherData) continue;
+        // A flat walk over this partition's managed regions; which slots to
+        // read was decided once for the whole partition.
+        for (auto r : table.partitions[partition].regions) {
+            if (r >= regionInfos.size()) break;
+            const auto& info = regionInfos[r];
+            const auto& slot = table.regions[r];
+            if (!slot.managed || !info.weatherData) continue;
 
             std::size_t i = 0;
             for (auto& wt : info.weatherData->weatherTypes) {
-                if (!wt || i >= info.originalWeatherEntries.size()) break;
+                if (!wt || i >= slot.entryCount) break;
                 const auto& orig = info.originalWeatherEntries[i];
 
-                // For injected weathers (baseChance == 0), use a small base value
-                // so season multipliers can give them a non-zero chance.
-                // This allows e.g. snow to appear in regions that don't normally have it.
-                constexpr float kInjectedBaseChance = 10.0f;
-                float base = (orig.baseChance > 0)
-                    ? static_cast<float>(orig.baseChance)
-                    : kInjectedBaseChance;
-
-                float adjusted = base;
+                auto e = slot.firstEntry + i;
+                float adjusted = b ? a[e] + (b[e] - a[e]) * t : a[e];
 
                 // Apply TESGlobal scale if the region record carries one.
                 if (orig.global) {
                     adjusted *= orig.global->value;
                 }
 
-                // Apply the season multiplier for this weather's classification.
-                // kUnknown weathers (quest / scripted weathers with no
-                // pleasant/cloudy/rainy/snow flag) are zeroed out so they
-                // don't compete with seasonal weathers in the region table.
-                switch (orig.classification) {
-                    case WeatherClass::kPleasant: adjusted *= mults.pleasantMult; break;
-                    case WeatherClass::kCloudy:   adjusted *= mults.cloudyMult;   break;
-                    case WeatherClass::kRainy:    adjusted *= mults.rainyMult;    break;
-                    case WeatherClass::kSnow:     adjusted *= mults.snowMult;     break;
-                    default:
-                        adjusted = 0.0f;
-                        break;
-                }
-
-                // If this was an injected entry with base 0, and the multiplier is 0,
-                // make sure we write back 0 (not kInjectedBaseChance * 0 = 0, which is fine,
-                // but explicitly zero for clarity).
-                if (orig.baseChance == 0) {
-                    float mult = 0.0f;
-                    switch (orig.classification) {
-                        case WeatherClass::kPleasant: mult = mults.pleasantMult; break;
-                        case WeatherClass::kCloudy:   mult = mults.cloudyMult;   break;
-                        case WeatherClass::kRainy:    mult = mults.rainyMult;    break;
-                        case WeatherClass::kSnow:     mult = mults.snowMult;     break;
-                        default: mult = 0.0f; break;
-                    }
-                    if (mult <= 0.0f) adjusted = 0.0f;
-                }
-
-                // Write back; clamp to zero but allow any positive float —
+                // Clamp to zero but allow any positive float —
                 // Skyrim normalises the table internally before selection.
                 auto finalChance = static_cast<std::uint32_t>((std::max)(adjusted, 0.0f));
-                wt->chance = finalChance;
+
+                // Delta write: leave untouched entries alone.
+                if (wt->chance != finalChance) {
+                    wt->chance = finalChance;
+                    ++entriesWritten;
+                }
 
                 if (config.debugMode && finalChance > 0) {
                     auto wname = RegionScanner::GetWeatherName(orig.weather);
@@ -136,8 +386,41 @@ namespace SWF {
             ++regionsModified;
         }
 
-        logs::info("WeatherManager: Applied '{}' season weights to {} region records",
-            SeasonToString(season), regionsModified);
+        const auto& worldspace = table.partitions[partition].worldspace;
+        logs::info("WeatherManager: Applied '{}' {} weights{} to {} region records{} ({} entries changed)",
+            SeasonToString(selection.season), selection.mode,
+            b ? std::format(" ({:.0f}% blended)", t * 100.0f) : std::string(),
+            regionsModified, worldspace.empty() ? std::string() : " in " + worldspace, entriesWritten);
+    }
+
+    void WeatherManager::RestoreNoLongerManaged(const ChanceTable& previous, const ChanceTable& table) {
+        auto& regionInfos = RegionScanner::GetSingleton().GetRegionWeatherInfos();
+
+        // After a rescan the indices no longer line up; any unmanaged region
+        // may have been managed before, so all of them get restored once.
+        bool sameScan = previous.scanGeneration == table.scanGeneration &&
+                        previous.regions.size() == table.regions.size();
+
+        std::uint32_t restored = 0;
+        for (std::size_t r = 0; r < table.regions.size() && r < regionInfos.size(); ++r) {
+            if (table.regions[r].managed || (sameScan && !previous.regions[r].managed)) continue;
+
+            const auto& info = regionInfos[r];
+            if (!info.weatherData) continue;
+
+            // Injected entries have a zero base chance, so they drop out too.
+            std::size_t i = 0;
+            for (auto& wt : info.weatherData->weatherTypes) {
+                if (!wt || i >= info.originalWeatherEntries.size()) break;
+                wt->chance = info.originalWeatherEntries[i].baseChance;
+                ++i;
+            }
+            ++restored;
+        }
+
+        if (restored > 0) {
+            logs::info("WeatherManager: Restored base chances to {} regions no longer managed", restored);
+        }
     }
 
     void WeatherManager::RestoreBaseChances() {
@@ -162,6 +445,7 @@ namespace SWF {
 
     void WeatherManager::Update() {
         std::lock_guard<std::mutex> lock(mutex_);
+        PerfScope perf(PerfTimer::kUpdate);
 
         auto& config = ConfigManager::GetSingleton().GetConfig();
 
@@ -177,40 +461,62 @@ namespace SWF {
         currentWorldSpace_ = GetPlayerWorldSpace();
         isActive_ = IsInManagedWorldSpace();
 
-        // Determine effective season.
-        Season effectiveSeason;
-        if (hasSeasonOverride_) {
-            effectiveSeason = seasonOverride_;
-        } else {
-            effectiveSeason = config.GetSeasonForMonth(GetCurrentMonth());
+        // A new table (config or scan change) or a forced refresh re-applies
+        // every partition; otherwise only partitions whose slot moved.
+        auto table = EnsureChanceTable();
+        if (!hasApplied_ || table != appliedTable_ || forceRefresh_.load(std::memory_order_relaxed)) {
+            partitionKeys_.assign(table->partitions.size(), kNoSlotKey);
+        }
+        if (hasApplied_ && appliedTable_ && table != appliedTable_) {
+            RestoreNoLongerManaged(*appliedTable_, *table);
         }
 
-        bool seasonChanged = (effectiveSeason != currentSeason_);
-        bool needsApply    = !hasApplied_ || seasonChanged ||
-                             forceRefresh_.load(std::memory_order_relaxed);
+        // The player's region slot carries its partition; fall back to the
+        // worldspace name between regions.
+        std::size_t playerPartition = 0;
+        auto* sky = RE::Sky::GetSingleton();
+        if (const auto* slot = table->FindSlot(sky ? sky->region : nullptr)) {
+            playerPartition = slot->partition;
+        } else if (currentWorldSpace_) {
+            if (auto editorID = currentWorldSpace_->GetFormEditorID()) playerPartition = table->FindPartition(editorID);
+        }
 
-        if (!needsApply) {
-            return;
+        // Each partition sees the date shifted by its worldspace offset; the
+        // season reported (and notified) is the player's partition's.
+        auto today = GetDayOfYear(GetCurrentMonth(), GetCurrentDayOfMonth());
+        Season effectiveSeason = currentSeason_;
+        std::size_t partitionsApplied = 0;
+        for (std::size_t p = 0; p < table->partitions.size(); ++p) {
+            auto offset = table->partitions[p].offsetDays % static_cast<std::int32_t>(kDaysPerYear);
+            auto day = static_cast<std::uint32_t>(static_cast<std::int32_t>(today + kDaysPerYear) + offset) % kDaysPerYear;
+
+            auto selection = SelectSlot(config, *table, day);
+            if (p == playerPartition) effectiveSeason = selection.season;
+            if (selection.key == partitionKeys_[p]) continue;
+
+            ApplyPartition(*table, p, selection);
+            partitionKeys_[p] = selection.key;
+            ++partitionsApplied;
         }
 
+        bool seasonChanged = (effectiveSeason != currentSeason_);
         if (seasonChanged && hasApplied_ && config.enableNotifications) {
             logs::info("WeatherManager: Season changed to {}", SeasonToString(effectiveSeason));
         }
-
         currentSeason_ = effectiveSeason;
 
-        ApplySeasonToRegions(effectiveSeason);
-
-        // Force Skyrim to re-pick weather from the modified table, but only
-        // when we actually changed something.
-        auto* sky = RE::Sky::GetSingleton();
-        if (sky) {
-            sky->ResetWeather();
-            logs::info("WeatherManager: Called Sky::ResetWeather() to force re-evaluation");
+        if (partitionsApplied == 0) {
+            WeatherResetPolicy::GetSingleton().Poll();
+            return;
         }
 
+        // Let the policy decide whether Skyrim has to re-pick weather from
+        // the modified table now, later, or not at all.
+        WeatherResetPolicy::GetSingleton().OnTableApplied();
+
         hasApplied_        = true;
         lastAppliedSeason_ = effectiveSeason;
+        appliedTable_      = std::move(table);
         forceRefresh_.store(false, std::memory_order_relaxed);
     }
 }
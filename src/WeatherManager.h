@@ -4,7 +4,9 @@
 #include "Season.h"
 #include "Config.h"
 #include "RegionScanner.h"
+#include "ChanceTable.h"
 
+#include <memory>
 #include <mutex>
 
 namespace SWF {
@@ -42,6 +44,9 @@ namespace SWF {
             return currentWorldSpace_;
         }
 
+        // Get the player's current worldspace (null if interior or unavailable)
+        static RE::TESWorldSpace* GetPlayerWorldSpace();
+
         // Status
         bool IsActive() const {
             std::lock_guard<std::mutex> lock(mutex_);
@@ -52,6 +57,46 @@ namespace SWF {
         // Force weather refresh on next update
         void ForceRefresh() { forceRefresh_.store(true, std::memory_order_relaxed); }
 
+        // Recompute the per-season chance table from the current config and
+        // region snapshot. Pure compute — safe to call from a worker thread.
+        void RebuildChanceTable();
+
+        // Re-apply after a hot reload, touching only what `diff` says changed.
+        // `previousVersion` is the config version the diff was taken against.
+        // Game thread.
+        void ApplyConfigDiff(const ConfigDiff& diff, std::uint64_t previousVersion);
+
+        std::shared_ptr<const ChanceTable> GetChanceTable() const {
+            return chanceTable_.load(std::memory_order_acquire);
+        }
+
+        // Rebuild the chance table if the config or region table changed
+        // since it was built. Game thread.
+        std::shared_ptr<const ChanceTable> EnsureChanceTable();
+
+        // Publish a table computed elsewhere (e.g. a preset). Its version
+        // stamps must match the live config and scan, or the next apply
+        // rebuilds it.
+        void InstallChanceTable(std::shared_ptr<const ChanceTable> table) {
+            chanceTable_.store(std::move(table), std::memory_order_release);
+        }
+
+        using SeasonClassMasks = std::array<std::uint8_t, static_cast<std::size_t>(Season::kTotal)>;
+
+        // Live preview while a multiplier slider is dragged. Game thread.
+        //
+        // NoteMultiplierEdits() records which (season, class) multipliers a
+        // batch changed on top of `previousVersion`. RequestPreview() patches
+        // the live table for everything noted since it was built, on a
+        // worker, then installs it and re-applies from a game-thread task;
+        // requests made while a patch is running are folded into the next
+        // one. With `forceWeather` the player's region switches to its
+        // strongest weather of the edited class. Until EndPreview() the
+        // patched table is used as-is instead of being rebuilt.
+        void NoteMultiplierEdits(const SeasonClassMasks& classes, std::uint64_t previousVersion);
+        void RequestPreview(bool forceWeather);
+        void EndPreview();
+
     private:
         WeatherManager() = default;
         ~WeatherManager() = default;
@@ -60,10 +105,37 @@ namespace SWF {
 
         bool IsInManagedWorldSpace() const;
 
-        // Get the player's current worldspace (null if interior or unavailable)
-        RE::TESWorldSpace* GetPlayerWorldSpace() const;
-
-        void ApplySeasonToRegions(Season season);
+        // The precomputed weights a partition shows on one day: slot `a`,
+        // blended toward `b` by `t` (b is null when not blending). Equal
+        // keys mean identical weights, so the apply can be skipped.
+        struct SlotSelection {
+            std::uint64_t key    = 0;
+            Season        season = Season::kWinter;
+            const char*   mode   = "season";
+            const float*  a      = nullptr;
+            const float*  b      = nullptr;
+            float         t      = 0.0f;
+        };
+
+        static constexpr std::uint64_t kNoSlotKey = ~0ull;
+
+        // Season override, month curves, day calendar or month ranges, in
+        // that order of precedence. Caller holds mutex_.
+        SlotSelection SelectSlot(const Config& config, const ChanceTable& table, std::uint32_t dayOfYear) const;
+
+        // Writes the selection to one partition's regions, touching only
+        // records whose chance differs.
+        void ApplyPartition(const ChanceTable& table, std::size_t partition, const SlotSelection& selection);
+
+        // Gives regions that were managed under `previous` but are not under
+        // `table` their base chances back. Unmanaged regions are otherwise
+        // never written.
+        void RestoreNoLongerManaged(const ChanceTable& previous, const ChanceTable& table);
+
+        void LaunchPreview();
+        void FinishPreview(const std::shared_ptr<const ChanceTable>& base, std::shared_ptr<const ChanceTable> table,
+                           const SeasonClassMasks& classes, bool forceWeather);
+        void ForcePreviewWeather(const ChanceTable& table, std::uint8_t classes);
 
         Season              currentSeason_    = Season::kWinter;
         Season              seasonOverride_   = Season::kWinter;
@@ -72,7 +144,21 @@ namespace SWF {
         std::atomic<bool>   forceRefresh_      = false;
         bool                hasApplied_        = false;  
         Season              lastAppliedSeason_ = Season::kWinter;
+        std::vector<std::uint64_t>         partitionKeys_;   // last applied slot per table partition
+        std::shared_ptr<const ChanceTable> appliedTable_;
         RE::TESWorldSpace*  currentWorldSpace_ = nullptr;
+        std::atomic<std::shared_ptr<const ChanceTable>> chanceTable_;
         mutable std::mutex       mutex_;
+
+        // Preview chain, game thread only. `previewClasses_` holds the
+        // multipliers edited since config version `previewFromVersion_`;
+        // every table of the chain is at least `previewStartVersion_`.
+        bool                previewTracking_     = false;
+        bool                previewActive_       = false;   // a preview was requested since tracking began
+        bool                previewInFlight_     = false;
+        bool                previewForce_        = false;
+        std::uint64_t       previewStartVersion_ = 0;
+        std::uint64_t       previewFromVersion_  = 0;
+        SeasonClassMasks    previewClasses_{};
     };
 }
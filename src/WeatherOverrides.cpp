@@ -0,0 +1,123 @@
+#include "WeatherOverrides.h"
+#include "IniParser.h"
+#include "RegionOverrides.h"
+#include "RegionScanner.h"
+
+#include <chrono>
+
+namespace SWF {
+
+    namespace {
+        constexpr float kMaxMultiplier = 10.0f;
+
+        bool ParseFormID(std::string_view str, RE::FormID& out) {
+            if (str.starts_with("0x") || str.starts_with("0X")) str.remove_prefix(2);
+            RE::FormID value = 0;
+            auto [ptr, ec] = std::from_chars(str.data(), str.data() + str.size(), value, 16);
+            if (str.empty() || ec != std::errc{} || ptr != str.data() + str.size() || value == 0) return false;
+            out = value;
+            return true;
+        }
+    }
+
+    bool ParseWeatherOverrideRule(std::string_view key, std::string_view value, WeatherOverrideRule& out) {
+        auto bar = key.find('|');
+        if (bar == std::string_view::npos) return false;
+
+        WeatherOverrideRule rule;
+        rule.plugin = std::string(TrimView(key.substr(0, bar)));
+        if (rule.plugin.empty() || !ParseFormID(TrimView(key.substr(bar + 1)), rule.localFormID)) return false;
+
+        bool ok = true;
+        ForEachCSVToken(value, [&](std::string_view item) {
+            if (!ok) return;
+
+            auto eq = item.find('=');
+            float multiplier = 0.0f;
+            auto seasons = eq == std::string_view::npos ? 0u : ParseSeasonMask(TrimView(item.substr(0, eq)));
+            if (seasons == 0 || !ParseIniFloat(TrimView(item.substr(eq + 1)), multiplier)) {
+                ok = false;
+                return;
+            }
+
+            multiplier = std::clamp(multiplier, 0.0f, kMaxMultiplier);
+            rule.seasonMask |= static_cast<std::uint8_t>(seasons);
+            for (std::uint32_t s = 0; s < static_cast<std::uint32_t>(Season::kTotal); ++s) {
+                if (seasons & (1u << s)) rule.multipliers[s] = multiplier;
+            }
+        });
+
+        if (!ok || rule.seasonMask == 0) return false;
+        out = std::move(rule);
+        return true;
+    }
+
+    void FormatWeatherOverrideRule(const WeatherOverrideRule& rule, std::string& out) {
+        std::format_to(std::back_inserter(out), "{}|0x{:06X} = ", rule.plugin, rule.localFormID);
+        bool first = true;
+        for (std::uint32_t s = 0; s < static_cast<std::uint32_t>(Season::kTotal); ++s) {
+            auto season = static_cast<Season>(s);
+            if (!rule.Has(season)) continue;
+            std::format_to(std::back_inserter(out), "{}{}={:.2f}", first ? "" : ", ", SeasonToString(season),
+                rule.Get(season, 0.0f));
+            first = false;
+        }
+        out += '\n';
+    }
+
+    std::shared_ptr<const CompiledWeatherOverrides> WeatherOverrideIndex::Resolve(
+        const std::vector<WeatherOverrideRule>& rules, std::uint64_t scanGeneration)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto& scanner = RegionScanner::GetSingleton();
+
+        auto compiled = std::make_shared<CompiledWeatherOverrides>();
+        compiled->rules          = rules;
+        compiled->scanGeneration = scanGeneration;
+        compiled->weatherRule.assign(scanner.GetUniqueWeathers().size(), 0);
+        if (rules.empty()) return compiled;
+
+        auto* dataHandler = RE::TESDataHandler::GetSingleton();
+        std::size_t resolved = 0;
+
+        // In rule order, so a later rule for the same weather replaces an earlier one.
+        for (std::size_t i = 0; i < rules.size(); ++i) {
+            const auto& rule = rules[i];
+            auto* weather = dataHandler ? dataHandler->LookupForm<RE::TESWeather>(rule.localFormID, rule.plugin) : nullptr;
+            if (!weather) {
+                logs::warn("WeatherOverrides: {}|0x{:06X} is not a loaded weather, rule ignored",
+                    rule.plugin, rule.localFormID);
+                continue;
+            }
+
+            auto index = scanner.GetWeatherIndex(weather->GetFormID());
+            if (index == kNoWeatherIndex) {
+                logs::info("WeatherOverrides: {} [{:08X}] is not used by any region, rule has no effect",
+                    RegionScanner::GetWeatherName(weather), weather->GetFormID());
+                continue;
+            }
+
+            compiled->weatherRule[index] = static_cast<std::uint32_t>(i + 1);
+            ++resolved;
+        }
+
+        auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        logs::info("WeatherOverrides: Resolved {} of {} rules in {:.3f} ms", resolved, rules.size(), ms);
+        return compiled;
+    }
+
+    std::shared_ptr<const CompiledWeatherOverrides> WeatherOverrideIndex::Ensure(
+        const Config& config, std::uint64_t scanGeneration)
+    {
+        std::lock_guard<std::mutex> lock(resolveMutex_);
+
+        auto current = compiled_.load(std::memory_order_acquire);
+        if (current && current->scanGeneration == scanGeneration && current->rules == config.weatherOverrides) {
+            return current;
+        }
+
+        auto compiled = Resolve(config.weatherOverrides, scanGeneration);
+        compiled_.store(compiled, std::memory_order_release);
+        return compiled;
+    }
+}
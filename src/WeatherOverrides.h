@@ -0,0 +1,67 @@
+#pragma once
+
+#include "pch.h"
+#include "Config.h"
+
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace SWF {
+
+    // Key "Plugin.esp|0x01ABCD" (local FormID, hex, 0x optional) and value
+    // "Winter=3.0, Summer=0, *=1" (season names as in [RegionOverrides]).
+    // Multipliers are clamped to [0, 10]. Returns false on malformed input.
+    bool ParseWeatherOverrideRule(std::string_view key, std::string_view value, WeatherOverrideRule& out);
+
+    // "key = value\n" line for one rule, inverse of ParseWeatherOverrideRule().
+    void FormatWeatherOverrideRule(const WeatherOverrideRule& rule, std::string& out);
+
+    // Weather override rules resolved to dense weather indices (positions
+    // in RegionScanner::GetUniqueWeathers(), which every RegionWeatherEntry
+    // carries), so the chance table build indexes an array per entry and
+    // never hashes a FormID.
+    struct CompiledWeatherOverrides {
+        // Parallel to GetUniqueWeathers(); 0 = no override, otherwise
+        // 1 + index into `rules`.
+        std::vector<std::uint32_t>       weatherRule;
+        std::vector<WeatherOverrideRule> rules;
+
+        std::uint64_t scanGeneration = 0;
+
+        const WeatherOverrideRule* ForWeather(std::uint32_t weatherIndex) const {
+            if (weatherIndex >= weatherRule.size() || weatherRule[weatherIndex] == 0) return nullptr;
+            return &rules[weatherRule[weatherIndex] - 1];
+        }
+    };
+
+    class WeatherOverrideIndex {
+    public:
+        static WeatherOverrideIndex& GetSingleton() {
+            static WeatherOverrideIndex instance;
+            return instance;
+        }
+
+        // Resolves `config`'s rules against the current scan, only if the
+        // rules or the scan generation changed since the last call. Rules
+        // whose plugin or form is missing are reported once per resolve.
+        std::shared_ptr<const CompiledWeatherOverrides> Ensure(const Config& config, std::uint64_t scanGeneration);
+
+        std::shared_ptr<const CompiledWeatherOverrides> Get() const {
+            return compiled_.load(std::memory_order_acquire);
+        }
+
+    private:
+        WeatherOverrideIndex() = default;
+        ~WeatherOverrideIndex() = default;
+        WeatherOverrideIndex(const WeatherOverrideIndex&) = delete;
+        WeatherOverrideIndex& operator=(const WeatherOverrideIndex&) = delete;
+
+        static std::shared_ptr<const CompiledWeatherOverrides> Resolve(
+            const std::vector<WeatherOverrideRule>& rules, std::uint64_t scanGeneration);
+
+        std::atomic<std::shared_ptr<const CompiledWeatherOverrides>> compiled_;
+        std::mutex                                                   resolveMutex_;
+    };
+}
@@ -0,0 +1,112 @@
+#include "WeatherResetPolicy.h"
+#include "Config.h"
+#include "RegionScanner.h"
+
+namespace SWF {
+
+    void WeatherResetPolicy::LogDecision(const char* decision, const std::string& reason) {
+        logs::info("WeatherResetPolicy: {} - {}", decision, reason);
+    }
+
+    std::int64_t WeatherResetPolicy::GetCurrentWeatherChance(RE::Sky* sky) {
+        if (!sky || !sky->region || !sky->currentWeather) return -1;
+
+        const auto* info = RegionScanner::GetSingleton().FindRegionInfo(sky->region);
+        if (!info || !info->weatherData) return -1;
+
+        for (auto& wt : info->weatherData->weatherTypes) {
+            if (wt && wt->weather == sky->currentWeather) {
+                return static_cast<std::int64_t>(wt->chance);
+            }
+        }
+        return -1;
+    }
+
+    void WeatherResetPolicy::OnTableApplied() {
+        bool immediate = immediateRequested_;
+        immediateRequested_ = false;
+
+        auto* sky = RE::Sky::GetSingleton();
+        if (sky && immediate) {
+            TryReset(sky, "explicit re-apply", true);
+            return;
+        }
+
+        if (!sky || !sky->currentWeather) {
+            pending_ = false;
+            LogDecision("skip", "no current weather");
+            return;
+        }
+
+        auto weatherName = RegionScanner::GetWeatherName(sky->currentWeather);
+
+        if (sky->overrideWeather) {
+            pending_ = false;
+            LogDecision("skip", std::format("weather override '{}' is active",
+                RegionScanner::GetWeatherName(sky->overrideWeather)));
+            return;
+        }
+
+        auto chance = GetCurrentWeatherChance(sky);
+        if (chance < 0) {
+            pending_ = false;
+            LogDecision("skip", std::format("current weather '{}' is not in the current region's table",
+                weatherName));
+            return;
+        }
+
+        if (chance > 0) {
+            pending_ = false;
+            LogDecision("skip", std::format("current weather '{}' still has chance {}",
+                weatherName, chance));
+            return;
+        }
+
+        pending_        = true;
+        pendingWeather_ = sky->currentWeather;
+
+        LogDecision("defer", std::format("current weather '{}' now has chance 0; "
+            "waiting for the next weather transition or loading screen", weatherName));
+    }
+
+    void WeatherResetPolicy::Poll() {
+        if (!pending_) return;
+
+        auto* sky = RE::Sky::GetSingleton();
+        if (!sky) return;
+
+        if (sky->currentWeather != pendingWeather_) {
+            pending_ = false;
+            LogDecision("resolved", std::format("natural transition to '{}' picked from the new table",
+                RegionScanner::GetWeatherName(sky->currentWeather)));
+        }
+    }
+
+    void WeatherResetPolicy::OnLoadingScreen() {
+        if (!pending_) return;
+        TryReset(RE::Sky::GetSingleton(), "loading screen");
+    }
+
+    void WeatherResetPolicy::TryReset(RE::Sky* sky, const char* trigger, bool force) {
+        if (!sky) return;
+
+        const auto& config = ConfigManager::GetSingleton().GetConfig();
+        auto now = Clock::now();
+
+        if (hasReset_ && !force) {
+            auto elapsed = std::chrono::duration<float>(now - lastReset_).count();
+            if (elapsed < config.minResetIntervalSeconds) {
+                // Stays pending; a later transition or loading screen resolves it.
+                LogDecision("rate-limited", std::format("{}: last reset {:.1f}s ago (minimum {:.1f}s)",
+                    trigger, elapsed, config.minResetIntervalSeconds));
+                return;
+            }
+        }
+
+        sky->ResetWeather();
+        hasReset_  = true;
+        lastReset_ = now;
+        pending_   = false;
+        LogDecision("reset", std::format("{}: called Sky::ResetWeather()", trigger));
+    }
+}
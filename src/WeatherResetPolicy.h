@@ -0,0 +1,61 @@
+#pragma once
+
+#include "pch.h"
+
+#include <chrono>
+
+namespace SWF {
+
+    // Decides whether a freshly applied chance table needs Sky::ResetWeather().
+    // A reset forces an immediate, visible weather reload, so it is avoided
+    // whenever the game will pick from the new table on its own:
+    //   - the current weather still has a non-zero chance  -> skip
+    //   - otherwise                                        -> defer until the
+    //     next natural weather transition or loading screen
+    //   - resets are rate-limited by [Transitions] fMinResetIntervalSeconds
+    //   - an explicit re-apply always resets, bypassing all of the above
+    // Every decision is logged with its reason. Game thread only.
+    class WeatherResetPolicy {
+    public:
+        static WeatherResetPolicy& GetSingleton() {
+            static WeatherResetPolicy instance;
+            return instance;
+        }
+
+        // Called after season weights were written to the region records.
+        void OnTableApplied();
+
+        // The next OnTableApplied() resets unconditionally: no skip checks,
+        // no deferral, no rate limit. Used for explicit "Re-apply" requests.
+        void RequestImmediateReset() { immediateRequested_ = true; }
+
+        // Cheap check for a natural transition that resolves a pending reset.
+        void Poll();
+
+        // A loading screen hides the reload, so pending resets happen here.
+        void OnLoadingScreen();
+
+        bool HasPendingReset() const { return pending_; }
+
+    private:
+        WeatherResetPolicy() = default;
+        ~WeatherResetPolicy() = default;
+        WeatherResetPolicy(const WeatherResetPolicy&) = delete;
+        WeatherResetPolicy& operator=(const WeatherResetPolicy&) = delete;
+
+        using Clock = std::chrono::steady_clock;
+
+        // Live chance of the sky's current weather in the sky's current
+        // region, or -1 if that weather is not part of the region's table.
+        static std::int64_t GetCurrentWeatherChance(RE::Sky* sky);
+
+        void TryReset(RE::Sky* sky, const char* trigger, bool force = false);
+        static void LogDecision(const char* decision, const std::string& reason);
+
+        bool              pending_            = false;
+        bool              immediateRequested_ = false;
+        RE::TESWeather*   pendingWeather_     = nullptr;
+        bool              hasReset_           = false;
+        Clock::time_point lastReset_;
+    };
+}
@@ -0,0 +1,273 @@
+#include "WorkerPool.h"
+
+namespace SWF {
+
+    namespace {
+        // Tasks slower than this are always logged; everything is logged in debug mode.
+        constexpr std::uint64_t kSlowTaskMicros = 100'000;
+
+        void UpdateMax(std::atomic<std::uint64_t>& target, std::uint64_t value) {
+            auto current = target.load(std::memory_order_relaxed);
+            while (value > current &&
+                   !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    void WorkerPool::Start(std::size_t threadCount) {
+        std::lock_guard<std::mutex> lock(lifecycleMutex_);
+        if (running_.load(std::memory_order_acquire)) return;
+
+        if (threadCount == 0) {
+            auto hw = std::thread::hardware_concurrency();
+            threadCount = hw > 1 ? hw - 1 : 1;
+        }
+        threadCount = std::clamp<std::size_t>(threadCount, 1, kMaxThreads);
+
+        {
+            std::unique_lock<std::shared_mutex> workersLock(workersMutex_);
+            stopping_.store(false, std::memory_order_release);
+            workers_.clear();
+            for (std::size_t i = 0; i < threadCount; ++i) {
+                workers_.push_back(std::make_unique<Worker>());
+            }
+            threadCount_.store(threadCount, std::memory_order_release);
+
+            // Publish before the threads start so Submit() sees the full worker list.
+            running_.store(true, std::memory_order_release);
+        }
+        for (std::size_t i = 0; i < threadCount; ++i) {
+            workers_[i]->thread = std::thread([this, i]() { WorkerLoop(i); });
+            auto description = std::format(L"SWF Worker {}", i);
+            SetThreadDescription(workers_[i]->thread.native_handle(), description.c_str());
+        }
+
+        logs::info("WorkerPool: Started {} worker threads", threadCount);
+    }
+
+    void WorkerPool::Shutdown() {
+        std::lock_guard<std::mutex> lock(lifecycleMutex_);
+        if (!running_.exchange(false, std::memory_order_acq_rel)) return;
+
+        // The exclusive lock waits out any Submit() already past its checks,
+        // so nothing lands in a queue after the workers have drained it.
+        {
+            std::unique_lock<std::shared_mutex> workersLock(workersMutex_);
+            std::lock_guard<std::mutex> sleepLock(sleepMutex_);
+            stopping_.store(true, std::memory_order_release);
+        }
+        wake_.notify_all();
+
+        // Joined without the lock: running tasks may still call Submit(),
+        // which now rejects.
+        for (auto& worker : workers_) {
+            if (worker->thread.joinable()) worker->thread.join();
+        }
+
+        {
+            std::unique_lock<std::shared_mutex> workersLock(workersMutex_);
+            workers_.clear();
+            threadCount_.store(0, std::memory_order_release);
+        }
+
+        for (std::size_t lane = 0; lane < stats_.size(); ++lane) {
+            const auto& s = stats_[lane];
+            logs::info("WorkerPool: {} lane: {} completed, {} rejected, max {} us",
+                TaskPriorityToString(static_cast<TaskPriority>(lane)),
+                s.completed.load(), s.rejected.load(), s.maxMicros.load());
+        }
+    }
+
+    WorkerPool::~WorkerPool() {
+        // Static destruction runs under the loader lock, where joining can
+        // deadlock. If the quit hook never ran, the process is exiting and
+        // its threads are already gone: leave them and their queues alone.
+        for (auto& worker : workers_) {
+            if (worker->thread.joinable()) {
+                worker->thread.detach();
+                (void)worker.release();
+            }
+        }
+    }
+
+    bool WorkerPool::Submit(TaskPriority priority, const char* name, std::function<void()> fn) {
+        auto lane = static_cast<std::size_t>(priority);
+        auto& laneStats = stats_[lane];
+
+        std::shared_lock<std::shared_mutex> workersLock(workersMutex_);
+        if (!running_.load(std::memory_order_acquire) || stopping_.load(std::memory_order_acquire) ||
+            workers_.empty()) {
+            laneStats.rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        auto& worker = *workers_[nextWorker_.fetch_add(1, std::memory_order_relaxed) % workers_.size()];
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            auto& queue = worker.lanes[lane];
+            if (queue.size() >= kMaxQueuedPerLane) {
+                laneStats.rejected.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            queue.push_back(Task{ name, std::move(fn), Clock::now() });
+        }
+
+        laneStats.submitted.fetch_add(1, std::memory_order_relaxed);
+        pending_.fetch_add(1, std::memory_order_release);
+
+        // Taking the sleep mutex orders this wake-up against a worker that
+        // has just checked pending_ and is about to wait.
+        { std::lock_guard<std::mutex> sleepLock(sleepMutex_); }
+        wake_.notify_one();
+        return true;
+    }
+
+    void WorkerPool::ParallelFor(TaskPriority priority, const char* name, std::size_t count,
+                                 const std::function<void(std::size_t)>& fn) {
+        if (count == 0) return;
+
+        // Shared with the helper tasks, which may start after this call has
+        // returned; they only touch fn while an index is still unclaimed.
+        struct State {
+            std::atomic<std::size_t> next = 0;
+            std::atomic<std::size_t> done = 0;
+            std::size_t              count = 0;
+            const std::function<void(std::size_t)>* fn = nullptr;
+            std::mutex               mutex;
+            std::condition_variable  finished;
+
+            void Work() {
+                std::size_t completed = 0;
+                for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < count;) {
+                    try {
+                        (*fn)(i);
+                    } catch (const std::exception& e) {
+                        logs::error("WorkerPool: parallel item {} threw: {}", i, e.what());
+                    } catch (...) {
+                        logs::error("WorkerPool: parallel item {} threw an unknown exception", i);
+                    }
+                    ++completed;
+                }
+                if (completed > 0 && done.fetch_add(completed, std::memory_order_acq_rel) + completed == count) {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    finished.notify_all();
+                }
+            }
+        };
+
+        auto state   = std::make_shared<State>();
+        state->count = count;
+        state->fn    = &fn;
+
+        auto helpers = (std::min)(count - 1, GetThreadCount());
+        for (std::size_t h = 0; h < helpers; ++h) {
+            if (!Submit(priority, name, [state]() { state->Work(); })) break;
+        }
+
+        state->Work();
+
+        std::unique_lock<std::mutex> lock(state->mutex);
+        state->finished.wait(lock, [&]() { return state->done.load(std::memory_order_acquire) == count; });
+    }
+
+    bool WorkerPool::TryPop(std::size_t index, Task& out, TaskPriority& outPriority) {
+        const auto count = workers_.size();
+
+        for (std::size_t lane = 0; lane < static_cast<std::size_t>(TaskPriority::kTotal); ++lane) {
+            // Own queue first, oldest task first.
+            {
+                auto& own = *workers_[index];
+                std::lock_guard<std::mutex> lock(own.mutex);
+                auto& queue = own.lanes[lane];
+                if (!queue.empty()) {
+                    out = std::move(queue.front());
+                    queue.pop_front();
+                    outPriority = static_cast<TaskPriority>(lane);
+                    return true;
+                }
+            }
+
+            // Then steal from the back of the other workers' same lane.
+            for (std::size_t offset = 1; offset < count; ++offset) {
+                auto& victim = *workers_[(index + offset) % count];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                auto& queue = victim.lanes[lane];
+                if (!queue.empty()) {
+                    out = std::move(queue.back());
+                    queue.pop_back();
+                    outPriority = static_cast<TaskPriority>(lane);
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    void WorkerPool::Run(Task& task, TaskPriority priority) {
+        auto& laneStats = stats_[static_cast<std::size_t>(priority)];
+
+        auto start = Clock::now();
+        try {
+            task.fn();
+        } catch (const std::exception& e) {
+            logs::error("WorkerPool: task '{}' threw: {}", task.name, e.what());
+        } catch (...) {
+            logs::error("WorkerPool: task '{}' threw an unknown exception", task.name);
+        }
+        auto end = Clock::now();
+
+        auto runMicros  = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+        auto waitMicros = static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::microseconds>(start - task.enqueued).count());
+
+        laneStats.completed.fetch_add(1, std::memory_order_relaxed);
+        laneStats.totalMicros.fetch_add(runMicros, std::memory_order_relaxed);
+        UpdateMax(laneStats.maxMicros, runMicros);
+        UpdateMax(laneStats.maxWaitMicros, waitMicros);
+
+        if (runMicros >= kSlowTaskMicros || logAllTasks_.load(std::memory_order_relaxed)) {
+            logs::info("WorkerPool: [{}] task '{}' ran {:.3f} ms (queued {:.3f} ms)",
+                TaskPriorityToString(priority), task.name, runMicros / 1000.0, waitMicros / 1000.0);
+        }
+    }
+
+    void WorkerPool::WorkerLoop(std::size_t index) {
+        Task task;
+        TaskPriority priority = TaskPriority::kNormal;
+
+        while (true) {
+            if (TryPop(index, task, priority)) {
+                pending_.fetch_sub(1, std::memory_order_acq_rel);
+                Run(task, priority);
+                task = Task{};
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(sleepMutex_);
+            wake_.wait(lock, [this]() {
+                return pending_.load(std::memory_order_acquire) > 0 ||
+                       stopping_.load(std::memory_order_acquire);
+            });
+
+            // Drain everything queued before honouring the stop request.
+            if (stopping_.load(std::memory_order_acquire) &&
+                pending_.load(std::memory_order_acquire) == 0) {
+                break;
+            }
+        }
+    }
+
+    WorkerPool::LaneStats WorkerPool::GetLaneStats(TaskPriority priority) const {
+        const auto& s = stats_[static_cast<std::size_t>(priority)];
+        LaneStats result;
+        result.submitted     = s.submitted.load(std::memory_order_relaxed);
+        result.completed     = s.completed.load(std::memory_order_relaxed);
+        result.rejected      = s.rejected.load(std::memory_order_relaxed);
+        result.totalMicros   = s.totalMicros.load(std::memory_order_relaxed);
+        result.maxMicros     = s.maxMicros.load(std::memory_order_relaxed);
+        result.maxWaitMicros = s.maxWaitMicros.load(std::memory_order_relaxed);
+        return result;
+    }
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "pch.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <thread>
+
+namespace SWF {
+
+    // Lanes are serviced strictly in this order: a worker only takes a
+    // normal task when no high task is queued anywhere, and so on.
+    enum class TaskPriority : std::uint32_t {
+        kHigh   = 0,  // startup pipeline, table rebuilds the player is waiting on
+        kNormal = 1,  // scans, index builds, view-model rebuilds
+        kLow    = 2,  // config saves, statistics, logging
+
+        kTotal  = 3
+    };
+
+    inline const char* TaskPriorityToString(TaskPriority priority) {
+        switch (priority) {
+            case TaskPriority::kHigh:   return "High";
+            case TaskPriority::kNormal: return "Normal";
+            case TaskPriority::kLow:    return "Low";
+            default:                    return "Unknown";
+        }
+    }
+
+    // Small work-stealing thread pool shared by every background job in the
+    // plugin. Each worker owns a deque per priority lane; submissions are
+    // distributed round-robin and idle workers steal from the back of their
+    // neighbours' lanes. Never touch live game records from a task — hop
+    // back to the game thread through the SKSE task interface instead.
+    class WorkerPool {
+    public:
+        static WorkerPool& GetSingleton() {
+            static WorkerPool instance;
+            return instance;
+        }
+
+        // Per-worker, per-lane cap. Submit() fails once a lane is full so a
+        // runaway producer cannot grow memory without bound.
+        static constexpr std::size_t kMaxQueuedPerLane = 1024;
+        static constexpr std::size_t kMaxThreads       = 4;
+
+        // threadCount == 0 picks hardware_concurrency - 1, clamped to [1, kMaxThreads].
+        void Start(std::size_t threadCount = 0);
+
+        // Stop accepting work, run everything already queued, then join.
+        // Called from the quit hook while the game is still running normally;
+        // never from the destructor, which runs under the loader lock.
+        void Shutdown();
+
+        bool IsRunning() const { return running_.load(std::memory_order_acquire); }
+
+        std::size_t GetThreadCount() const { return threadCount_.load(std::memory_order_acquire); }
+
+        // Returns false if the pool is not running or the lane is full; the
+        // caller decides whether to run the job inline instead.
+        bool Submit(TaskPriority priority, const char* name, std::function<void()> fn);
+
+        // Calls fn(i) for every i in [0, count) and returns when all calls
+        // have finished. The calling thread takes indices too, so this is
+        // safe from inside a task and still completes if no helper task
+        // ever gets to run.
+        void ParallelFor(TaskPriority priority, const char* name, std::size_t count,
+                         const std::function<void(std::size_t)>& fn);
+
+        struct LaneStats {
+            std::uint64_t submitted   = 0;
+            std::uint64_t completed   = 0;
+            std::uint64_t rejected    = 0;
+            std::uint64_t totalMicros = 0;  // summed run time
+            std::uint64_t maxMicros   = 0;  // slowest single task
+            std::uint64_t maxWaitMicros = 0;  // longest time spent queued
+        };
+
+        LaneStats GetLaneStats(TaskPriority priority) const;
+
+        // Log every task's timing, not only slow ones ([General] bDebugMode).
+        // Set by ConfigManager when it publishes a config; workers only read it.
+        void SetLogAllTasks(bool enabled) { logAllTasks_.store(enabled, std::memory_order_relaxed); }
+
+    private:
+        WorkerPool() = default;
+        ~WorkerPool();
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        using Clock = std::chrono::steady_clock;
+
+        struct Task {
+            const char*           name = "";
+            std::function<void()> fn;
+            Clock::time_point     enqueued;
+        };
+
+        struct Worker {
+            std::mutex                                                  mutex;
+            std::array<std::deque<Task>, std::size_t(TaskPriority::kTotal)> lanes;
+            std::thread                                                 thread;
+        };
+
+        struct AtomicLaneStats {
+            std::atomic<std::uint64_t> submitted   = 0;
+            std::atomic<std::uint64_t> completed   = 0;
+            std::atomic<std::uint64_t> rejected    = 0;
+            std::atomic<std::uint64_t> totalMicros = 0;
+            std::atomic<std::uint64_t> maxMicros   = 0;
+            std::atomic<std::uint64_t> maxWaitMicros = 0;
+        };
+
+        void WorkerLoop(std::size_t index);
+        bool TryPop(std::size_t index, Task& out, TaskPriority& outPriority);
+        void Run(Task& task, TaskPriority priority);
+
+        // Submit() indexes workers_ under a shared lock; Start() and
+        // Shutdown() only replace or clear it under the exclusive lock.
+        std::vector<std::unique_ptr<Worker>> workers_;
+        mutable std::shared_mutex            workersMutex_;
+        std::atomic<std::size_t>             threadCount_ = 0;
+        std::array<AtomicLaneStats, std::size_t(TaskPriority::kTotal)> stats_;
+
+        std::atomic<bool>        running_  = false;
+        std::atomic<bool>        stopping_ = false;
+        std::atomic<std::size_t> pending_  = 0;
+        std::atomic<std::size_t> nextWorker_ = 0;
+        std::atomic<bool>        logAllTasks_ = false;
+
+        std::mutex               sleepMutex_;
+        std::condition_variable  wake_;
+        std::mutex               lifecycleMutex_;
+    };
+}
@@ -3,6 +3,10 @@
 #include "WeatherManager.h"
 #include "UpdateHook.h"
 #include "MenuUI.h"
+#include "PerfStats.h"
+#include "WorkerPool.h"
+#include "StartupPipeline.h"
+#include "ConsoleCommands.h"
 
 namespace {
 
@@ -27,19 +31,12 @@ namespace {
     void OnDataLoaded() {
         logs::info("=== Seasonal Weather Framework: Data Loaded ===");
 
-        // Load config
-        SWF::ConfigManager::GetSingleton().Load();
+        // Load config, scan and classify regions, inject missing weathers,
+        // precompute chance tables and install the update hook. Runs as a
+        // staged pipeline; this call returns immediately.
+        SWF::StartupPipeline::GetSingleton().Start();
 
-        // Scan all region records from all loaded mods
-        SWF::RegionScanner::GetSingleton().ScanAllRegions();
-
-        // Inject missing weathers so every weather type can play in every region
-        SWF::RegionScanner::GetSingleton().InjectMissingWeathers();
-
-        // Install the update hook
-        SWF::UpdateHook::GetSingleton().Install();
-
-        logs::info("=== Seasonal Weather Framework: Initialization Complete ===");
+        SWF::ConsoleCommands::Register();
     }
 
     void OnPostPostLoad() {
@@ -50,12 +47,19 @@ namespace {
 
     void OnGameLoaded() {
         // Runs after loading a save or starting a new game
+        if (!SWF::StartupPipeline::GetSingleton().IsComplete()) {
+            // The pipeline's final stage applies the current season itself.
+            logs::info("OnGameLoaded: Startup pipeline still running, deferring refresh to it");
+            return;
+        }
+
         logs::info("OnGameLoaded: Refreshing weather for loaded game");
         SWF::WeatherManager::GetSingleton().ForceRefresh();
         SWF::WeatherManager::GetSingleton().Update();
     }
 
     void MessageHandler(SKSE::MessagingInterface::Message* a_msg) {
+        SWF::PerfStats::GetSingleton().Count(SWF::PerfEvent::kSkseMessage);
         switch (a_msg->type) {
             case SKSE::MessagingInterface::kDataLoaded:
                 OnDataLoaded();
@@ -82,6 +86,9 @@ SKSEPluginLoad(const SKSE::LoadInterface* a_skse)
     logs::info("=== Seasonal Weather Framework: SKSEPluginLoad start ===");
     logs::info("  Game version: {}", a_skse->RuntimeVersion().string());
 
+    // Background workers for scans, table rebuilds, config I/O and stats.
+    SWF::WorkerPool::GetSingleton().Start();
+
     // Register for SKSE messages
     auto messaging = SKSE::GetMessagingInterface();
     if (!messaging->RegisterListener("SKSE", MessageHandler)) {
@@ -1,14 +1,21 @@
 #pragma once
 
+#if defined(SWF_HOST_TEST)
+// Linux host tests and benchmarks (tests/): stand-ins for the game and SKSE.
+#include "HostEnv.h"
+#else
 #include <RE/Skyrim.h>
 #include <SKSE/SKSE.h>
 
 #include <spdlog/sinks/basic_file_sink.h>
+#endif
 
 #include <algorithm>
 #include <atomic>
 #include <filesystem>
+#if !defined(SWF_HOST_TEST)
 #include <format>
+#endif
 #include <iomanip>
 #include <mutex>
 #include <random>
@@ -0,0 +1,15 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+// Same as benchmark_main, with the plugin's info logging silenced so it
+// does not interleave with the results.
+int main(int argc, char** argv) {
+    spdlog::set_level(spdlog::level::warn);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "Config.h"
+#include "ScopedWorkDir.h"
+#include "WorkerPool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <future>
+
+namespace SWF {
+    namespace {
+        struct PoolScope {
+            explicit PoolScope(std::size_t threads) { WorkerPool::GetSingleton().Start(threads); }
+            ~PoolScope() { WorkerPool::GetSingleton().Shutdown(); }
+        };
+
+        // Caller-side cost of Save(): snapshot and hand-off with the pool
+        // running, against formatting and writing on the caller (pool off).
+        void BM_SaveCaller(benchmark::State& state) {
+            ScopedWorkDir dir;
+            bool async = state.range(0) != 0;
+            if (async) WorkerPool::GetSingleton().Start(1);
+            auto& config = ConfigManager::GetSingleton();
+            config.Save();
+            config.WaitForPendingSave();
+
+            for (auto _ : state) {
+                config.Save();
+                state.PauseTiming();
+                config.WaitForPendingSave();
+                state.ResumeTiming();
+            }
+            WorkerPool::GetSingleton().Shutdown();
+        }
+        BENCHMARK(BM_SaveCaller)->ArgName("async")->Arg(0)->Arg(1)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+        // kSaveConfig followed by kLoadConfig in one command batch, as the
+        // game thread sees it. blocking = the previous drain: Load() waited
+        // for the queued save, then parsed on the game thread. chained = the
+        // load queued behind the save on the pool.
+        void BM_SaveThenLoadCaller(benchmark::State& state) {
+            ScopedWorkDir dir;
+            PoolScope scope(1);
+            auto& config = ConfigManager::GetSingleton();
+            config.Save();
+            config.WaitForPendingSave();
+            bool chained = state.range(0) != 0;
+
+            for (auto _ : state) {
+                config.Save();
+                if (chained) {
+                    std::promise<void> loaded;
+                    config.LoadAsync([&](std::shared_ptr<const Config>) { loaded.set_value(); });
+                    state.PauseTiming();
+                    loaded.get_future().wait();
+                    state.ResumeTiming();
+                } else {
+                    config.WaitForPendingSave();
+                    config.Load();
+                }
+            }
+        }
+        BENCHMARK(BM_SaveThenLoadCaller)->ArgName("chained")->Arg(0)->Arg(1)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+        // The whole round trip, for scale: save, then load, until the parsed
+        // config is back.
+        void BM_SaveThenLoadRoundTrip(benchmark::State& state) {
+            ScopedWorkDir dir;
+            PoolScope scope(1);
+            auto& config = ConfigManager::GetSingleton();
+            config.Save();
+            config.WaitForPendingSave();
+
+            for (auto _ : state) {
+                config.Save();
+                std::promise<void> loaded;
+                config.LoadAsync([&](std::shared_ptr<const Config>) { loaded.set_value(); });
+                loaded.get_future().wait();
+            }
+        }
+        BENCHMARK(BM_SaveThenLoadRoundTrip)->UseRealTime()->Unit(benchmark::kMicrosecond);
+    }
+}
@@ -0,0 +1,76 @@
+#include "IniParser.h"
+
+#include <benchmark/benchmark.h>
+
+#include <sstream>
+
+namespace SWF {
+    namespace {
+        // A climate CSV with a header and `rows` rows, mixing EditorIDs,
+        // plugin|0xID references, season lists and both value kinds.
+        std::string MakeCsv(std::size_t rows) {
+            std::string text = "region,weather,season,kind,value\n";
+            for (std::size_t i = 0; i < rows; ++i) {
+                if (i % 3 == 0) {
+                    std::format_to(std::back_inserter(text), "Skyrim.esm|0x{:06X},SkyrimClear{},Summer|Autumn,mult,{}.5\n",
+                                   0x10000 + i, i % 40, i % 10);
+                } else {
+                    std::format_to(std::back_inserter(text), " RegionTundra{} , WeatherFog{} , * , chance , {}.25\n",
+                                   i, i % 40, i % 100);
+                }
+            }
+            return text;
+        }
+
+        void BM_TokenizeCsv(benchmark::State& state) {
+            auto text = MakeCsv(static_cast<std::size_t>(state.range(0)));
+            for (auto _ : state) {
+                std::size_t fields = 0;
+                TokenizeCsv<5>(text, [&](std::span<const std::string_view> row, std::uint32_t) {
+                    fields += row.size();
+                });
+                benchmark::DoNotOptimize(fields);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+            state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+        }
+        BENCHMARK(BM_TokenizeCsv)->Arg(1000)->Arg(100000);
+
+        // Tokenize and parse the value column, as the climate import does per row.
+        void BM_TokenizeAndParseCsv(benchmark::State& state) {
+            auto text = MakeCsv(static_cast<std::size_t>(state.range(0)));
+            for (auto _ : state) {
+                float sum = 0.0f;
+                TokenizeCsv<5>(text, [&](std::span<const std::string_view> row, std::uint32_t) {
+                    float value = 0.0f;
+                    if (row.size() == 5 && ParseIniFloat(row[4], value)) sum += value;
+                });
+                benchmark::DoNotOptimize(sum);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+            state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+        }
+        BENCHMARK(BM_TokenizeAndParseCsv)->Arg(1000)->Arg(100000);
+
+        // A getline/stringstream split with std::stof, for comparison.
+        void BM_StreamCsvBaseline(benchmark::State& state) {
+            auto text = MakeCsv(static_cast<std::size_t>(state.range(0)));
+            for (auto _ : state) {
+                float sum = 0.0f;
+                std::istringstream input(text);
+                std::string line;
+                while (std::getline(input, line)) {
+                    std::istringstream fields(line);
+                    std::string field;
+                    std::size_t column = 0;
+                    while (std::getline(fields, field, ',') && column++ < 4) {}
+                    try { sum += std::stof(field); } catch (...) {}
+                }
+                benchmark::DoNotOptimize(sum);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+            state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+        }
+        BENCHMARK(BM_StreamCsvBaseline)->Arg(1000)->Arg(100000);
+    }
+}
@@ -0,0 +1,85 @@
+#include "IniParser.h"
+
+#include <benchmark/benchmark.h>
+
+namespace SWF {
+    namespace {
+        // A config-sized INI: `sections` sections of 24 float keys each, with
+        // comments, a signed value and an inline comment mixed in.
+        std::string MakeIni(std::size_t sections) {
+            std::string text;
+            for (std::size_t s = 0; s < sections; ++s) {
+                std::format_to(std::back_inserter(text), "# Section {}\n[Section{}]\n", s, s);
+                for (std::size_t k = 0; k < 24; ++k) {
+                    if (k % 6 == 0) {
+                        std::format_to(std::back_inserter(text), "fKey{} = +{}.25 ; tuned\n", k, k);
+                    } else {
+                        std::format_to(std::back_inserter(text), "fKey{} = {}.5\n", k, k);
+                    }
+                }
+            }
+            return text;
+        }
+
+        void BM_TokenizeIni(benchmark::State& state) {
+            auto text = MakeIni(static_cast<std::size_t>(state.range(0)));
+            for (auto _ : state) {
+                std::size_t entries = 0;
+                TokenizeIni(text, [&](const IniEntry& entry) { entries += !entry.key.empty(); },
+                            [](std::string_view, std::uint32_t) {});
+                benchmark::DoNotOptimize(entries);
+            }
+            state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+        }
+        BENCHMARK(BM_TokenizeIni)->Arg(8)->Arg(512);
+
+        // Tokenize and parse every value, as ParseLayered does per file.
+        void BM_TokenizeAndParseIni(benchmark::State& state) {
+            auto text = MakeIni(static_cast<std::size_t>(state.range(0)));
+            std::int64_t values = 0;
+            for (auto _ : state) {
+                float sum = 0.0f;
+                TokenizeIni(text, [&](const IniEntry& entry) {
+                    float value = 0.0f;
+                    if (ParseIniFloat(entry.value, value)) sum += value;
+                }, [](std::string_view, std::uint32_t) {});
+                benchmark::DoNotOptimize(sum);
+                values += static_cast<std::int64_t>(state.range(0)) * 24;
+            }
+            state.SetItemsProcessed(values);
+            state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(text.size()));
+        }
+        BENCHMARK(BM_TokenizeAndParseIni)->Arg(8)->Arg(512);
+
+        void BM_ParseIniFloat(benchmark::State& state) {
+            constexpr std::string_view kValues[] = { "1.5", "+2.25", "0.75 ; comment", "-3", "12.125\t# note" };
+            for (auto _ : state) {
+                float sum = 0.0f;
+                for (auto value : kValues) {
+                    float parsed = 0.0f;
+                    ParseIniFloat(value, parsed);
+                    sum += parsed;
+                }
+                benchmark::DoNotOptimize(sum);
+            }
+            state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(std::size(kValues)));
+        }
+        BENCHMARK(BM_ParseIniFloat);
+
+        // The std::stof parser ParseIniFloat replaced, for comparison.
+        void BM_ParseStofBaseline(benchmark::State& state) {
+            constexpr std::string_view kValues[] = { "1.5", "+2.25", "0.75 ; comment", "-3", "12.125\t# note" };
+            for (auto _ : state) {
+                float sum = 0.0f;
+                for (auto value : kValues) {
+                    float parsed = 0.0f;
+                    try { parsed = std::stof(std::string(value)); } catch (...) {}
+                    sum += parsed;
+                }
+                benchmark::DoNotOptimize(sum);
+            }
+            state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(std::size(kValues)));
+        }
+        BENCHMARK(BM_ParseStofBaseline);
+    }
+}
@@ -0,0 +1,92 @@
+#include "MenuViewModel.h"
+#include "SyntheticScan.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstring>
+
+// A model of the Region Browser's row loop on a synthetic scan. Neither
+// MenuUI's render code nor MenuViewModel::Build runs here: MakeView()
+// copies how Build formats the rows, and a "submit" stands in for an ImGui
+// widget call and only reads its label. This compares the shape of the two
+// loops; it is not a frame time. The list child is 320 px high, about 19 rows.
+namespace SWF {
+    namespace {
+        using namespace Bench;
+
+        constexpr std::size_t kVisibleRows = 19;
+
+        std::size_t Submit(const char* label) {
+            return std::strlen(label);
+        }
+
+        // Rows formatted the way MenuViewModel::Build formats them once per scan.
+        std::shared_ptr<const MenuView> MakeView(const SyntheticScan& scan, std::uint64_t generation) {
+            auto view = std::make_shared<MenuView>();
+            view->scanGeneration = generation;
+            view->regions.reserve(scan.infos.size());
+            for (const auto& info : scan.infos) {
+                auto& row = view->regions.emplace_back();
+                row.name         = info.editorID;
+                row.form         = info.region->GetFormID();
+                row.weatherCount = static_cast<std::uint32_t>(info.originalWeatherEntries.size());
+                row.header       = std::format("{} [{}] ({} weathers)", info.editorID, info.worldSpaceEditorID,
+                                               row.weatherCount);
+            }
+            view->regionOrder.resize(view->regions.size());
+            for (std::uint32_t i = 0; i < view->regionOrder.size(); ++i) view->regionOrder[i] = i;
+            std::ranges::sort(view->regionOrder, {}, [&](std::uint32_t r) -> const std::string& {
+                return view->regions[r].name;
+            });
+            return view;
+        }
+
+        // The clipped loop: a generation check, then only the window of
+        // prebuilt rows. The window scrolls every iteration.
+        void BM_RegionBrowserRowsModel(benchmark::State& state) {
+            auto scan = MakeScan(static_cast<std::size_t>(state.range(0)), 400);
+            auto view = MakeView(*scan, 1);
+            std::uint64_t generation = 1;
+            std::size_t   frame      = 0;
+
+            for (auto _ : state) {
+                std::size_t bytes = 0;
+                if (view->scanGeneration == generation) {
+                    const auto& rows = view->regionOrder;
+                    auto first = (frame++ * 37) % (rows.size() - kVisibleRows);
+                    for (auto i = first; i < first + kVisibleRows; ++i) {
+                        bytes += Submit(view->regions[rows[i]].header.c_str());
+                    }
+                }
+                benchmark::DoNotOptimize(bytes);
+            }
+            state.counters["regions"] = static_cast<double>(state.range(0));
+        }
+        BENCHMARK(BM_RegionBrowserRowsModel)->Arg(1000)->Arg(10000)->Arg(100000);
+
+        // The loop before clipping, for comparison: every region's header
+        // concatenated from its EditorID, the worldspace's EditorID and a
+        // to_string, and submitted, every iteration.
+        void BM_RegionBrowserRowsModelBaseline(benchmark::State& state) {
+            auto scan = MakeScan(static_cast<std::size_t>(state.range(0)), 400);
+
+            for (auto _ : state) {
+                std::size_t bytes = 0;
+                for (const auto& info : scan->infos) {
+                    std::string header = info.editorID;
+                    if (info.worldSpace) {
+                        if (auto editorID = info.worldSpace->GetFormEditorID()) {
+                            header += " [" + std::string(editorID) + "]";
+                        }
+                    }
+                    header += " (" + std::to_string(info.originalWeatherEntries.size()) + " weathers)";
+                    bytes += Submit(header.c_str());
+                }
+                benchmark::DoNotOptimize(bytes);
+            }
+            state.counters["regions"] = static_cast<double>(state.range(0));
+        }
+        BENCHMARK(BM_RegionBrowserRowsModelBaseline)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+    }
+}
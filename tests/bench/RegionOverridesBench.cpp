@@ -0,0 +1,70 @@
+#include "RegionOverrides.h"
+#include "SyntheticScan.h"
+#include "WorkerPool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <random>
+
+namespace SWF {
+    namespace {
+        using namespace Bench;
+
+        // Mostly region globs, some worldspace globs and, if `regexEvery`
+        // is non-zero, one re: pattern per that many rules.
+        std::vector<RegionOverrideRule> MakeRules(std::size_t count, std::size_t regexEvery) {
+            std::mt19937 random(42);
+            std::vector<RegionOverrideRule> rules;
+            rules.reserve(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                auto hold = kHolds[random() % kHolds.size()];
+                auto kind = kKinds[random() % kKinds.size()];
+                std::string pattern;
+                if (regexEvery && i % regexEvery == 0) {
+                    pattern = std::string("re:^") + hold + ".*" + kind + "Region" + std::to_string(random() % 10) + "\\d*$";
+                } else if (i % 10 == 0) {
+                    pattern = std::string("ws:") + kWorldspaces[random() % kWorldspaces.size()];
+                } else if (i % 3 == 0) {
+                    pattern = std::string("*") + hold + "*" + kind + "*";
+                } else {
+                    pattern = std::string(hold) + kind + "Region" + std::to_string(random() % 100) + "*";
+                }
+
+                RegionOverrideRule rule;
+                if (ParseRegionOverrideRule(pattern, "Winter.Snow=2.0, Summer.*=0.5", rule)) {
+                    rules.push_back(std::move(rule));
+                }
+            }
+            return rules;
+        }
+
+        // Compile() of `rules` against `regions` on a one-thread pool.
+        // Args: rules, regions, one regex per N rules (0 = none).
+        void BM_CompileRegionOverrides(benchmark::State& state) {
+            auto rules   = MakeRules(static_cast<std::size_t>(state.range(0)), static_cast<std::size_t>(state.range(2)));
+            auto regions = MakeRegions(static_cast<std::size_t>(state.range(1)));
+            WorkerPool::GetSingleton().Start(1);
+
+            std::size_t sets = 0;
+            for (auto _ : state) {
+                auto compiled = CompiledRegionOverrides::Compile(rules, regions, 1);
+                sets = compiled->sets.size();
+                benchmark::DoNotOptimize(compiled);
+            }
+            WorkerPool::GetSingleton().Shutdown();
+
+            state.counters["sets"] = static_cast<double>(sets);
+            state.counters["ns/test"] = benchmark::Counter(
+                static_cast<double>(rules.size()) * static_cast<double>(regions.size()),
+                benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+        }
+        BENCHMARK(BM_CompileRegionOverrides)
+            ->ArgNames({ "rules", "regions", "regexEvery" })
+            ->Args({ 200, 2000, 0 })
+            ->Args({ 2000, 2000, 0 })
+            ->Args({ 2000, 20000, 0 })
+            ->Args({ 2000, 20000, 100 })
+            ->UseRealTime()
+            ->Unit(benchmark::kMillisecond);
+    }
+}
@@ -0,0 +1,116 @@
+#include "RegionSearch.h"
+#include "SyntheticScan.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+
+namespace SWF {
+    namespace {
+        using namespace Bench;
+
+        std::vector<std::string_view> RegionNames(const SyntheticScan& scan) {
+            std::vector<std::string_view> names;
+            names.reserve(scan.infos.size());
+            for (const auto& info : scan.infos) names.push_back(info.editorID);
+            return names;
+        }
+
+        // Needles of increasing length: one posting list up to three bytes,
+        // trigram intersections past that. "zzzz" matches nothing.
+        constexpr std::string_view kNeedles[] = { "ra", "dra", "tundra", "reachtundraregion1", "zzzz" };
+
+        void BM_TrigramIndexBuild(benchmark::State& state) {
+            auto scan  = MakeScan(static_cast<std::size_t>(state.range(0)), 400);
+            auto names = RegionNames(*scan);
+            std::size_t grams = 0;
+            for (auto _ : state) {
+                TrigramIndex index;
+                index.Build(names);
+                grams = index.GetGramCount();
+                benchmark::DoNotOptimize(index);
+            }
+            state.counters["grams"] = static_cast<double>(grams);
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+        BENCHMARK(BM_TrigramIndexBuild)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+        // The whole per-scan index: both trigram indices, name order and
+        // facets. A new generation each iteration forces the rebuild.
+        void BM_RegionSearchBuild(benchmark::State& state) {
+            auto scan = MakeScan(static_cast<std::size_t>(state.range(0)), 400);
+            std::uint64_t generation = 0;
+            for (auto _ : state) {
+                auto search = RegionSearch::GetSingleton().Ensure(scan->infos, ++generation);
+                benchmark::DoNotOptimize(search);
+            }
+            state.SetItemsProcessed(state.iterations() * state.range(0));
+        }
+        BENCHMARK(BM_RegionSearchBuild)->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMicrosecond);
+
+        // Arg: index into kNeedles, over 10 000 region names.
+        void BM_TrigramFind(benchmark::State& state) {
+            auto scan  = MakeScan(10000, 400);
+            auto names = RegionNames(*scan);
+            TrigramIndex index;
+            index.Build(names);
+
+            auto needle = kNeedles[state.range(0)];
+            std::vector<std::uint32_t> out;
+            for (auto _ : state) {
+                out.clear();
+                index.Find(needle, out);
+                benchmark::DoNotOptimize(out.data());
+            }
+            state.SetLabel(std::string(needle));
+            state.counters["matches"] = static_cast<double>(out.size());
+        }
+        BENCHMARK(BM_TrigramFind)->DenseRange(0, std::size(kNeedles) - 1);
+
+        // Lowercase and find() over every name, for comparison.
+        void BM_LinearFindBaseline(benchmark::State& state) {
+            auto scan  = MakeScan(10000, 400);
+            auto names = RegionNames(*scan);
+
+            auto needle = kNeedles[state.range(0)];
+            std::vector<std::uint32_t> out;
+            std::string lowered;
+            for (auto _ : state) {
+                out.clear();
+                for (std::uint32_t i = 0; i < names.size(); ++i) {
+                    lowered.assign(names[i]);
+                    std::ranges::transform(lowered, lowered.begin(), [](unsigned char c) {
+                        return static_cast<char>(std::tolower(c));
+                    });
+                    if (lowered.find(needle) != std::string::npos) out.push_back(i);
+                }
+                benchmark::DoNotOptimize(out.data());
+            }
+            state.SetLabel(std::string(needle));
+            state.counters["matches"] = static_cast<double>(out.size());
+        }
+        BENCHMARK(BM_LinearFindBaseline)->DenseRange(0, std::size(kNeedles) - 1);
+
+        // Text over region and weather names, then with a worldspace facet
+        // and a weather class, on 10 000 regions.
+        void BM_RegionSearchQuery(benchmark::State& state) {
+            auto scan   = MakeScan(10000, 400);
+            auto search = RegionSearch::GetSingleton().Ensure(scan->infos, 1);
+
+            RegionFilter filter;
+            filter.text = "tundra";
+            if (state.range(0)) {
+                filter.worldspace = 0;
+                filter.classMask  = 1u << static_cast<std::uint32_t>(WeatherClass::kSnow);
+            }
+            std::vector<std::uint32_t> out;
+            for (auto _ : state) {
+                out.clear();
+                search->Query(filter, out);
+                benchmark::DoNotOptimize(out.data());
+            }
+            state.counters["matches"] = static_cast<double>(out.size());
+        }
+        BENCHMARK(BM_RegionSearchQuery)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "RegionScanner.h"
+
+#include <array>
+#include <memory>
+
+// Scan data shaped like a large load order, for benches that need region
+// infos without the game.
+namespace SWF::Bench {
+    constexpr std::array kHolds{ "Pale", "Reach", "Rift", "Falkreath", "Haafingar", "Eastmarch",
+                                 "Winterhold", "Hjaalmarch", "Whiterun", "Solstheim" };
+    constexpr std::array kKinds{ "Forest", "Tundra", "Snow", "Coast", "Marsh", "Mountain", "Volcanic", "Plains" };
+    constexpr std::array kWorldspaces{ "Tamriel", "DLC2SolstheimWorld", "Falskaar", "Wyrmstooth",
+                                       "BSHeartland", "Vominheim", "Bruma", "Skuldafn" };
+    constexpr std::array kPlugins{ "Skyrim.esm", "Dragonborn.esm", "Falskaar.esm", "Wyrmstooth.esp",
+                                   "BSHeartland.esm", "Vominheim.esp", "Cyrodiil.esm", "Obscure's College.esp" };
+
+    // EditorIDs built from a hold, a terrain kind and a number, spread over
+    // a few worldspaces. No forms or weather entries.
+    inline std::vector<RegionWeatherInfo> MakeRegions(std::size_t count) {
+        std::vector<RegionWeatherInfo> infos(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            infos[i].editorID = std::string(kHolds[i % kHolds.size()]) + kKinds[(i / 7) % kKinds.size()] +
+                                "Region" + std::to_string(i);
+            infos[i].worldSpaceEditorID = kWorldspaces[(i / 3) % kWorldspaces.size()];
+        }
+        return infos;
+    }
+
+    // MakeRegions() plus the forms behind it: each region gets 3 to 8
+    // entries drawn from `weatherCount` weathers and a plugin that matches
+    // its worldspace. Infos point into the form vectors, so the scan is
+    // handed out by pointer.
+    struct SyntheticScan {
+        std::vector<RE::TESFile>       files;
+        std::vector<RE::TESWorldSpace> worldspaces;
+        std::vector<RE::TESRegion>     regions;
+        std::vector<RE::TESWeather>    weathers;
+        std::vector<RegionWeatherInfo> infos;
+    };
+
+    inline std::unique_ptr<SyntheticScan> MakeScan(std::size_t regionCount, std::size_t weatherCount) {
+        auto scan = std::make_unique<SyntheticScan>();
+        scan->infos = MakeRegions(regionCount);
+
+        scan->files.resize(kPlugins.size());
+        for (std::size_t f = 0; f < kPlugins.size(); ++f) scan->files[f].fileName = kPlugins[f];
+
+        scan->worldspaces.resize(kWorldspaces.size());
+        for (std::size_t w = 0; w < kWorldspaces.size(); ++w) {
+            scan->worldspaces[w].formID   = static_cast<RE::FormID>(0x3C + w);
+            scan->worldspaces[w].editorID = kWorldspaces[w];
+        }
+
+        scan->weathers.resize(weatherCount);
+        for (std::size_t w = 0; w < weatherCount; ++w) {
+            scan->weathers[w].formID   = static_cast<RE::FormID>(0x10A000 + w);
+            scan->weathers[w].editorID = std::string(kHolds[w % kHolds.size()]) + "Weather" +
+                                         kKinds[(w / 3) % kKinds.size()] + std::to_string(w);
+        }
+
+        scan->regions.resize(regionCount);
+        for (std::size_t r = 0; r < regionCount; ++r) {
+            auto& info = scan->infos[r];
+            scan->regions[r].formID   = static_cast<RE::FormID>(0x20000 + r);
+            scan->regions[r].editorID = info.editorID;
+            scan->regions[r].file     = &scan->files[(r / 3) % kPlugins.size()];
+            info.region     = &scan->regions[r];
+            info.worldSpace = &scan->worldspaces[(r / 3) % kWorldspaces.size()];
+
+            auto entries = 3 + r % 6;
+            for (std::size_t e = 0; e < entries; ++e) {
+                auto w = (r * 7 + e * 13) % weatherCount;
+                RegionWeatherEntry entry;
+                entry.weather        = &scan->weathers[w];
+                entry.baseChance     = static_cast<std::uint32_t>(10 + (r + e) % 60);
+                entry.classification = static_cast<WeatherClass>(w % (static_cast<std::size_t>(WeatherClass::kUnknown) + 1));
+                entry.weatherIndex   = static_cast<std::uint32_t>(w);
+                info.totalBaseChance += entry.baseChance;
+                info.originalWeatherEntries.push_back(entry);
+            }
+            info.originalEntryCount  = info.originalWeatherEntries.size() - (r % 5 == 0 ? 1 : 0);
+            info.hasInjectedWeathers = info.originalEntryCount != info.originalWeatherEntries.size();
+        }
+        return scan;
+    }
+}
@@ -0,0 +1,60 @@
+#include "WorkerPool.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <future>
+
+namespace SWF {
+    namespace {
+        struct PoolScope {
+            explicit PoolScope(std::size_t threads) { WorkerPool::GetSingleton().Start(threads); }
+            ~PoolScope() { WorkerPool::GetSingleton().Shutdown(); }
+        };
+
+        // Submit a batch of empty tasks and wait for the last one: the
+        // per-task cost of queueing, stealing and waking.
+        void BM_SubmitBatch(benchmark::State& state) {
+            PoolScope scope(static_cast<std::size_t>(state.range(0)));
+            auto& pool = WorkerPool::GetSingleton();
+            constexpr int kBatch = 512;
+
+            for (auto _ : state) {
+                std::atomic<int> remaining = kBatch;
+                std::promise<void> done;
+                for (int i = 0; i < kBatch; ++i) {
+                    while (!pool.Submit(TaskPriority::kNormal, "empty", [&]() {
+                        if (remaining.fetch_sub(1) == 1) done.set_value();
+                    })) {
+                        std::this_thread::yield();
+                    }
+                }
+                done.get_future().wait();
+            }
+            state.SetItemsProcessed(state.iterations() * kBatch);
+        }
+        BENCHMARK(BM_SubmitBatch)->Arg(1)->Arg(2)->Arg(4)->UseRealTime();
+
+        // ParallelFor over cheap items against the same loop run serially.
+        void BM_ParallelFor(benchmark::State& state) {
+            auto threads = static_cast<std::size_t>(state.range(0));
+            PoolScope scope(threads);
+            auto& pool = WorkerPool::GetSingleton();
+            constexpr std::size_t kItems = 20000;
+            std::vector<double> out(kItems);
+
+            for (auto _ : state) {
+                if (threads == 0) {
+                    for (std::size_t i = 0; i < kItems; ++i) out[i] = std::sqrt(static_cast<double>(i) * 1.5);
+                } else {
+                    pool.ParallelFor(TaskPriority::kNormal, "items", kItems, [&](std::size_t i) {
+                        out[i] = std::sqrt(static_cast<double>(i) * 1.5);
+                    });
+                }
+                benchmark::DoNotOptimize(out.data());
+            }
+            state.SetItemsProcessed(state.iterations() * kItems);
+        }
+        BENCHMARK(BM_ParallelFor)->Arg(0)->Arg(2)->Arg(4)->UseRealTime();
+    }
+}
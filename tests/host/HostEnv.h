@@ -0,0 +1,90 @@
+#pragma once
+
+// Included by src/pch.h when SWF_HOST_TEST is defined. Provides just enough
+// of CommonLibSSE-NG, SKSE and Win32 for the plugin's game-independent code
+// (worker pool, parsers, config I/O, indices) to build and run on a Linux
+// host. Game records are plain structs carrying a FormID and editor ID, so
+// benchmarks can build synthetic ones; nothing is ever looked up in a game.
+
+#include <spdlog/spdlog.h>
+#include <fmt/format.h>
+#include <fmt/xchar.h>
+
+#include "HostWin32.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#if __has_include(<format>)
+#include <format>
+#else
+// libstdc++ before 13 has no <format>; fmt has the same syntax.
+namespace std {
+    using fmt::format;
+    using fmt::format_to;
+    template <class... Args>
+    using format_string = fmt::format_string<Args...>;
+}
+#endif
+
+namespace SKSE::log {
+    using spdlog::critical;
+    using spdlog::debug;
+    using spdlog::error;
+    using spdlog::info;
+    using spdlog::trace;
+    using spdlog::warn;
+}
+
+namespace RE {
+    using FormID = std::uint32_t;
+
+    class TESFile {
+    public:
+        std::string_view GetFilename() const { return fileName; }
+
+        std::string fileName;
+    };
+
+    class TESForm {
+    public:
+        FormID      GetFormID() const { return formID; }
+        const char* GetFormEditorID() const { return editorID.c_str(); }
+        TESFile*    GetFile(std::int32_t = -1) const { return file; }
+
+        FormID      formID = 0;
+        std::string editorID;
+        TESFile*    file = nullptr;   // defining plugin, if the test sets one
+    };
+
+    class TESWeather : public TESForm {};
+    class TESRegion : public TESForm {};
+    class TESWorldSpace : public TESForm {};
+    class TESRegionDataWeather {};
+
+    class TESGlobal : public TESForm {
+    public:
+        float value = 0.0f;
+    };
+
+    // No plugins are loaded on the host.
+    class TESDataHandler {
+    public:
+        static TESDataHandler* GetSingleton() { return nullptr; }
+
+        template <class T>
+        T* LookupForm(FormID, std::string_view) { return nullptr; }
+    };
+
+    // No game time on the host: callers fall back to their defaults.
+    class Calendar {
+    public:
+        static Calendar* GetSingleton() { return nullptr; }
+        std::uint32_t GetMonth() const { return 0; }
+        float GetDay() const { return 1.0f; }
+    };
+}
+
+inline void SetThreadDescription(std::thread::native_handle_type, const wchar_t*) {}
@@ -0,0 +1,16 @@
+// Link stand-ins for plugin classes whose sources stay out of the host
+// build because they need a running game.
+
+#include "ConfigWatcher.h"
+#include "RegionScanner.h"
+
+namespace SWF {
+
+    // No watcher runs on the host, so there is nothing to suppress.
+    void ConfigWatcher::Stop() {}
+    void ConfigWatcher::NoteOwnWrite() {}
+
+    std::string RegionScanner::GetWeatherName(RE::TESWeather* weather) {
+        return weather ? weather->editorID : std::string();
+    }
+}
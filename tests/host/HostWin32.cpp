@@ -0,0 +1,114 @@
+#include "HostWin32.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <mutex>
+#include <unordered_map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    // File handles are descriptors; a mapping handle owns a dup of its
+    // file's descriptor so it outlives CloseHandle on the file, as on Windows.
+    struct Mapping {
+        int fd = -1;
+    };
+
+    std::mutex                                   viewsMutex;
+    std::unordered_map<const void*, std::size_t> views;   // view -> length, for munmap
+    std::unordered_map<HANDLE, Mapping*>         mappings;
+
+    HANDLE ToHandle(int fd) { return reinterpret_cast<HANDLE>(static_cast<std::intptr_t>(fd)); }
+    int    ToFd(HANDLE handle) { return static_cast<int>(reinterpret_cast<std::intptr_t>(handle)); }
+}
+
+HANDLE CreateFileW(LPCWSTR path, DWORD access, DWORD, void*, DWORD disposition, DWORD, HANDLE) {
+    int flags = (access & GENERIC_WRITE) ? O_WRONLY : O_RDONLY;
+    if (disposition == CREATE_ALWAYS) flags |= O_CREAT | O_TRUNC;
+    int fd = ::open(path, flags | O_CLOEXEC, 0644);
+    return fd < 0 ? INVALID_HANDLE_VALUE : ToHandle(fd);
+}
+
+BOOL GetFileSizeEx(HANDLE file, LARGE_INTEGER* size) {
+    struct stat st{};
+    if (::fstat(ToFd(file), &st) != 0) return 0;
+    size->QuadPart = st.st_size;
+    return 1;
+}
+
+HANDLE CreateFileMappingW(HANDLE file, void*, DWORD, DWORD, DWORD, LPCWSTR) {
+    int fd = ::dup(ToFd(file));
+    if (fd < 0) return nullptr;
+    auto* mapping = new Mapping{ fd };
+    std::lock_guard<std::mutex> lock(viewsMutex);
+    mappings.emplace(mapping, mapping);
+    return mapping;
+}
+
+void* MapViewOfFile(HANDLE mapping, DWORD, DWORD, DWORD, std::size_t) {
+    int fd = static_cast<Mapping*>(mapping)->fd;
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || st.st_size == 0) return nullptr;
+    void* view = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    if (view == MAP_FAILED) return nullptr;
+    std::lock_guard<std::mutex> lock(viewsMutex);
+    views.emplace(view, static_cast<std::size_t>(st.st_size));
+    return view;
+}
+
+BOOL UnmapViewOfFile(const void* view) {
+    std::lock_guard<std::mutex> lock(viewsMutex);
+    auto it = views.find(view);
+    if (it == views.end()) return 0;
+    ::munmap(const_cast<void*>(view), it->second);
+    views.erase(it);
+    return 1;
+}
+
+BOOL WriteFile(HANDLE file, const void* data, DWORD bytes, DWORD* written, void*) {
+    auto* p = static_cast<const char*>(data);
+    DWORD done = 0;
+    while (done < bytes) {
+        auto n = ::write(ToFd(file), p + done, bytes - done);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            break;
+        }
+        done += static_cast<DWORD>(n);
+    }
+    if (written) *written = done;
+    return done == bytes;
+}
+
+BOOL FlushFileBuffers(HANDLE file) {
+    return ::fsync(ToFd(file)) == 0;
+}
+
+BOOL CloseHandle(HANDLE handle) {
+    {
+        std::lock_guard<std::mutex> lock(viewsMutex);
+        auto it = mappings.find(handle);
+        if (it != mappings.end()) {
+            ::close(it->second->fd);
+            delete it->second;
+            mappings.erase(it);
+            return 1;
+        }
+    }
+    return ::close(ToFd(handle)) == 0;
+}
+
+BOOL MoveFileExW(LPCWSTR from, LPCWSTR to, DWORD) {
+    return std::rename(from, to) == 0;
+}
+
+BOOL DeleteFileW(LPCWSTR path) {
+    return ::unlink(path) == 0;
+}
+
+DWORD GetLastError() {
+    return static_cast<DWORD>(errno);
+}
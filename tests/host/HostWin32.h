@@ -0,0 +1,52 @@
+#pragma once
+
+// The Win32 file calls the plugin makes, backed by POSIX on the host.
+// Narrow paths stand in for wide ones (std::filesystem::path::c_str() is
+// char on Linux); only the flags the plugin passes are honoured.
+
+#include <cstdint>
+#include <filesystem>
+
+using HANDLE = void*;
+using DWORD  = std::uint32_t;
+using BOOL   = int;
+using LPCWSTR = const std::filesystem::path::value_type*;
+
+union LARGE_INTEGER {
+    std::int64_t QuadPart;
+};
+
+#define INVALID_HANDLE_VALUE (reinterpret_cast<HANDLE>(static_cast<std::intptr_t>(-1)))
+#define MAX_PATH 260
+
+inline constexpr DWORD GENERIC_READ              = 0x80000000;
+inline constexpr DWORD GENERIC_WRITE             = 0x40000000;
+inline constexpr DWORD FILE_SHARE_READ           = 0x1;
+inline constexpr DWORD FILE_SHARE_WRITE          = 0x2;
+inline constexpr DWORD FILE_SHARE_DELETE         = 0x4;
+inline constexpr DWORD CREATE_ALWAYS             = 2;
+inline constexpr DWORD OPEN_EXISTING             = 3;
+inline constexpr DWORD FILE_ATTRIBUTE_NORMAL     = 0x80;
+inline constexpr DWORD FILE_FLAG_SEQUENTIAL_SCAN = 0x08000000;
+inline constexpr DWORD PAGE_READONLY             = 0x02;
+inline constexpr DWORD FILE_MAP_READ             = 0x04;
+inline constexpr DWORD MOVEFILE_REPLACE_EXISTING = 0x1;
+inline constexpr DWORD MOVEFILE_WRITE_THROUGH    = 0x8;
+
+HANDLE CreateFileW(LPCWSTR path, DWORD access, DWORD share, void* security, DWORD disposition,
+                   DWORD flags, HANDLE templateFile);
+BOOL   GetFileSizeEx(HANDLE file, LARGE_INTEGER* size);
+HANDLE CreateFileMappingW(HANDLE file, void* security, DWORD protect, DWORD sizeHigh, DWORD sizeLow,
+                          LPCWSTR name);
+void*  MapViewOfFile(HANDLE mapping, DWORD access, DWORD offsetHigh, DWORD offsetLow, std::size_t bytes);
+BOOL   UnmapViewOfFile(const void* view);
+BOOL   WriteFile(HANDLE file, const void* data, DWORD bytes, DWORD* written, void* overlapped);
+BOOL   FlushFileBuffers(HANDLE file);
+BOOL   CloseHandle(HANDLE handle);
+BOOL   MoveFileExW(LPCWSTR from, LPCWSTR to, DWORD flags);
+BOOL   DeleteFileW(LPCWSTR path);
+DWORD  GetLastError();
+
+// No module on the host: callers fall back to their relative paths.
+inline HANDLE GetModuleHandleW(const wchar_t*) { return nullptr; }
+inline DWORD  GetModuleFileNameW(HANDLE, wchar_t*, DWORD) { return 0; }
@@ -0,0 +1,38 @@
+#pragma once
+
+// A fresh temporary directory made the working directory for one scope.
+// On the host the config path falls back to the relative
+// Data/SKSE/Plugins/SeasonalWeatherFramework.ini, so this keeps config I/O
+// in tests and benchmarks away from the source tree.
+
+#include <filesystem>
+#include <random>
+#include <string>
+
+namespace SWF {
+    class ScopedWorkDir {
+    public:
+        ScopedWorkDir() {
+            std::random_device random;
+            dir_ = std::filesystem::temp_directory_path() / ("swf-host-" + std::to_string(random()));
+            std::filesystem::create_directories(dir_);
+            previous_ = std::filesystem::current_path();
+            std::filesystem::current_path(dir_);
+        }
+
+        ~ScopedWorkDir() {
+            std::error_code ec;
+            std::filesystem::current_path(previous_, ec);
+            std::filesystem::remove_all(dir_, ec);
+        }
+
+        ScopedWorkDir(const ScopedWorkDir&) = delete;
+        ScopedWorkDir& operator=(const ScopedWorkDir&) = delete;
+
+        const std::filesystem::path& Path() const { return dir_; }
+
+    private:
+        std::filesystem::path dir_;
+        std::filesystem::path previous_;
+    };
+}
@@ -0,0 +1,145 @@
+#include "Config.h"
+#include "ScopedWorkDir.h"
+#include "WorkerPool.h"
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <future>
+
+namespace SWF {
+    namespace {
+        using namespace std::chrono_literals;
+
+        // ConfigManager and the pool are process-wide singletons; each test
+        // gets its own working directory (and so its own INI) and default
+        // settings.
+        class ConfigIoTest : public ::testing::Test {
+        protected:
+            void SetUp() override { Reset(); }
+
+            void TearDown() override {
+                config.WaitForPendingSave();
+                pool.Shutdown();
+                Reset();
+            }
+
+            void Reset() {
+                config.GetConfig() = Config{};
+                config.BumpVersion();
+            }
+
+            static void WriteText(const std::filesystem::path& path, std::string_view text) {
+                std::filesystem::create_directories(path.parent_path());
+                std::ofstream(path, std::ios::binary) << text;
+            }
+
+            // Defaults plus what a drop-in sets.
+            void WriteDropIn() {
+                WriteText(ConfigManager::GetDropInDirectory(config.GetConfigPath()) / "extra.ini",
+                    "[SeasonMonths]\niSpringStart = 5\n"
+                    "[Worldspaces]\nsEnabledWorldspaces = Falskaar\n"
+                    "[RegionOverrides]\n*Pale* = Winter.Snow=4.0\n");
+            }
+
+            ScopedWorkDir  dir;
+            ConfigManager& config = ConfigManager::GetSingleton();
+            WorkerPool&    pool   = WorkerPool::GetSingleton();
+        };
+
+        TEST_F(ConfigIoTest, LoadAsyncReadsBackAnEarlierSave) {
+            pool.Start(2);
+            config.GetConfig().springStart = 3;
+            config.Save();
+            config.GetConfig().springStart = 2;
+
+            std::promise<std::shared_ptr<const Config>> loaded;
+            config.LoadAsync([&](std::shared_ptr<const Config> result) { loaded.set_value(std::move(result)); });
+
+            auto future = loaded.get_future();
+            ASSERT_EQ(future.wait_for(5s), std::future_status::ready);
+            auto result = future.get();
+            ASSERT_TRUE(result);
+            EXPECT_EQ(result->springStart, 3u);
+
+            // The live config is the caller's to replace.
+            EXPECT_EQ(config.GetConfig().springStart, 2u);
+        }
+
+        // Keys the INI leaves out come from the live config as it was when
+        // the load was queued, edits not yet published included.
+        TEST_F(ConfigIoTest, LoadAsyncParsesOverTheConfigItWasQueuedWith) {
+            WriteText(config.GetConfigPath(), "[SeasonMonths]\niSpringStart = 5\n");
+            config.GetConfig().summerStart = 7;
+
+            std::shared_ptr<const Config> result;
+            config.LoadAsync([&](std::shared_ptr<const Config> loaded) { result = std::move(loaded); });
+            config.GetConfig().summerStart = 8;
+
+            ASSERT_TRUE(result);
+            EXPECT_EQ(result->springStart, 5u);
+            EXPECT_EQ(result->summerStart, 7u);
+            EXPECT_EQ(config.GetSnapshot()->summerStart, Config{}.summerStart);
+        }
+
+        TEST_F(ConfigIoTest, LoadAsyncRunsInlineWithoutThePool) {
+            config.Save();
+            bool called = false;
+            config.LoadAsync([&](std::shared_ptr<const Config> result) { called = result != nullptr; });
+            EXPECT_TRUE(called);
+        }
+
+        TEST_F(ConfigIoTest, FirstRunCreatesTheIniAndStillMergesDropIns) {
+            WriteDropIn();
+            config.Load();
+
+            EXPECT_TRUE(std::filesystem::exists(config.GetConfigPath()));
+            EXPECT_EQ(config.GetConfig().springStart, 5u);
+            ASSERT_EQ(config.GetConfig().regionOverrides.size(), 1u);
+            EXPECT_EQ(config.GetConfig().regionOverrides[0].source, "extra.ini");
+        }
+
+        TEST_F(ConfigIoTest, SaveWritesOnlyWhatTheMainIniOwns) {
+            WriteDropIn();
+            config.Load();
+            config.GetConfig().summerStart = 6;
+            config.GetConfig().enabledWorldspaces.erase("Tamriel");
+            config.Save();
+            config.WaitForPendingSave();
+
+            Config main;
+            ASSERT_TRUE(ConfigManager::ParseFile(config.GetConfigPath(), main));
+            EXPECT_EQ(main.springStart, 2u);   // from the drop-in, untouched
+            EXPECT_EQ(main.summerStart, 6u);   // edited
+            EXPECT_TRUE(main.regionOverrides.empty());
+            EXPECT_FALSE(main.enabledWorldspaces.contains("Falskaar"));
+            EXPECT_FALSE(main.enabledWorldspaces.contains("Tamriel"));
+            EXPECT_TRUE(main.enabledWorldspaces.contains("DLC2SolstheimWorld"));
+        }
+
+        TEST_F(ConfigIoTest, SaveLoadCyclesDoNotDuplicateDropInRules) {
+            WriteDropIn();
+            config.Load();
+            for (int i = 0; i < 3; ++i) {
+                config.Save();
+                config.WaitForPendingSave();
+                config.Load();
+            }
+            EXPECT_EQ(config.GetConfig().regionOverrides.size(), 1u);
+            EXPECT_EQ(config.GetConfig().springStart, 5u);
+        }
+
+        // Startup loads from a pool task. With a single worker, a Load that
+        // waited for the queued save would wait on a task queued behind itself.
+        TEST_F(ConfigIoTest, LoadFromAPoolTaskDoesNotWaitForQueuedSaves) {
+            pool.Start(1);
+            std::promise<void> done;
+            ASSERT_TRUE(pool.Submit(TaskPriority::kNormal, "load", [&]() {
+                config.Save();
+                config.Load();
+                done.set_value();
+            }));
+            EXPECT_EQ(done.get_future().wait_for(5s), std::future_status::ready);
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#include "IniParser.h"
+
+#include <gtest/gtest.h>
+
+namespace SWF {
+
+    TEST(IniParserTest, ParsesFloatsWithSignsAndComments) {
+        float value = -1.0f;
+        EXPECT_TRUE(ParseIniFloat("1.5", value));
+        EXPECT_FLOAT_EQ(value, 1.5f);
+        EXPECT_TRUE(ParseIniFloat("+2.25", value));
+        EXPECT_FLOAT_EQ(value, 2.25f);
+        EXPECT_TRUE(ParseIniFloat("-0.5", value));
+        EXPECT_FLOAT_EQ(value, -0.5f);
+        EXPECT_TRUE(ParseIniFloat("1.0 ; default", value));
+        EXPECT_FLOAT_EQ(value, 1.0f);
+        EXPECT_TRUE(ParseIniFloat("3.0\t# tuned", value));
+        EXPECT_FLOAT_EQ(value, 3.0f);
+    }
+
+    TEST(IniParserTest, RejectsMalformedFloatsAndKeepsTheOldValue) {
+        float value = 7.0f;
+        EXPECT_FALSE(ParseIniFloat("", value));
+        EXPECT_FALSE(ParseIniFloat("+", value));
+        EXPECT_FALSE(ParseIniFloat("+-1", value));
+        EXPECT_FALSE(ParseIniFloat("++1", value));
+        EXPECT_FALSE(ParseIniFloat("1.0abc", value));
+        EXPECT_FALSE(ParseIniFloat("; only a comment", value));
+        EXPECT_FLOAT_EQ(value, 7.0f);
+    }
+
+    TEST(IniParserTest, ParsesUnsignedAndBools) {
+        std::uint32_t number = 0;
+        EXPECT_TRUE(ParseIniUInt("+42 ; comment", number));
+        EXPECT_EQ(number, 42u);
+        EXPECT_FALSE(ParseIniUInt("-1", number));
+        EXPECT_EQ(number, 42u);
+
+        bool flag = false;
+        EXPECT_TRUE(ParseIniBool("yes # on", flag));
+        EXPECT_TRUE(flag);
+        EXPECT_TRUE(ParseIniBool("0", flag));
+        EXPECT_FALSE(flag);
+        EXPECT_FALSE(ParseIniBool("maybe", flag));
+    }
+
+    TEST(IniParserTest, TokenizesSectionsKeysAndStrayLines) {
+        constexpr std::string_view kText =
+            "\xEF\xBB\xBF# header comment\r\n"
+            "[General]\r\n"
+            "bEnabled = true\r\n"
+            "; comment\n"
+            "\n"
+            "[ Multipliers ]\n"
+            "fSpring = +1.5 ; inline\n"
+            "not a pair\n";
+
+        std::vector<IniEntry> entries;
+        std::vector<std::string_view> sections;
+        TokenizeIni(kText, [&](const IniEntry& entry) { entries.push_back(entry); },
+                    [&](std::string_view section, std::uint32_t) { sections.push_back(section); });
+
+        ASSERT_EQ(sections, (std::vector<std::string_view>{ "General", "Multipliers" }));
+        ASSERT_EQ(entries.size(), 3u);
+        EXPECT_EQ(entries[0].section, "General");
+        EXPECT_EQ(entries[0].key, "bEnabled");
+        EXPECT_EQ(entries[0].value, "true");
+        EXPECT_EQ(entries[0].line, 3u);
+        EXPECT_EQ(entries[1].key, "fSpring");
+        EXPECT_EQ(entries[1].value, "+1.5 ; inline");
+        EXPECT_TRUE(entries[2].key.empty());
+        EXPECT_EQ(entries[2].value, "not a pair");
+        EXPECT_EQ(entries[2].line, 8u);
+    }
+
+    TEST(IniParserTest, SplitsCommaSeparatedTokens) {
+        std::vector<std::string_view> tokens;
+        ForEachCSVToken(" Tamriel, ,DLC2SolstheimWorld ,", [&](std::string_view token) { tokens.push_back(token); });
+        EXPECT_EQ(tokens, (std::vector<std::string_view>{ "Tamriel", "DLC2SolstheimWorld" }));
+    }
+}
@@ -0,0 +1,70 @@
+#include "MpscQueue.h"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+namespace SWF {
+    namespace {
+        struct Item {
+            std::uint32_t producer = 0;
+            std::uint32_t sequence = 0;
+        };
+
+        TEST(MpscQueueTest, SpilledValuesKeepTheirOrderBehindTheRing) {
+            MpscQueue<std::uint32_t, 4> queue;
+            for (std::uint32_t i = 0; i < 6; ++i) queue.Push(i);   // 4 in the ring, 2 spilled
+
+            // Freeing ring cells does not let a later push overtake the spill.
+            std::uint32_t value = 0;
+            ASSERT_TRUE(queue.Pop(value));
+            EXPECT_EQ(value, 0u);
+            queue.Push(6);
+
+            std::vector<std::uint32_t> rest;
+            while (queue.Pop(value)) rest.push_back(value);
+            EXPECT_EQ(rest, (std::vector<std::uint32_t>{ 1, 2, 3, 4, 5, 6 }));
+
+            // Once the spill is drained, the ring is used again.
+            queue.Push(7);
+            ASSERT_TRUE(queue.Pop(value));
+            EXPECT_EQ(value, 7u);
+            EXPECT_FALSE(queue.Pop(value));
+        }
+
+        // A tiny ring keeps producers spilling and the consumer freeing
+        // cells under them; each producer's values must still arrive in the
+        // order it pushed them.
+        TEST(MpscQueueTest, EachProducersValuesArriveInPushOrder) {
+            constexpr std::uint32_t kProducers = 4;
+            constexpr std::uint32_t kPerProducer = 20000;
+            MpscQueue<Item, 8> queue;
+
+            std::vector<std::jthread> producers;
+            for (std::uint32_t p = 0; p < kProducers; ++p) {
+                producers.emplace_back([&queue, p]() {
+                    for (std::uint32_t i = 0; i < kPerProducer; ++i) queue.Push({ p, i });
+                });
+            }
+
+            std::vector<std::uint32_t> next(kProducers, 0);
+            std::uint64_t received = 0;
+            bool ordered = true;
+            while (received < std::uint64_t{ kProducers } * kPerProducer) {
+                Item item;
+                if (!queue.Pop(item)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                ordered &= item.sequence == next[item.producer];
+                next[item.producer] = item.sequence + 1;
+                ++received;
+            }
+
+            EXPECT_TRUE(ordered);
+            for (auto count : next) EXPECT_EQ(count, kPerProducer);
+            Item extra;
+            EXPECT_FALSE(queue.Pop(extra));
+        }
+    }
+}
@@ -0,0 +1,214 @@
+#include "WorkerPool.h"
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <stdexcept>
+
+namespace SWF {
+    namespace {
+        // The pool is a process-wide singleton; every test starts it fresh
+        // and stops it again.
+        class WorkerPoolTest : public ::testing::Test {
+        protected:
+            void TearDown() override { pool.Shutdown(); }
+
+            WorkerPool& pool = WorkerPool::GetSingleton();
+        };
+
+        // Blocks a single-thread pool until Release(), so tests can arrange
+        // what is queued behind it.
+        struct Gate {
+            std::promise<void> entered;
+            std::promise<void> release;
+            std::shared_future<void> released = release.get_future().share();
+
+            void Block(WorkerPool& pool) {
+                ASSERT_TRUE(pool.Submit(TaskPriority::kHigh, "gate", [this]() {
+                    entered.set_value();
+                    released.wait();
+                }));
+                entered.get_future().wait();
+            }
+            void Release() { release.set_value(); }
+        };
+    }
+
+    TEST_F(WorkerPoolTest, RejectsWorkWhenNotRunning) {
+        EXPECT_FALSE(pool.IsRunning());
+        EXPECT_FALSE(pool.Submit(TaskPriority::kNormal, "idle", []() {}));
+        EXPECT_EQ(pool.GetThreadCount(), 0u);
+    }
+
+    TEST_F(WorkerPoolTest, RunsSubmittedTasks) {
+        pool.Start(4);
+        ASSERT_TRUE(pool.IsRunning());
+        EXPECT_EQ(pool.GetThreadCount(), 4u);
+
+        constexpr int kTasks = 1000;
+        std::atomic<int> ran = 0;
+        int accepted = 0;
+        for (int i = 0; i < kTasks; ++i) {
+            accepted += pool.Submit(TaskPriority::kNormal, "count", [&]() { ran.fetch_add(1); });
+        }
+        pool.Shutdown();
+        EXPECT_EQ(accepted, kTasks);
+        EXPECT_EQ(ran.load(), kTasks);
+    }
+
+    TEST_F(WorkerPoolTest, ShutdownRunsQueuedWork) {
+        pool.Start(1);
+        Gate gate;
+        gate.Block(pool);
+
+        std::atomic<int> ran = 0;
+        for (int i = 0; i < 10; ++i) {
+            ASSERT_TRUE(pool.Submit(TaskPriority::kLow, "queued", [&]() { ran.fetch_add(1); }));
+        }
+        std::thread stopper([&]() { pool.Shutdown(); });
+        gate.Release();
+        stopper.join();
+        EXPECT_EQ(ran.load(), 10);
+    }
+
+    TEST_F(WorkerPoolTest, HigherLanesRunFirst) {
+        pool.Start(1);
+        Gate gate;
+        gate.Block(pool);
+
+        std::mutex mutex;
+        std::vector<TaskPriority> order;
+        auto record = [&](TaskPriority priority) {
+            return [&, priority]() {
+                std::lock_guard<std::mutex> lock(mutex);
+                order.push_back(priority);
+            };
+        };
+        ASSERT_TRUE(pool.Submit(TaskPriority::kLow, "low", record(TaskPriority::kLow)));
+        ASSERT_TRUE(pool.Submit(TaskPriority::kNormal, "normal", record(TaskPriority::kNormal)));
+        ASSERT_TRUE(pool.Submit(TaskPriority::kHigh, "high", record(TaskPriority::kHigh)));
+        gate.Release();
+        pool.Shutdown();
+
+        EXPECT_EQ(order, (std::vector<TaskPriority>{ TaskPriority::kHigh, TaskPriority::kNormal, TaskPriority::kLow }));
+    }
+
+    TEST_F(WorkerPoolTest, FullLaneRejects) {
+        pool.Start(1);
+        Gate gate;
+        gate.Block(pool);
+
+        for (std::size_t i = 0; i < WorkerPool::kMaxQueuedPerLane; ++i) {
+            ASSERT_TRUE(pool.Submit(TaskPriority::kLow, "fill", []() {}));
+        }
+        auto rejectedBefore = pool.GetLaneStats(TaskPriority::kLow).rejected;
+        EXPECT_FALSE(pool.Submit(TaskPriority::kLow, "overflow", []() {}));
+        EXPECT_EQ(pool.GetLaneStats(TaskPriority::kLow).rejected, rejectedBefore + 1);
+
+        // Other lanes are capped separately.
+        EXPECT_TRUE(pool.Submit(TaskPriority::kNormal, "other lane", []() {}));
+        gate.Release();
+        pool.Shutdown();
+    }
+
+    TEST_F(WorkerPoolTest, ParallelForVisitsEveryIndexOnce) {
+        pool.Start(4);
+        constexpr std::size_t kCount = 10000;
+        std::vector<std::atomic<int>> hits(kCount);
+        pool.ParallelFor(TaskPriority::kNormal, "visit", kCount, [&](std::size_t i) { hits[i].fetch_add(1); });
+        for (std::size_t i = 0; i < kCount; ++i) {
+            ASSERT_EQ(hits[i].load(), 1) << "index " << i;
+        }
+    }
+
+    TEST_F(WorkerPoolTest, ParallelForCompletesWithoutHelpers) {
+        // Not running: the caller does every index itself.
+        std::size_t sum = 0;
+        pool.ParallelFor(TaskPriority::kNormal, "inline", 100, [&](std::size_t i) { sum += i; });
+        EXPECT_EQ(sum, 4950u);
+    }
+
+    TEST_F(WorkerPoolTest, ParallelForFromInsideTasks) {
+        pool.Start(2);
+        std::atomic<std::size_t> total = 0;
+        std::vector<std::future<void>> outer;
+        for (int t = 0; t < 8; ++t) {
+            auto done = std::make_shared<std::promise<void>>();
+            outer.push_back(done->get_future());
+            ASSERT_TRUE(pool.Submit(TaskPriority::kNormal, "outer", [&, done]() {
+                pool.ParallelFor(TaskPriority::kNormal, "inner", 1000, [&](std::size_t) { total.fetch_add(1); });
+                done->set_value();
+            }));
+        }
+        for (auto& f : outer) f.wait();
+        EXPECT_EQ(total.load(), 8000u);
+    }
+
+    TEST_F(WorkerPoolTest, ParallelForSurvivesThrowingItems) {
+        pool.Start(4);
+        std::atomic<int> ran = 0;
+        pool.ParallelFor(TaskPriority::kNormal, "throws", 100, [&](std::size_t i) {
+            ran.fetch_add(1);
+            if (i % 10 == 0) throw std::runtime_error("item failed");
+        });
+        EXPECT_EQ(ran.load(), 100);
+    }
+
+    TEST_F(WorkerPoolTest, ParallelForSurvivesNonStandardThrows) {
+        pool.Start(4);
+        std::atomic<int> ran = 0;
+        pool.ParallelFor(TaskPriority::kNormal, "throws", 100, [&](std::size_t i) {
+            ran.fetch_add(1);
+            if (i % 10 == 0) throw 42;
+        });
+        EXPECT_EQ(ran.load(), 100);
+    }
+
+    TEST_F(WorkerPoolTest, TaskExceptionsAreContained) {
+        pool.Start(1);
+        std::atomic<bool> after = false;
+        ASSERT_TRUE(pool.Submit(TaskPriority::kNormal, "throws", []() { throw std::runtime_error("task failed"); }));
+        ASSERT_TRUE(pool.Submit(TaskPriority::kNormal, "throws int", []() { throw 42; }));
+        ASSERT_TRUE(pool.Submit(TaskPriority::kNormal, "after", [&]() { after = true; }));
+        pool.Shutdown();
+        EXPECT_TRUE(after.load());
+    }
+
+    TEST_F(WorkerPoolTest, SubmitRacingShutdownNeverLosesAcceptedWork) {
+        for (int round = 0; round < 20; ++round) {
+            pool.Start(4);
+            std::atomic<bool> go = false;
+            std::atomic<int> accepted = 0;
+            std::atomic<int> ran = 0;
+
+            std::vector<std::thread> producers;
+            for (int p = 0; p < 4; ++p) {
+                producers.emplace_back([&]() {
+                    while (!go.load()) std::this_thread::yield();
+                    for (int i = 0; i < 2000; ++i) {
+                        if (pool.Submit(TaskPriority::kNormal, "race", [&]() { ran.fetch_add(1); })) {
+                            accepted.fetch_add(1);
+                        }
+                    }
+                });
+            }
+            go = true;
+            std::this_thread::yield();
+            pool.Shutdown();
+            for (auto& t : producers) t.join();
+
+            EXPECT_FALSE(pool.IsRunning());
+            EXPECT_EQ(ran.load(), accepted.load()) << "round " << round;
+        }
+    }
+
+    TEST_F(WorkerPoolTest, RestartsAfterShutdown) {
+        pool.Start(2);
+        pool.Shutdown();
+        pool.Start(3);
+        EXPECT_EQ(pool.GetThreadCount(), 3u);
+        std::promise<void> done;
+        ASSERT_TRUE(pool.Submit(TaskPriority::kHigh, "after restart", [&]() { done.set_value(); }));
+        done.get_future().wait();
+    }
+}